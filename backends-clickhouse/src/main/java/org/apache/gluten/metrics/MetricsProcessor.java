@@ -39,6 +39,10 @@ public class MetricsProcessor {
   @JsonProperty("output_bytes")
   protected long outputBytes = 0;
 
+  /** Rows the partial aggregation turned into intermediate states without aggregating them. */
+  @JsonProperty("bypassed_rows")
+  protected long bypassedRows = 0;
+
   public String getName() {
     return name;
   }
@@ -102,4 +106,12 @@ public class MetricsProcessor {
   public void setOutputBytes(long outputBytes) {
     this.outputBytes = outputBytes;
   }
+
+  public long getBypassedRows() {
+    return bypassedRows;
+  }
+
+  public void setBypassedRows(long bypassedRows) {
+    this.bypassedRows = bypassedRows;
+  }
 }
@@ -63,6 +63,9 @@ public class MetricsStep {
   @JsonProperty("parquet_metadata_cache_misses")
   protected long parquetMetadataCacheMisses;
 
+  @JsonProperty("parquet_pruned_row_groups")
+  protected long parquetPrunedRowGroups;
+
   public String getName() {
     return name;
   }
@@ -175,6 +178,14 @@ public class MetricsStep {
     this.parquetMetadataCacheMisses = parquetMetadataCacheMisses;
   }
 
+  public long getParquetPrunedRowGroups() {
+    return parquetPrunedRowGroups;
+  }
+
+  public void setParquetPrunedRowGroups(long parquetPrunedRowGroups) {
+    this.parquetPrunedRowGroups = parquetPrunedRowGroups;
+  }
+
   public long getParquetReaderVersion() {
     return parquetReaderVersion;
   }
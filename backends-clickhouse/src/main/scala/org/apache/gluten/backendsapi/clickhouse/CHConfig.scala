@@ -65,6 +65,15 @@ object CHConfig extends ConfigRegistry {
       .booleanConf
       .createWithDefault(false)
 
+  val WINDOW_GROUP_LIMIT_HASH_TOPK_MAX_LIMIT =
+    buildConf(prefixOf("windowGroupLimit.hashTopK.maxLimit"))
+      .doc(
+        "Window group limits with a limit up to this value don't sort their input, the top rows" +
+          " of each partition are kept in a hash table instead. 0 disables it.")
+      .intConf
+      .checkValue(_ >= 0, "must be non-negative")
+      .createWithDefault(0)
+
   val COLUMNAR_CH_SHUFFLE_SPILL_THRESHOLD =
     buildConf("spark.gluten.sql.columnar.backend.ch.spillThreshold")
       .internal()
@@ -141,6 +150,8 @@ class CHConfig(conf: SQLConf) extends GlutenConfig(conf) {
     }
   }
 
+  def windowGroupLimitHashTopKMaxLimit: Int = getConf(WINDOW_GROUP_LIMIT_HASH_TOPK_MAX_LIMIT)
+
   def chColumnarMaxSortBufferSize: Long = getConf(COLUMNAR_CH_MAX_SORT_BUFFER_SIZE)
 
   def chColumnarForceMemorySortShuffle: Boolean =
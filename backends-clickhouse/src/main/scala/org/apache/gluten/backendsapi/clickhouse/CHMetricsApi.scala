@@ -175,6 +175,9 @@ class CHMetricsApi extends MetricsApi with Logging with LogLevelUtil {
       "parquetMetadataCacheMisses" -> SQLMetrics.createMetric(
         sparkContext,
         "Number of times parquet metadata has not been found in the cache"),
+      "parquetPrunedRowGroups" -> SQLMetrics.createMetric(
+        sparkContext,
+        "Number of parquet row groups pruned by the filter"),
       "isParquetReaderV3" -> SQLMetrics.createMetric(
         sparkContext,
         "Is it the CH Parquet Reader V3 (greater than 0)")
@@ -234,6 +237,8 @@ class CHMetricsApi extends MetricsApi with Logging with LogLevelUtil {
       "resizeOutputRows" -> SQLMetrics.createMetric(sparkContext, "number of resize output rows"),
       "aggregatingTime" ->
         SQLMetrics.createTimingMetric(sparkContext, "time of aggregating"),
+      "partialAggBypassedRows" ->
+        SQLMetrics.createMetric(sparkContext, "number of rows bypassing partial aggregation"),
       "totalTime" -> SQLMetrics.createTimingMetric(sparkContext, "time")
     )
 
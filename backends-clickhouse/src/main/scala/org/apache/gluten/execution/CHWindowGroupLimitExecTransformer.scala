@@ -17,6 +17,7 @@
 package org.apache.gluten.execution
 
 import org.apache.gluten.backendsapi.BackendsApiManager
+import org.apache.gluten.backendsapi.clickhouse.CHConfig
 import org.apache.gluten.exception.GlutenNotSupportException
 import org.apache.gluten.expression._
 import org.apache.gluten.expression.{ConverterUtils, ExpressionConverter}
@@ -66,8 +67,13 @@ case class CHWindowGroupLimitExecTransformer(
       }
   }
 
+  // Small limits keep the top rows of each partition in a hash table, the input doesn't need to be sorted.
+  lazy val useHashTopK: Boolean = limit <= CHConfig.get.windowGroupLimitHashTopKMaxLimit
+
   override def requiredChildOrdering: Seq[Seq[SortOrder]] = {
-    if (BackendsApiManager.getSettings.requiredChildOrderingForWindowGroupLimit()) {
+    if (useHashTopK) {
+      Seq(Nil)
+    } else if (BackendsApiManager.getSettings.requiredChildOrderingForWindowGroupLimit()) {
       Seq(partitionSpec.map(SortOrder(_, Ascending)) ++ orderSpec)
     } else {
       Seq(Nil)
@@ -127,6 +133,9 @@ case class CHWindowGroupLimitExecTransformer(
         .append("window_function=")
         .append(windowFunction)
         .append("\n")
+      if (useHashTopK) {
+        parametersStr.append("is_hash_topk=true\n")
+      }
       val message = StringValue.newBuilder().setValue(parametersStr.toString).build()
       val extensionNode = ExtensionBuilder.makeAdvancedExtension(
         BackendsApiManager.getTransformerApiInstance.packPBMessage(message),
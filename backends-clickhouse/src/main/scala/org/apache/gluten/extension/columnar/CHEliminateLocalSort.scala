@@ -29,6 +29,7 @@ import org.apache.spark.sql.execution.{ProjectExec, SortExec, SparkPlan, UnaryEx
  *   - Convert sort merge join to shuffled hash join
  *   - Offload SortAggregate to native hash aggregate
  *   - Offload WindowGroupLimit to native TopNRowNumber
+ *   - Offload WindowGroupLimit to native hash top-K, which takes unsorted input
  *   - Offload Window which has date type range frame
  */
 object CHEliminateLocalSort extends Rule[SparkPlan] {
@@ -36,6 +37,7 @@ object CHEliminateLocalSort extends Rule[SparkPlan] {
     case _: HashAggregateExecBaseTransformer => true
     case _: ShuffledHashJoinExecTransformerBase => true
     case _: WindowGroupLimitExecTransformer => true
+    case w: CHWindowGroupLimitExecTransformer => w.useHashTopK
     case s: SortExec if s.global == false => true
     case s: SortExecTransformer if s.global == false => true
     case _ => false
@@ -46,6 +46,7 @@ class FileSourceScanMetricsUpdater(@transient val metrics: Map[String, SQLMetric
   val missCacheMillisecond: SQLMetric = metrics("missCacheMillisecond")
   val parquetMetadataCacheHits: SQLMetric = metrics("parquetMetadataCacheHits")
   val parquetMetadataCacheMisses: SQLMetric = metrics("parquetMetadataCacheMisses")
+  val parquetPrunedRowGroups: SQLMetric = metrics("parquetPrunedRowGroups")
   val isParquetReaderV3: SQLMetric = metrics("isParquetReaderV3")
 
   override def updateInputMetrics(inputMetrics: InputMetricsWrapper): Unit = {
@@ -76,6 +77,7 @@ class FileSourceScanMetricsUpdater(@transient val metrics: Map[String, SQLMetric
             missCacheMillisecond += step.missCacheMillisecond
             parquetMetadataCacheHits += step.parquetMetadataCacheHits
             parquetMetadataCacheMisses += step.parquetMetadataCacheMisses
+            parquetPrunedRowGroups += step.parquetPrunedRowGroups
             isParquetReaderV3 += step.parquetReaderVersion
           })
 
@@ -60,6 +60,12 @@ class HashAggregateMetricsUpdater(val metrics: Map[String, SQLMetric])
             metrics("resizeOutputRows") += aggMetricsData.getOutputRows
           }
 
+          metrics("partialAggBypassedRows") += aggMetricsData.steps.asScala
+            .flatMap(_.processors.asScala)
+            .filter(_.getName.equalsIgnoreCase("StreamingAggregatingTransform"))
+            .map(_.getBypassedRows)
+            .sum
+
           currentIdx -= 1
           metrics("totalTime") += (totalTime / 1000L).toLong
         }
@@ -3146,6 +3146,49 @@ class GlutenClickHouseTPCHSaltNullParquetSuite
 
   }
 
+  testWithMinSparkVersion("window group limit with hash top-K sorts only for the window", "3.5") {
+    withSQLConf(
+      (CHConfig.WINDOW_GROUP_LIMIT_HASH_TOPK_MAX_LIMIT.key, "10"),
+      (CHConfig.runtimeSettings("enable_window_group_limit_to_aggregate"), "false")
+    ) {
+      def checkSorts(df: DataFrame): Unit = {
+        val plan = df.queryExecution.executedPlan
+        val groupLimits = collectWithSubqueries(plan) {
+          case wgl: CHWindowGroupLimitExecTransformer => wgl
+        }
+        assert(groupLimits.nonEmpty)
+        assert(groupLimits.forall(_.useHashTopK))
+        // The group limit doesn't need sorted input, only the window above it does.
+        val sorts = collectWithSubqueries(plan) { case s: SortExecTransformer => s }
+        assert(sorts.size == 1)
+        assert(
+          collect(sorts.head.child) { case wgl: CHWindowGroupLimitExecTransformer => wgl }.nonEmpty)
+        groupLimits.foreach {
+          wgl => assert(collect(wgl.child) { case s: SortExecTransformer => s }.isEmpty)
+        }
+      }
+      spark.sql("drop table if exists test_win_hash_topk")
+      spark.sql("create table test_win_hash_topk (a string, b int, c int) using parquet")
+      spark.sql("""
+                  |insert into test_win_hash_topk values
+                  |('a', 3, 3), ('a', 1, 5), ('a', 2, 2), ('a', null, null), ('a', null, 1),
+                  |('b', 1, 1), ('b', 2, 1),
+                  |('c', 2, 3)
+                  |""".stripMargin)
+      compareResultsAgainstVanillaSpark(
+        """
+          |select * from(
+          |select a, b, c, row_number() over (partition by a order by b desc, c) as r
+          |from test_win_hash_topk)
+          |where r <= 2
+          |""".stripMargin,
+        compareResult = true,
+        checkSorts
+      )
+      spark.sql("drop table if exists test_win_hash_topk")
+    }
+  }
+
   test("GLUTEN-7759: Fix bug of agg pre-project push down") {
     val table_create_sql =
       "create table test_tbl_7759(id bigint, name string, day string) using parquet"
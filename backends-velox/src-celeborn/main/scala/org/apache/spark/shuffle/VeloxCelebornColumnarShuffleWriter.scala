@@ -28,6 +28,7 @@ import org.apache.spark.internal.config.{SHUFFLE_DISK_WRITE_BUFFER_SIZE, SHUFFLE
 import org.apache.spark.memory.SparkMemoryUtil
 import org.apache.spark.scheduler.MapStatus
 import org.apache.spark.shuffle.celeborn.CelebornShuffleHandle
+import org.apache.spark.shuffle.utils.NativeRangeBounds
 import org.apache.spark.sql.vectorized.ColumnarBatch
 import org.apache.spark.util.SparkResourceUtil
 
@@ -142,6 +143,7 @@ class VeloxCelebornColumnarShuffleWriter[K, V](
       celebornPartitionPusher
     )
 
+    val rangeBounds = NativeRangeBounds.create(dep.rangeBounds)
     nativeShuffleWriter = dep.shuffleWriterType match {
       case HashShuffleWriterType =>
         shuffleWriterJniWrapper.createHashShuffleWriter(
@@ -152,7 +154,10 @@ class VeloxCelebornColumnarShuffleWriter[K, V](
           GlutenConfig.get.columnarShuffleReallocThreshold,
           GlutenConfig.get.columnarShufflePartitionBufferEvictThreshold,
           partitionWriterHandle,
-          false
+          false,
+          rangeBounds.handle(),
+          rangeBounds.ascending,
+          rangeBounds.nullsFirst
         )
       case SortShuffleWriterType =>
         shuffleWriterJniWrapper.createSortShuffleWriter(
@@ -162,7 +167,10 @@ class VeloxCelebornColumnarShuffleWriter[K, V](
           conf.get(SHUFFLE_DISK_WRITE_BUFFER_SIZE).toInt,
           conf.get(SHUFFLE_SORT_INIT_BUFFER_SIZE).toInt,
           conf.get(SHUFFLE_SORT_USE_RADIXSORT),
-          partitionWriterHandle
+          partitionWriterHandle,
+          rangeBounds.handle(),
+          rangeBounds.ascending,
+          rangeBounds.nullsFirst
         )
       case RssSortShuffleWriterType =>
         shuffleWriterJniWrapper.createRssSortShuffleWriter(
@@ -172,12 +180,16 @@ class VeloxCelebornColumnarShuffleWriter[K, V](
           nativeBufferSize,
           clientPushSortMemoryThreshold,
           compressionCodec.orNull,
-          partitionWriterHandle
+          partitionWriterHandle,
+          rangeBounds.handle(),
+          rangeBounds.ascending,
+          rangeBounds.nullsFirst
         )
       case other =>
         throw new UnsupportedOperationException(
           s"Unsupported celeborn shuffle writer type: ${other.name}")
     }
+    rangeBounds.close()
 
     runtime
       .memoryManager()
@@ -39,6 +39,7 @@ import org.apache.spark.shuffle.GlutenShuffleUtils;
 import org.apache.spark.shuffle.RssShuffleHandle;
 import org.apache.spark.shuffle.RssShuffleManager;
 import org.apache.spark.shuffle.RssSparkConfig;
+import org.apache.spark.shuffle.utils.NativeRangeBounds;
 import org.apache.spark.sql.vectorized.ColumnarBatch;
 import org.apache.spark.util.SparkResourceUtil;
 import org.apache.uniffle.client.api.ShuffleWriteClient;
@@ -165,6 +166,7 @@ public class VeloxUniffleColumnarShuffleWriter<K, V> extends RssShuffleWriter<K,
                   bufferSize,
                   partitionPusher);
 
+          NativeRangeBounds rangeBounds = NativeRangeBounds.create(columnarDep.rangeBounds());
           if (isSort) {
             nativeShuffleWriter =
                 shuffleWriterJniWrapper.createSortShuffleWriter(
@@ -175,7 +177,10 @@ public class VeloxUniffleColumnarShuffleWriter<K, V> extends RssShuffleWriter<K,
                     diskWriteBufferSize,
                     (int) (long) sparkConf.get(package$.MODULE$.SHUFFLE_SORT_INIT_BUFFER_SIZE()),
                     (boolean) sparkConf.get(package$.MODULE$.SHUFFLE_SORT_USE_RADIXSORT()),
-                    partitionWriterHandle);
+                    partitionWriterHandle,
+                    rangeBounds.handle(),
+                    rangeBounds.ascending(),
+                    rangeBounds.nullsFirst());
           } else {
             nativeShuffleWriter =
                 shuffleWriterJniWrapper.createHashShuffleWriter(
@@ -187,8 +192,12 @@ public class VeloxUniffleColumnarShuffleWriter<K, V> extends RssShuffleWriter<K,
                     reallocThreshold,
                     GlutenConfig.get().columnarShufflePartitionBufferEvictThreshold(),
                     partitionWriterHandle,
-                    false);
+                    false,
+                    rangeBounds.handle(),
+                    rangeBounds.ascending(),
+                    rangeBounds.nullsFirst());
           }
+          rangeBounds.close();
 
           runtime
               .memoryManager()
@@ -435,7 +435,11 @@ class VeloxMetricsApi extends MetricsApi with Logging {
           "splitTime" -> SQLMetrics.createNanoTimingMetric(sparkContext, "time to split"),
           "avgDictionaryFields" -> SQLMetrics
             .createAverageMetric(sparkContext, "avg dictionary fields"),
-          "dictionarySize" -> SQLMetrics.createSizeMetric(sparkContext, "dictionary size")
+          "dictionarySize" -> SQLMetrics.createSizeMetric(sparkContext, "dictionary size"),
+          "partitionBufferReuseHits" -> SQLMetrics
+            .createMetric(sparkContext, "number of recycled partition buffers"),
+          "partitionBufferReuseMisses" -> SQLMetrics
+            .createMetric(sparkContext, "number of partition buffers missing the recycler")
         )
       case SortShuffleWriterType =>
         baseMetrics ++ Map(
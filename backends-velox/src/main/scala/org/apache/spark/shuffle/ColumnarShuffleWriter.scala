@@ -28,6 +28,7 @@ import org.apache.spark.internal.Logging
 import org.apache.spark.internal.config.{SHUFFLE_COMPRESS, SHUFFLE_DISK_WRITE_BUFFER_SIZE, SHUFFLE_FILE_BUFFER_SIZE, SHUFFLE_SORT_INIT_BUFFER_SIZE, SHUFFLE_SORT_USE_RADIXSORT}
 import org.apache.spark.memory.SparkMemoryUtil
 import org.apache.spark.scheduler.MapStatus
+import org.apache.spark.shuffle.utils.NativeRangeBounds
 import org.apache.spark.sql.vectorized.ColumnarBatch
 import org.apache.spark.util.{SparkDirectoryUtil, SparkResourceUtil, Utils}
 
@@ -162,6 +163,7 @@ class ColumnarShuffleWriter[K, V](
             GlutenConfig.get.columnarShuffleEnableTypeAwareCompress
           )
 
+          val rangeBounds = NativeRangeBounds.create(dep.rangeBounds)
           nativeShuffleWriter = if (isSort) {
             shuffleWriterJniWrapper.createSortShuffleWriter(
               numPartitions,
@@ -172,7 +174,10 @@ class ColumnarShuffleWriter[K, V](
               conf.get(SHUFFLE_DISK_WRITE_BUFFER_SIZE).toInt,
               conf.get(SHUFFLE_SORT_INIT_BUFFER_SIZE).toInt,
               conf.get(SHUFFLE_SORT_USE_RADIXSORT),
-              partitionWriterHandle
+              partitionWriterHandle,
+              rangeBounds.handle(),
+              rangeBounds.ascending,
+              rangeBounds.nullsFirst
             )
           } else {
             shuffleWriterJniWrapper.createHashShuffleWriter(
@@ -185,9 +190,13 @@ class ColumnarShuffleWriter[K, V](
               reallocThreshold,
               GlutenConfig.get.columnarShufflePartitionBufferEvictThreshold,
               partitionWriterHandle,
-              rowBasedChecksumEnabled
+              rowBasedChecksumEnabled,
+              rangeBounds.handle(),
+              rangeBounds.ascending,
+              rangeBounds.nullsFirst
             )
           }
+          rangeBounds.close()
 
           runtime
             .memoryManager()
@@ -242,6 +251,8 @@ class ColumnarShuffleWriter[K, V](
             splitResult.getTotalCompressTime)
       dep.metrics("avgDictionaryFields").set(splitResult.getAvgDictionaryFields)
       dep.metrics("dictionarySize").add(splitResult.getDictionarySize)
+      dep.metrics("partitionBufferReuseHits").add(splitResult.getPartitionBufferReuseHits)
+      dep.metrics("partitionBufferReuseMisses").add(splitResult.getPartitionBufferReuseMisses)
     } else {
       dep.metrics("sortTime").add(splitResult.getSortTime)
       dep.metrics("c2rTime").add(splitResult.getC2RTime)
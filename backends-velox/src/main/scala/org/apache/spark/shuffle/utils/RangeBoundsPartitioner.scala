@@ -0,0 +1,148 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package org.apache.spark.shuffle.utils
+
+import org.apache.gluten.backendsapi.BackendsApiManager
+import org.apache.gluten.columnarbatch.ColumnarBatches
+import org.apache.gluten.execution.RowToVeloxColumnarExec
+
+import org.apache.spark.{Partitioner, RangePartitioner}
+import org.apache.spark.rdd.{PartitionPruningRDD, RDD}
+import org.apache.spark.shuffle.RangePartitionBounds
+import org.apache.spark.sql.catalyst.expressions.UnsafeRow
+import org.apache.spark.sql.types._
+import org.apache.spark.sql.vectorized.ColumnarBatch
+
+import scala.collection.mutable
+import scala.collection.mutable.ArrayBuffer
+import scala.reflect.ClassTag
+import scala.util.hashing.byteswap32
+
+/**
+ * A range partitioner exposing its sampled bounds, so they can be handed to the native shuffle
+ * writer. In spark RangePartitioner, the rangeBounds is private, so the sampling is a
+ * copied-implementation, and getPartition returns the same partition ids.
+ */
+class RangeBoundsPartitioner[K: Ordering: ClassTag](
+    partitions: Int,
+    rdd: RDD[_ <: Product2[K, _]],
+    samplePointsPerPartitionHint: Int)
+  extends Partitioner {
+
+  private val ordering = implicitly[Ordering[K]]
+
+  val rangeBounds: Array[K] = {
+    if (partitions <= 1) {
+      Array.empty
+    } else {
+      val sampleSize = math.min(samplePointsPerPartitionHint.toDouble * partitions, 1e6)
+      val sampleSizePerPartition = math.ceil(3.0 * sampleSize / rdd.partitions.length).toInt
+      val (numItems, sketched) = RangePartitioner.sketch(rdd.map(_._1), sampleSizePerPartition)
+      if (numItems == 0L) {
+        Array.empty
+      } else {
+        val fraction = math.min(sampleSize / math.max(numItems, 1L), 1.0)
+        val candidates = ArrayBuffer.empty[(K, Float)]
+        val imbalancedPartitions = mutable.Set.empty[Int]
+        sketched.foreach {
+          case (idx, n, sample) =>
+            if (fraction * n > sampleSizePerPartition) {
+              imbalancedPartitions += idx
+            } else {
+              val weight = (n.toDouble / sample.length).toFloat
+              for (key <- sample) {
+                candidates += ((key, weight))
+              }
+            }
+        }
+        if (imbalancedPartitions.nonEmpty) {
+          val imbalanced = new PartitionPruningRDD(rdd.map(_._1), imbalancedPartitions.contains)
+          val seed = byteswap32(-rdd.id - 1)
+          val reSampled = imbalanced.sample(withReplacement = false, fraction, seed).collect()
+          val weight = (1.0 / fraction).toFloat
+          candidates ++= reSampled.map(x => (x, weight))
+        }
+        RangePartitioner.determineBounds(candidates, math.min(partitions, candidates.size))
+      }
+    }
+  }
+
+  override def numPartitions: Int = rangeBounds.length + 1
+
+  // The bounds are strictly increasing, so the partition id is the number of bounds below the key.
+  override def getPartition(key: Any): Int = {
+    val k = key.asInstanceOf[K]
+    var low = 0
+    var high = rangeBounds.length
+    while (low < high) {
+      val mid = (low + high) >>> 1
+      if (ordering.lt(rangeBounds(mid), k)) {
+        low = mid + 1
+      } else {
+        high = mid
+      }
+    }
+    low
+  }
+}
+
+object RangeBoundsPartitioner {
+
+  /** Whether the native shuffle writer computes range partition ids for keys of this type. */
+  def isNativeKeyType(dataType: DataType): Boolean = dataType match {
+    case BooleanType | ByteType | ShortType | IntegerType | LongType | FloatType | DoubleType =>
+      true
+    case DateType | TimestampType => true
+    case d: DecimalType => d.precision <= Decimal.MAX_LONG_DIGITS
+    case _ => false
+  }
+}
+
+/**
+ * Range bounds converted to a Velox batch for the native shuffle writer. The batch is only needed
+ * while the writer is created, which keeps its own reference.
+ */
+class NativeRangeBounds private (
+    batches: Iterator[ColumnarBatch],
+    val ascending: Array[Boolean],
+    val nullsFirst: Array[Boolean])
+  extends AutoCloseable {
+
+  private val batch: ColumnarBatch = if (batches.hasNext) batches.next() else null
+
+  /** Handle of the bounds batch, or -1 without range bounds. */
+  def handle(): Long = {
+    if (batch == null) -1L
+    else ColumnarBatches.getNativeHandle(BackendsApiManager.getBackendName, batch)
+  }
+
+  // Advancing the iterator closes the batch.
+  override def close(): Unit = batches.hasNext
+}
+
+object NativeRangeBounds {
+  def create(bounds: Option[RangePartitionBounds]): NativeRangeBounds = bounds match {
+    case Some(b) if b.bounds.nonEmpty =>
+      val bytes = b.bounds.map(_.asInstanceOf[UnsafeRow].getSizeInBytes.toLong).sum
+      new NativeRangeBounds(
+        RowToVeloxColumnarExec
+          .toColumnarBatchIterator(b.bounds.iterator, b.keySchema, b.bounds.length, bytes),
+        b.ascending,
+        b.nullsFirst)
+    case _ => new NativeRangeBounds(Iterator.empty, null, null)
+  }
+}
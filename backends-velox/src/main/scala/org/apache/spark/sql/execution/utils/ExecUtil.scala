@@ -25,19 +25,20 @@ import org.apache.gluten.memory.arrow.alloc.ArrowBufferAllocators
 import org.apache.gluten.runtime.Runtimes
 import org.apache.gluten.vectorized.{ArrowWritableColumnVector, NativeColumnarToRowInfo, NativeColumnarToRowJniWrapper, NativePartitioning}
 
-import org.apache.spark.{Partitioner, RangePartitioner, ShuffleDependency}
+import org.apache.spark.{Partitioner, ShuffleDependency}
 import org.apache.spark.rdd.RDD
 import org.apache.spark.serializer.Serializer
-import org.apache.spark.shuffle.{ColumnarShuffleDependency, GlutenShuffleUtils}
+import org.apache.spark.shuffle.{ColumnarShuffleDependency, GlutenShuffleUtils, RangePartitionBounds}
+import org.apache.spark.shuffle.utils.RangeBoundsPartitioner
 import org.apache.spark.sql.catalyst.InternalRow
-import org.apache.spark.sql.catalyst.expressions.{Attribute, BoundReference, UnsafeProjection, UnsafeRow}
+import org.apache.spark.sql.catalyst.expressions.{Attribute, AttributeReference, BoundReference, NullsFirst, UnsafeProjection, UnsafeRow}
 import org.apache.spark.sql.catalyst.expressions.codegen.LazilyGeneratedOrdering
 import org.apache.spark.sql.catalyst.plans.physical._
 import org.apache.spark.sql.execution.SQLExecution
 import org.apache.spark.sql.execution.exchange.ShuffleExchangeExec
 import org.apache.spark.sql.execution.metric.{SQLMetric, SQLMetrics}
 import org.apache.spark.sql.internal.SQLConf
-import org.apache.spark.sql.types.{IntegerType, StructType}
+import org.apache.spark.sql.types.{IntegerType, StructField, StructType}
 import org.apache.spark.sql.vectorized.{ColumnarBatch, ColumnVector}
 import org.apache.spark.util.MutablePair
 
@@ -99,8 +100,7 @@ object ExecUtil {
       executionId,
       metrics("numPartitions") :: Nil)
     // scalastyle:on argcount
-    // only used for fallback range partitioning
-    val rangePartitioner: Option[Partitioner] = newPartitioning match {
+    val rangePartitioner: Option[RangeBoundsPartitioner[InternalRow]] = newPartitioning match {
       case RangePartitioning(sortingExpressions, numPartitions) =>
         // Extract only fields used for sorting to avoid collecting large fields that does not
         // affect sorting result when deciding partition bounds in RangePartitioner
@@ -123,15 +123,61 @@ object ExecUtil {
             ord.copy(child = BoundReference(i, ord.dataType, ord.nullable))
         }
         implicit val ordering = new LazilyGeneratedOrdering(orderingAttributes)
-        val part = new RangePartitioner(
+        val part = new RangeBoundsPartitioner(
           numPartitions,
           rddForSampling,
-          ascending = true,
-          samplePointsPerPartitionHint = SQLConf.get.rangeExchangeSampleSizePerPartition)
+          SQLConf.get.rangeExchangeSampleSizePerPartition)
         Some(part)
       case _ => None
     }
 
+    // Ordinals of the range partitioning keys in the output, when the native shuffle writer can
+    // compute the partition ids from these columns and the sampled bounds.
+    val nativeRangeKeyOrdinals: Option[Array[Int]] = newPartitioning match {
+      case RangePartitioning(sortingExpressions, _) if rangePartitioner.get.rangeBounds.nonEmpty =>
+        val ordinals = sortingExpressions.map(_.child).map {
+          case a: AttributeReference if RangeBoundsPartitioner.isNativeKeyType(a.dataType) =>
+            outputAttributes.indexWhere(_.exprId == a.exprId)
+          case _ => -1
+        }
+        if (ordinals.forall(_ >= 0)) Some(ordinals.toArray) else None
+      case _ => None
+    }
+
+    val rangeBounds: Option[RangePartitionBounds] = nativeRangeKeyOrdinals.map {
+      _ =>
+        val sortingExpressions = newPartitioning.asInstanceOf[RangePartitioning].ordering
+        RangePartitionBounds(
+          StructType(sortingExpressions.zipWithIndex.map {
+            case (order, i) => StructField(s"key_$i", order.dataType, order.nullable)
+          }),
+          rangePartitioner.get.rangeBounds,
+          sortingExpressions.map(_.isAscending).toArray,
+          sortingExpressions.map(_.nullOrdering == NullsFirst).toArray
+        )
+    }
+
+    // Prepends the range partitioning keys, from which the native shuffle writer computes the ids.
+    def addRangePartitionKeys(
+        cbIter: Iterator[ColumnarBatch],
+        keyOrdinals: Array[Int]): Iterator[(Int, ColumnarBatch)] = {
+      Iterators
+        .wrap(
+          cbIter
+            .filter(cb => cb.numRows != 0 && cb.numCols != 0)
+            .map {
+              cb =>
+                val keyBatch =
+                  ColumnarBatches.select(BackendsApiManager.getBackendName, cb, keyOrdinals)
+                val newBatch = VeloxColumnarBatches.compose(keyBatch, cb)
+                // Composed batch already hold keyBatch's shared ref, so close is safe.
+                ColumnarBatches.forceClose(keyBatch)
+                (0, newBatch)
+            })
+        .recyclePayload(p => ColumnarBatches.forceClose(p._2))
+        .create()
+    }
+
     // only used for fallback range partitioning
     def computeAndAddPartitionId(
         cbIter: Iterator[ColumnarBatch],
@@ -170,7 +216,8 @@ object ExecUtil {
         new NativePartitioning(GlutenShuffleUtils.RoundRobinPartitioningShortName, n)
       case HashPartitioning(exprs, n) =>
         new NativePartitioning(GlutenShuffleUtils.HashPartitioningShortName, n)
-      // range partitioning fall back to row-based partition id computation
+      // range partitioning computes the ids natively from the sampled bounds, or falls back to
+      // row-based partition id computation
       case RangePartitioning(orders, n) =>
         new NativePartitioning(GlutenShuffleUtils.RangePartitioningShortName, n)
       case other =>
@@ -188,6 +235,11 @@ object ExecUtil {
     val isOrderSensitive = isRoundRobin && !SQLConf.get.sortBeforeRepartition
 
     val rddWithDummyKey: RDD[Product2[Int, ColumnarBatch]] = newPartitioning match {
+      case RangePartitioning(_, _) if nativeRangeKeyOrdinals.isDefined =>
+        val keyOrdinals = nativeRangeKeyOrdinals.get
+        rdd.mapPartitionsWithIndexInternal(
+          (_, cbIter) => addRangePartitionKeys(cbIter, keyOrdinals),
+          isOrderSensitive = isOrderSensitive)
       case RangePartitioning(sortingExpressions, _) =>
         rdd.mapPartitionsWithIndexInternal(
           (_, cbIter) => {
@@ -215,7 +267,8 @@ object ExecUtil {
         shuffleWriterProcessor = ShuffleExchangeExec.createShuffleWriteProcessor(writeMetrics),
         nativePartitioning = nativePartitioning,
         metrics = metrics,
-        shuffleWriterType = shuffleWriterType
+        shuffleWriterType = shuffleWriterType,
+        rangeBounds = rangeBounds
       )
 
     dependency
@@ -53,8 +53,9 @@ createAggregateFunctionBloomFilter(const std::string & name, const DataTypes & a
     UInt64 filter_size = 100;
     UInt64 filter_hashes = 2;
     UInt64 seed = 0;
+    bool split_block = false;
 
-    if (parameters.size() == 3)
+    if (parameters.size() == 3 || parameters.size() == 4)
     {
         auto get_parameter = [&](size_t i)
         {
@@ -71,6 +72,8 @@ createAggregateFunctionBloomFilter(const std::string & name, const DataTypes & a
         filter_size = get_parameter(0);
         filter_hashes = get_parameter(1);
         seed = get_parameter(2);
+        if (parameters.size() == 4)
+            split_block = get_parameter(3) != 0;
     }
     else if (parameters.empty())
     {
@@ -80,17 +83,17 @@ createAggregateFunctionBloomFilter(const std::string & name, const DataTypes & a
     {
         throw Exception(
             ErrorCodes::NUMBER_OF_ARGUMENTS_DOESNT_MATCH,
-            "Incorrect number of parameters for aggregate function {}, should either be 3 or 0",
+            "Incorrect number of parameters for aggregate function {}, should either be 3, 4 or 0",
             name);
     }
 
 
     if (arg_type == TypeIndex::Int64)
         return AggregateFunctionPtr(new AggregateFunctionGroupBloomFilter<Int64, AggregateFunctionGroupBloomFilterData>(
-            argument_types, parameters, filter_size, filter_hashes, seed));
+            argument_types, parameters, filter_size, filter_hashes, seed, split_block));
     else
         return AggregateFunctionPtr(new AggregateFunctionGroupBloomFilter<UInt64, AggregateFunctionGroupBloomFilterData>(
-            argument_types, parameters, filter_size, filter_hashes, seed));
+            argument_types, parameters, filter_size, filter_hashes, seed, split_block));
 }
 
 void registerAggregateFunctionsBloomFilter(AggregateFunctionFactory & factory)
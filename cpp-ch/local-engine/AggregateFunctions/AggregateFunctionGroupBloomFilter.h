@@ -29,6 +29,7 @@
 
 #include <IO/ReadHelpers.h>
 #include <Interpreters/BloomFilter.h>
+#include <Common/SplitBlockBloomFilter.h>
 
 namespace DB::ErrorCodes
 {
@@ -41,10 +42,72 @@ namespace local_engine
 struct AggregateFunctionGroupBloomFilterData
 {
     bool initted = false;
+    bool split_block = false;
     // small default value because BloomFilter has no default ctor
     DB::BloomFilter bloom_filter = DB::BloomFilter(100, 2, 0);
+    SplitBlockBloomFilter split_block_filter;
     static const char * name() { return "groupBloomFilter"; }
 
+    /// A split block filter always sets one bit per word of a block, its number of hashes is written as 0 to tell it
+    /// apart from the classic filter, which needs at least one.
+    static constexpr UInt64 SPLIT_BLOCK_HASHES = 0;
+
+    void init(size_t filter_size, size_t filter_hashes, size_t seed, bool split_block_)
+    {
+        split_block = split_block_;
+        if (split_block)
+            split_block_filter = SplitBlockBloomFilter(filter_size, seed);
+        else
+            bloom_filter = DB::BloomFilter(DB::BloomFilterParameters(filter_size, filter_hashes, seed));
+        initted = true;
+    }
+
+    template <typename T>
+    void add(T x)
+    {
+        if (split_block)
+            split_block_filter.add(static_cast<UInt64>(x));
+        else
+            bloom_filter.add(reinterpret_cast<const char *>(&x), sizeof(T));
+    }
+
+    template <typename T>
+    bool find(T x) const
+    {
+        if (split_block)
+            return split_block_filter.find(static_cast<UInt64>(x));
+        return bloom_filter.find(reinterpret_cast<const char *>(&x), sizeof(T));
+    }
+
+    /// Both filters must be initialized.
+    void merge(const AggregateFunctionGroupBloomFilterData & other)
+    {
+        if (split_block != other.split_block)
+            throw DB::Exception(DB::ErrorCodes::BAD_ARGUMENTS, "Cannot merge a split block bloom filter with a classic one");
+
+        if (split_block)
+        {
+            if (split_block_filter.getSize() != other.split_block_filter.getSize())
+                throw DB::Exception(
+                    DB::ErrorCodes::BAD_ARGUMENTS,
+                    "Cannot merge split block bloom filters of {} and {} bytes",
+                    split_block_filter.getSize(),
+                    other.split_block_filter.getSize());
+            split_block_filter.merge(other.split_block_filter);
+            return;
+        }
+
+        const auto & filter_other = other.bloom_filter.getFilter();
+        auto & filter_self = bloom_filter.getFilter();
+        for (size_t i = 0; i < filter_other.size(); ++i)
+        {
+            if (filter_other[i])
+            {
+                filter_self[i] |= filter_other[i];
+            }
+        }
+    }
+
     void read(DB::ReadBuffer & in)
     {
         UInt64 filter_size, filter_hashes, seed = 0;
@@ -55,12 +118,16 @@ struct AggregateFunctionGroupBloomFilterData
         {
             initted = false;
         }
+        else if (filter_hashes == SPLIT_BLOCK_HASHES)
+        {
+            init(filter_size, filter_hashes, seed, true);
+            in.readStrict(split_block_filter.data(), split_block_filter.getSize());
+        }
         else
         {
-            bloom_filter = DB::BloomFilter(DB::BloomFilterParameters(filter_size, filter_hashes, seed));
+            init(filter_size, filter_hashes, seed, false);
             auto & v = bloom_filter.getFilter();
             in.readStrict(reinterpret_cast<char *>(v.data()), v.size() * sizeof(v[0]));
-            initted = true;
         }
     }
 
@@ -68,6 +135,15 @@ struct AggregateFunctionGroupBloomFilterData
     {
         if likely (initted)
         {
+            if (split_block)
+            {
+                writeVarUInt(split_block_filter.getSize(), out);
+                writeVarUInt(SPLIT_BLOCK_HASHES, out);
+                writeVarUInt(split_block_filter.getSeed(), out);
+                out.write(split_block_filter.data(), split_block_filter.getSize());
+                return;
+            }
+
             writeVarUInt(bloom_filter.getSize(), out);
             writeVarUInt(bloom_filter.getHashes(), out);
             writeVarUInt(bloom_filter.getSeed(), out);
@@ -87,16 +163,23 @@ struct AggregateFunctionGroupBloomFilterData
 // Aggreate Int64 values into a bloom filter.
 // For groupFunctionBloomFilter, we don't actually care about the final Int result(currently always return BF byte size).
 // We just need its intermediate state, ,i.e. groupFunctionFilterState.
+// With split_block, the keys are added to a SplitBlockBloomFilter instead of DB::BloomFilter.
 template <typename T, typename Data>
 class AggregateFunctionGroupBloomFilter final : public DB::IAggregateFunctionDataHelper<Data, AggregateFunctionGroupBloomFilter<T, Data>>
 {
 public:
     explicit AggregateFunctionGroupBloomFilter(
-        const DB::DataTypes & argument_types_, const DB::Array & parameters_, size_t filter_size_, size_t filter_hashes_, size_t seed_)
+        const DB::DataTypes & argument_types_,
+        const DB::Array & parameters_,
+        size_t filter_size_,
+        size_t filter_hashes_,
+        size_t seed_,
+        bool split_block_)
         : DB::IAggregateFunctionDataHelper<Data, AggregateFunctionGroupBloomFilter<T, Data>>(argument_types_, parameters_, createResultType())
         , filter_size(filter_size_)
         , filter_hashes(filter_hashes_)
         , seed(seed_)
+        , split_block(split_block_)
     {
     }
 
@@ -119,12 +202,11 @@ public:
         if unlikely (!this->data(place).initted)
         {
             checkFilterSize(filter_size);
-            this->data(place).bloom_filter = DB::BloomFilter(DB::BloomFilterParameters(filter_size, filter_hashes, seed));
-            this->data(place).initted = true;
+            this->data(place).init(filter_size, filter_hashes, seed, split_block);
         }
 
         T x = assert_cast<const DB::ColumnVector<T> &>(*columns[0]).getData()[row_num];
-        this->data(place).bloom_filter.add(reinterpret_cast<const char *>(&x), sizeof(T));
+        this->data(place).add(x);
     }
 
     void merge(DB::AggregateDataPtr __restrict place, DB::ConstAggregateDataPtr rhs, DB::Arena *) const override
@@ -134,23 +216,23 @@ public:
         {
             return;
         }
-        const auto & bloom_other = this->data(rhs).bloom_filter;
-        const auto & filter_other = bloom_other.getFilter();
+        const auto & data_other = this->data(rhs);
         if (!this->data(place).initted)
         {
-            // We use filter_other's size/hashes/seed to avoid passing these parameters around to construct AggregateFunctionGroupBloomFilter.
-            checkFilterSize(bloom_other.getSize());
-            this->data(place).bloom_filter = DB::BloomFilter(DB::BloomFilterParameters(bloom_other.getSize(), bloom_other.getHashes(), bloom_other.getSeed()));
-            this->data(place).initted = true;
-        }
-        auto & filter_self = this->data(place).bloom_filter.getFilter();
-        for (size_t i = 0; i < filter_other.size(); ++i)
-        {
-            if (filter_other[i])
+            // We use data_other's size/hashes/seed to avoid passing these parameters around to construct AggregateFunctionGroupBloomFilter.
+            if (data_other.split_block)
             {
-                filter_self[i] |= filter_other[i];
+                checkFilterSize(data_other.split_block_filter.getSize());
+                this->data(place).init(data_other.split_block_filter.getSize(), 0, data_other.split_block_filter.getSeed(), true);
+            }
+            else
+            {
+                const auto & bloom_other = data_other.bloom_filter;
+                checkFilterSize(bloom_other.getSize());
+                this->data(place).init(bloom_other.getSize(), bloom_other.getHashes(), bloom_other.getSeed(), false);
             }
         }
+        this->data(place).merge(data_other);
     }
 
     void serialize(DB::ConstAggregateDataPtr __restrict place, DB::WriteBuffer & buf, std::optional<size_t> /* version */) const override
@@ -172,6 +254,7 @@ private:
     size_t filter_size;
     size_t filter_hashes;
     size_t seed;
+    bool split_block;
 };
 
 }
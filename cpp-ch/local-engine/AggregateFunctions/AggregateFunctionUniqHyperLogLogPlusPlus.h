@@ -50,6 +50,10 @@ extern const int INCORRECT_DATA;
  * The accuracy is controlled by the relative standard deviation (relative_sd) parameter.
  *
  * The algorithm also includes bias correction and linear counting for improved accuracy.
+ *
+ * Groups that only saw a few values keep their registers sparse, as a sorted list of (index, rank) entries, and switch
+ * to the dense words once the list grows past max_sparse_entries. Both representations serialize to the dense words,
+ * so the state stays compatible with Spark's HyperLogLogPlusPlusHelper.
  */
 struct HyperLogLogPlusPlusData
 {
@@ -61,6 +65,7 @@ struct HyperLogLogPlusPlusData
         , m(1ULL << p)
         , num_words(m / REGISTERS_PER_WORD + 1)
         , alpha_mm(computeAlphaMM())
+        , max_sparse_entries(std::min<UInt64>(num_words, MAX_SPARSE_ENTRIES))
     {
         if (p < 4)
             throw Exception(
@@ -73,17 +78,36 @@ struct HyperLogLogPlusPlusData
                 ErrorCodes::PARAMETER_OUT_OF_BOUND,
                 "HLL++ requires at most 25 bits for addressing instead of {} to avoid allocating too much memory",
                 p);
-
-        registers = PaddedPODArray<UInt64>(num_words, 0); // Initialize registers with zeros
     }
 
+    bool isSparse() const { return registers.empty(); }
+
+    size_t allocatedBytes() const { return registers.allocated_bytes() + sparse.allocated_bytes(); }
+
     void serialize(WriteBuffer & buf) const
     {
         writeBinaryLittleEndian(relative_sd, buf);
 
-        writeBinaryLittleEndian(registers.size(), buf);
-        for (const auto & word : registers)
+        writeBinaryLittleEndian(static_cast<size_t>(num_words), buf);
+        if (!isSparse())
+        {
+            for (const auto & word : registers)
+                writeBinaryLittleEndian(word, buf);
+            return;
+        }
+
+        /// Entries are sorted by index, so the words are built one after another.
+        const auto * entry = sparse.begin();
+        for (size_t word_i = 0; word_i < num_words; ++word_i)
+        {
+            UInt64 word = 0;
+            for (; entry != sparse.end() && (*entry >> REGISTER_SIZE) / REGISTERS_PER_WORD == word_i; ++entry)
+            {
+                UInt64 shift = (*entry >> REGISTER_SIZE) % REGISTERS_PER_WORD * REGISTER_SIZE;
+                word |= static_cast<UInt64>(*entry & REGISTER_WORD_MASK) << shift;
+            }
             writeBinaryLittleEndian(word, buf);
+        }
     }
 
     void deserialize(ReadBuffer & buf)
@@ -96,12 +120,22 @@ struct HyperLogLogPlusPlusData
 
         size_t registers_size = 0;
         readBinaryLittleEndian(registers_size, buf);
-        if (registers_size != registers.size())
-            throw Exception(
-                ErrorCodes::INCORRECT_DATA, "The number of registers {} isn't the expected one {}", registers_size, registers.size());
+        if (registers_size != num_words)
+            throw Exception(ErrorCodes::INCORRECT_DATA, "The number of registers {} isn't the expected one {}", registers_size, num_words);
 
+        sparse.clear();
+        registers.resize(num_words);
+        size_t non_zero = 0;
         for (size_t i = 0; i < registers_size; ++i)
+        {
             readBinaryLittleEndian(registers[i], buf);
+            non_zero += countNonZeroRegisters(registers[i]);
+        }
+
+        /// States of small groups come back sparse, so that merging them does not blow up the memory of the final
+        /// aggregation.
+        if (non_zero <= max_sparse_entries)
+            toSparse();
     }
 
     void add(UInt64 value)
@@ -110,56 +144,59 @@ struct HyperLogLogPlusPlusData
         UInt64 idx = x >> idx_shift;
         UInt64 w = (x << p) | w_padding;
         UInt64 pw = __builtin_clzll(w) + 1;
-
-        UInt64 word_offset = idx / REGISTERS_PER_WORD;
-        UInt64 word = registers[word_offset];
-
-        UInt64 shift = (idx - word_offset * REGISTERS_PER_WORD) * REGISTER_SIZE;
-        UInt64 mask = REGISTER_WORD_MASK << shift;
-        UInt64 midx = (word & mask) >> shift;
-        if (pw > midx)
-        {
-            registers[word_offset] = (word & ~mask) | (pw << shift);
-        }
+        update(idx, pw);
     }
 
     void merge(const HyperLogLogPlusPlusData & other)
     {
-        size_t i = 0; // global register index
-        for (size_t word_i = 0; word_i < num_words; ++word_i)
+        if (other.isSparse())
         {
-            UInt64 word1 = registers[word_i];
-            UInt64 word2 = other.registers[word_i];
-            UInt64 mask = REGISTER_WORD_MASK;
-            UInt64 merged_word = 0;
-            for (size_t register_i = 0; i < m && register_i < REGISTERS_PER_WORD; ++register_i, ++i)
-            {
-                merged_word |= std::max((word1 & mask), (word2 & mask));
-                mask <<= REGISTER_SIZE;
-            }
-            registers[word_i] = merged_word;
+            for (auto entry : other.sparse)
+                update(entry >> REGISTER_SIZE, entry & REGISTER_WORD_MASK);
+            return;
         }
+
+        if (isSparse())
+        {
+            SparseRegisters entries;
+            entries.swap(sparse);
+            registers.assign(other.registers);
+            for (auto entry : entries)
+                updateDense(entry >> REGISTER_SIZE, entry & REGISTER_WORD_MASK);
+            return;
+        }
+
+        /// Registers past m are zero in both, so whole words can be merged. Branch-free, so the loop is vectorized.
+        UInt64 * __restrict words = registers.data();
+        const UInt64 * __restrict other_words = other.registers.data();
+        for (size_t word_i = 0; word_i < num_words; ++word_i)
+            words[word_i] = maxRegisters(words[word_i], other_words[word_i]);
     }
 
     UInt64 query() const
     {
-        Float64 z_inverse = 0.0;
-        UInt64 v = 0;
-
-        size_t i = 0; // global register index
-        for (size_t word_i = 0; word_i < num_words; ++word_i)
+        /// Histogram of the register values. Registers with the same value contribute the same 2^-value to z.
+        UInt64 counts[REGISTER_WORD_MASK + 1] = {};
+        if (isSparse())
         {
-            UInt64 word = registers[word_i];
-            for (size_t register_i = 0; i < m && register_i < REGISTERS_PER_WORD; ++register_i, ++i)
-            {
-                UInt64 midx = (word >> (register_i * REGISTER_SIZE)) & REGISTER_WORD_MASK;
-                z_inverse += 1.0 / (1ULL << midx);
-
-                if (midx == 0)
-                    ++v;
-            }
+            counts[0] = m - sparse.size();
+            for (auto entry : sparse)
+                ++counts[entry & REGISTER_WORD_MASK];
+        }
+        else
+        {
+            for (auto word : registers)
+                for (size_t register_i = 0; register_i < REGISTERS_PER_WORD; ++register_i)
+                    ++counts[(word >> (register_i * REGISTER_SIZE)) & REGISTER_WORD_MASK];
+            /// The unused registers of the last word are zero.
+            counts[0] -= num_words * REGISTERS_PER_WORD - m;
         }
 
+        Float64 z_inverse = 0.0;
+        for (size_t midx = 0; midx <= REGISTER_WORD_MASK; ++midx)
+            z_inverse += std::ldexp(static_cast<Float64>(counts[midx]), -static_cast<int>(midx));
+        const UInt64 v = counts[0];
+
         Float64 e = alpha_mm / z_inverse;
 
         Float64 e_bias_corrected = e;
@@ -181,6 +218,95 @@ struct HyperLogLogPlusPlusData
     }
 
 private:
+    void update(UInt64 idx, UInt64 pw)
+    {
+        if (!isSparse())
+        {
+            updateDense(idx, pw);
+            return;
+        }
+
+        const UInt32 entry = static_cast<UInt32>((idx << REGISTER_SIZE) | pw);
+        auto * it = std::lower_bound(sparse.begin(), sparse.end(), static_cast<UInt32>(idx << REGISTER_SIZE));
+        if (it != sparse.end() && (*it >> REGISTER_SIZE) == idx)
+        {
+            if (pw > (*it & REGISTER_WORD_MASK))
+                *it = entry;
+            return;
+        }
+
+        if (sparse.size() >= max_sparse_entries)
+        {
+            toDense();
+            updateDense(idx, pw);
+            return;
+        }
+
+        const size_t pos = it - sparse.begin();
+        sparse.push_back(entry);
+        std::rotate(sparse.begin() + pos, sparse.end() - 1, sparse.end());
+    }
+
+    void updateDense(UInt64 idx, UInt64 pw)
+    {
+        UInt64 word_offset = idx / REGISTERS_PER_WORD;
+        UInt64 word = registers[word_offset];
+
+        UInt64 shift = (idx - word_offset * REGISTERS_PER_WORD) * REGISTER_SIZE;
+        UInt64 mask = REGISTER_WORD_MASK << shift;
+        UInt64 midx = (word & mask) >> shift;
+        if (pw > midx)
+        {
+            registers[word_offset] = (word & ~mask) | (pw << shift);
+        }
+    }
+
+    void toDense()
+    {
+        registers.assign(num_words, 0);
+        for (auto entry : sparse)
+            updateDense(entry >> REGISTER_SIZE, entry & REGISTER_WORD_MASK);
+        sparse = SparseRegisters();
+    }
+
+    void toSparse()
+    {
+        sparse.clear();
+        for (size_t word_i = 0; word_i < num_words; ++word_i)
+        {
+            for (size_t register_i = 0; register_i < REGISTERS_PER_WORD; ++register_i)
+            {
+                UInt64 midx = (registers[word_i] >> (register_i * REGISTER_SIZE)) & REGISTER_WORD_MASK;
+                if (midx)
+                    sparse.push_back(static_cast<UInt32>(((word_i * REGISTERS_PER_WORD + register_i) << REGISTER_SIZE) | midx));
+            }
+        }
+        registers = PaddedPODArray<UInt64>();
+    }
+
+    /// Registers are split into the even and the odd ones, so that every register gets a 12-bit lane with a spare bit
+    /// above it. Setting that bit before subtracting tells per lane whether a >= b without borrowing across lanes.
+    static UInt64 maxLanes(UInt64 a, UInt64 b)
+    {
+        UInt64 ge = (((a | LANE_GUARDS) - b) & LANE_GUARDS) >> REGISTER_SIZE;
+        UInt64 select = ge * REGISTER_WORD_MASK;
+        return (a & select) | (b & ~select);
+    }
+
+    static UInt64 maxRegisters(UInt64 a, UInt64 b)
+    {
+        return maxLanes(a & EVEN_REGISTERS, b & EVEN_REGISTERS)
+            | (maxLanes((a >> REGISTER_SIZE) & EVEN_REGISTERS, (b >> REGISTER_SIZE) & EVEN_REGISTERS) << REGISTER_SIZE);
+    }
+
+    static size_t countNonZeroRegisters(UInt64 word)
+    {
+        size_t count = 0;
+        for (size_t register_i = 0; register_i < REGISTERS_PER_WORD; ++register_i)
+            count += ((word >> (register_i * REGISTER_SIZE)) & REGISTER_WORD_MASK) != 0;
+        return count;
+    }
+
     Float64 computeAlphaMM() const
     {
         // Compute alpha * m * m based on the value of m
@@ -260,6 +386,9 @@ private:
     /// 'alpha' corrects the raw cardinality estimate 'Z'. See the FlFuGaMe07 paper for its derivation.
     const Float64 alpha_mm;
 
+    /// Registers switch to dense past this many sparse entries, which then use half the memory of the dense words.
+    const UInt64 max_sparse_entries;
+
     /// The number of bits that is required per register.
     ///
     /// This number is determined by the maximum number of leading binary zeros a hashcode can
@@ -274,6 +403,15 @@ private:
 
     static constexpr UInt64 REGISTERS_PER_WORD = WORD_SIZE / REGISTER_SIZE;
 
+    /// Lowest bit of the lanes of the even registers, and the spare bit above each of them.
+    static constexpr UInt64 LANE_ONES = 0x0001001001001001ULL;
+    static constexpr UInt64 EVEN_REGISTERS = LANE_ONES * REGISTER_WORD_MASK;
+    static constexpr UInt64 LANE_GUARDS = LANE_ONES << REGISTER_SIZE;
+
+    /// Sparse entries are kept sorted, so inserting moves the entries after it. Past this size the dense words are
+    /// cheaper to update even when they would use more memory.
+    static constexpr UInt64 MAX_SPARSE_ENTRIES = 1024;
+
     /// Number of points used for interpolating the bias value.
     static constexpr UInt64 K = 6;
 
@@ -3001,7 +3139,15 @@ private:
           1238126.379, 1244673.795, 1251260.649, 1257697.86,  1264320.983, 1270736.319, 1277274.694, 1283804.95,  1290211.514,
           1296858.568, 1303455.691}}};
 
-    PaddedPODArray<UInt64> registers; // Declaration of registers
+    /// Dense registers, packed REGISTERS_PER_WORD per word. Empty while the registers are sparse.
+    PaddedPODArray<UInt64> registers;
+
+    /// Starts with room for 16 entries and doubles, the default 4096 initial bytes would make a group that saw a few
+    /// values several times larger than its dense words.
+    using SparseRegisters = PODArray<UInt32, 64>;
+
+    /// Non-zero registers as (index << REGISTER_SIZE | value), sorted by index. Only used while registers is empty.
+    SparseRegisters sparse;
 };
 
 class AggregateFunctionUniqHyperLogLogPlusPlus final
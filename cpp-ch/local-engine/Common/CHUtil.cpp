@@ -58,7 +58,10 @@
 #include <QueryPipeline/printPipeline.h>
 #include <Storages/Cache/CacheManager.h>
 #include <Storages/MergeTree/StorageMergeTreeFactory.h>
+#include <Storages/Parquet/ParquetMetaCache.h>
 #include <Storages/Output/WriteBufferBuilder.h>
+#include <Storages/SubstraitSource/Delta/Bitmap/DeletionBitmapCache.h>
+#include <Storages/SubstraitSource/Iceberg/EqualityDeleteFileReader.h>
 #include <Storages/SubstraitSource/ReadBufferBuilder.h>
 #include <arrow/util/compression.h>
 #include <boost/algorithm/string/case_conv.hpp>
@@ -69,6 +72,7 @@
 #include <Common/BlockTypeUtils.h>
 #include <Common/Config/ConfigProcessor.h>
 #include <Common/GlutenSignalHandler.h>
+#include <Common/LocalThreadPools.h>
 #include <Common/LoggerExtend.h>
 #include <Common/QueryContext.h>
 #include <Common/logger_useful.h>
@@ -974,7 +978,12 @@ void BackendInitializerUtil::initBackend(const SparkConfigs::ConfigMap & spark_c
     StorageMergeTreeFactory::init_cache_map();
 
     JobScheduler::initialize(QueryContext::globalContext());
+    LocalThreadPools::initialize(QueryContext::globalContext());
     CacheManager::initialize(QueryContext::globalMutableContext());
+    ParquetMetaCache::initialize(ParquetMetaCacheConfig::loadFromContext(QueryContext::globalContext()).parquet_meta_cache_max_bytes);
+    const auto delete_file_cache_config = DeleteFileCacheConfig::loadFromContext(QueryContext::globalContext());
+    iceberg::EqualityDeleteSetCache::initialize(delete_file_cache_config.equality_delete_cache_max_bytes);
+    DeletionBitmapCache::initialize(delete_file_cache_config.deletion_bitmap_cache_max_bytes);
 
     std::call_once(
         init_flag,
@@ -74,6 +74,12 @@ GraceMergingAggregateConfig GraceMergingAggregateConfig::loadFromContext(const D
     config.max_allowed_memory_usage_ratio_for_aggregate_merging
         = context->getConfigRef().getDouble(MAX_ALLOWED_MEMORY_USAGE_RATIO_FOR_AGGREGATE_MERGING, 0.9);
     config.enable_spill_test = context->getConfigRef().getBool(ENABLE_SPILL_TEST, false);
+    config.parallel_merging_threads = context->getConfigRef().getUInt64(PARALLEL_MERGING_THREADS, config.parallel_merging_threads);
+    config.parallel_merging_memory_budget
+        = context->getConfigRef().getUInt64(PARALLEL_MERGING_MEMORY_BUDGET, config.parallel_merging_memory_budget);
+    config.parallel_merging_ordered_output
+        = context->getConfigRef().getBool(PARALLEL_MERGING_ORDERED_OUTPUT, config.parallel_merging_ordered_output);
+    config.parallel_merging_pool_size = context->getConfigRef().getUInt64(PARALLEL_MERGING_POOL_SIZE, config.parallel_merging_pool_size);
     return config;
 }
 
@@ -87,6 +93,14 @@ StreamingAggregateConfig StreamingAggregateConfig::loadFromContext(const DB::Con
     config.high_cardinality_threshold_for_streaming_aggregating
         = context->getConfigRef().getDouble(HIGH_CARDINALITY_THRESHOLD_FOR_STREAMING_AGGREGATING, 0.8);
     config.enable_streaming_aggregating = context->getConfigRef().getBool(ENABLE_STREAMING_AGGREGATING, true);
+    config.enable_streaming_aggregating_bypass
+        = context->getConfigRef().getBool(ENABLE_STREAMING_AGGREGATING_BYPASS, config.enable_streaming_aggregating_bypass);
+    config.streaming_aggregating_bypass_window_rows
+        = context->getConfigRef().getUInt64(STREAMING_AGGREGATING_BYPASS_WINDOW_ROWS, config.streaming_aggregating_bypass_window_rows);
+    config.streaming_aggregating_bypass_min_reduction_ratio = context->getConfigRef().getDouble(
+        STREAMING_AGGREGATING_BYPASS_MIN_REDUCTION_RATIO, config.streaming_aggregating_bypass_min_reduction_ratio);
+    config.streaming_aggregating_bypass_rows
+        = context->getConfigRef().getUInt64(STREAMING_AGGREGATING_BYPASS_ROWS, config.streaming_aggregating_bypass_rows);
     return config;
 }
 
@@ -96,6 +110,13 @@ JoinConfig JoinConfig::loadFromContext(const DB::ContextPtr & context)
     config.prefer_multi_join_on_clauses = context->getConfigRef().getBool(PREFER_MULTI_JOIN_ON_CLAUSES, true);
     config.multi_join_on_clauses_build_side_rows_limit
         = context->getConfigRef().getUInt64(MULTI_JOIN_ON_CLAUSES_BUILD_SIDE_ROWS_LIMIT, 10000000);
+    config.broadcast_build_block_rows = context->getConfigRef().getUInt64(BROADCAST_BUILD_BLOCK_ROWS, config.broadcast_build_block_rows);
+    config.broadcast_build_decompress_threads
+        = context->getConfigRef().getUInt64(BROADCAST_BUILD_DECOMPRESS_THREADS, config.broadcast_build_decompress_threads);
+    config.broadcast_build_decompress_pool_size
+        = context->getConfigRef().getUInt64(BROADCAST_BUILD_DECOMPRESS_POOL_SIZE, config.broadcast_build_decompress_pool_size);
+    config.runtime_filter_split_block_bloom_filter
+        = context->getConfigRef().getBool(RUNTIME_FILTER_SPLIT_BLOCK_BLOOM_FILTER, config.runtime_filter_split_block_bloom_filter);
     return config;
 }
 
@@ -136,6 +157,53 @@ GlutenJobSchedulerConfig GlutenJobSchedulerConfig::loadFromContext(const DB::Con
     config.job_scheduler_max_threads = context->getConfigRef().getUInt64(JOB_SCHEDULER_MAX_THREADS, 10);
     return config;
 }
+
+ShuffleConfig ShuffleConfig::loadFromContext(const DB::ContextPtr & context)
+{
+    ShuffleConfig config;
+    config.shuffle_compress_threads = context->getConfigRef().getUInt64(SHUFFLE_COMPRESS_THREADS, 0);
+    config.shuffle_compress_pool_size = context->getConfigRef().getUInt64(SHUFFLE_COMPRESS_POOL_SIZE, config.shuffle_compress_pool_size);
+    return config;
+}
+
+ParquetMetaCacheConfig ParquetMetaCacheConfig::loadFromContext(const DB::ContextPtr & context)
+{
+    ParquetMetaCacheConfig config;
+    config.parquet_meta_cache_max_bytes
+        = context->getConfigRef().getUInt64(PARQUET_META_CACHE_MAX_BYTES, config.parquet_meta_cache_max_bytes);
+    return config;
+}
+
+ParquetDecodeConfig ParquetDecodeConfig::loadFromContext(const DB::ContextPtr & context)
+{
+    ParquetDecodeConfig config;
+    config.parquet_decode_threads = context->getConfigRef().getUInt64(PARQUET_DECODE_THREADS, config.parquet_decode_threads);
+    config.parquet_decode_pool_size = context->getConfigRef().getUInt64(PARQUET_DECODE_POOL_SIZE, config.parquet_decode_pool_size);
+    config.parquet_decode_memory_budget
+        = context->getConfigRef().getUInt64(PARQUET_DECODE_MEMORY_BUDGET, config.parquet_decode_memory_budget);
+    return config;
+}
+
+FileSourceConfig FileSourceConfig::loadFromContext(const DB::ContextPtr & context)
+{
+    FileSourceConfig config;
+    config.parallel_read_files = context->getConfigRef().getUInt64(PARALLEL_READ_FILES, config.parallel_read_files);
+    config.preserve_file_order = context->getConfigRef().getBool(PRESERVE_FILE_ORDER, config.preserve_file_order);
+    config.prefetch_pool_size = context->getConfigRef().getUInt64(PREFETCH_POOL_SIZE, config.prefetch_pool_size);
+    config.small_file_threshold = context->getConfigRef().getUInt64(SMALL_FILE_THRESHOLD, config.small_file_threshold);
+    return config;
+}
+
+DeleteFileCacheConfig DeleteFileCacheConfig::loadFromContext(const DB::ContextPtr & context)
+{
+    DeleteFileCacheConfig config;
+    config.equality_delete_cache_max_bytes
+        = context->getConfigRef().getUInt64(EQUALITY_DELETE_CACHE_MAX_BYTES, config.equality_delete_cache_max_bytes);
+    config.deletion_bitmap_cache_max_bytes
+        = context->getConfigRef().getUInt64(DELETION_BITMAP_CACHE_MAX_BYTES, config.deletion_bitmap_cache_max_bytes);
+    return config;
+}
+
 MergeTreeCacheConfig MergeTreeCacheConfig::loadFromContext(const DB::ContextPtr & context)
 {
     MergeTreeCacheConfig config;
@@ -149,6 +217,9 @@ WindowConfig WindowConfig::loadFromContext(const DB::ContextPtr & context)
     config.aggregate_topk_sample_rows = context->getConfigRef().getUInt64(WINDOW_AGGREGATE_TOPK_SAMPLE_ROWS, 5000);
     config.aggregate_topk_high_cardinality_threshold
         = context->getConfigRef().getDouble(WINDOW_AGGREGATE_TOPK_HIGH_CARDINALITY_THRESHOLD, 0.6);
+    config.hash_topk_max_bytes_in_memory
+        = context->getConfigRef().getUInt64(WINDOW_HASH_TOPK_MAX_BYTES_IN_MEMORY, config.hash_topk_max_bytes_in_memory);
+    config.hash_topk_spill_buckets = context->getConfigRef().getUInt64(WINDOW_HASH_TOPK_SPILL_BUCKETS, config.hash_topk_spill_buckets);
     return config;
 }
 
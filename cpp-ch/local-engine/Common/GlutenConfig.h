@@ -62,6 +62,14 @@ struct GraceMergingAggregateConfig
     inline static const String MAX_ALLOWED_MEMORY_USAGE_RATIO_FOR_AGGREGATE_MERGING
         = "max_allowed_memory_usage_ratio_for_aggregate_merging";
     inline static const String ENABLE_SPILL_TEST = "enable_grace_aggregate_spill_test";
+    /// Merge the spilled buckets on up to this many threads once the input is finished. 0 or 1 merges them one by one.
+    inline static const String PARALLEL_MERGING_THREADS = "grace_aggregate_merging_parallel_threads";
+    /// Limit of the spilled bytes of the buckets being merged in parallel and not yet output.
+    inline static const String PARALLEL_MERGING_MEMORY_BUDGET = "grace_aggregate_merging_parallel_memory_budget";
+    /// Output the buckets merged in parallel in bucket order. Otherwise the first merged bucket is output first.
+    inline static const String PARALLEL_MERGING_ORDERED_OUTPUT = "grace_aggregate_merging_parallel_ordered_output";
+    /// Size of the process-wide pool the buckets are merged on.
+    inline static const String PARALLEL_MERGING_POOL_SIZE = "grace_aggregate_merging_parallel_pool_size";
 
     size_t max_grace_aggregate_merging_buckets = 32;
     bool throw_on_overflow_grace_aggregate_merging_buckets = false;
@@ -69,6 +77,10 @@ struct GraceMergingAggregateConfig
     size_t max_pending_flush_blocks_per_grace_aggregate_merging_bucket = 1_MiB;
     double max_allowed_memory_usage_ratio_for_aggregate_merging = 0.9;
     bool enable_spill_test = false;
+    size_t parallel_merging_threads = 0;
+    size_t parallel_merging_memory_budget = 1_GiB;
+    bool parallel_merging_ordered_output = true;
+    size_t parallel_merging_pool_size = 16;
 
     static GraceMergingAggregateConfig loadFromContext(const DB::ContextPtr & context);
 };
@@ -80,11 +92,22 @@ struct StreamingAggregateConfig
     inline static const String HIGH_CARDINALITY_THRESHOLD_FOR_STREAMING_AGGREGATING
         = "high_cardinality_threshold_for_streaming_aggregating";
     inline static const String ENABLE_STREAMING_AGGREGATING = "enable_streaming_aggregating";
+    /// Partial aggregation is measured over windows of this many input rows. When a window reduces the rows by less than
+    /// the ratio, the following rows are turned into aggregate states one by one, without hashing, and aggregation is
+    /// tried again after the given number of rows.
+    inline static const String ENABLE_STREAMING_AGGREGATING_BYPASS = "enable_streaming_aggregating_bypass";
+    inline static const String STREAMING_AGGREGATING_BYPASS_WINDOW_ROWS = "streaming_aggregating_bypass_window_rows";
+    inline static const String STREAMING_AGGREGATING_BYPASS_MIN_REDUCTION_RATIO = "streaming_aggregating_bypass_min_reduction_ratio";
+    inline static const String STREAMING_AGGREGATING_BYPASS_ROWS = "streaming_aggregating_bypass_rows";
 
     size_t aggregated_keys_before_streaming_aggregating_evict = 1024;
     double max_memory_usage_ratio_for_streaming_aggregating = 0.9;
     double high_cardinality_threshold_for_streaming_aggregating = 0.8;
     bool enable_streaming_aggregating = true;
+    bool enable_streaming_aggregating_bypass = true;
+    size_t streaming_aggregating_bypass_window_rows = 100000;
+    double streaming_aggregating_bypass_min_reduction_ratio = 0.1;
+    size_t streaming_aggregating_bypass_rows = 1000000;
 
     static StreamingAggregateConfig loadFromContext(const DB::ContextPtr & context);
 };
@@ -98,8 +121,23 @@ struct JoinConfig
     /// table is larger then this limit, this transform will not work.
     inline static const String MULTI_JOIN_ON_CLAUSES_BUILD_SIDE_ROWS_LIMIT = "multi_join_on_clauses_build_side_row_limit";
 
+    /// The broadcast build side arrives in small blocks, they are squashed into blocks of this many rows before being
+    /// inserted into the hash table.
+    inline static const String BROADCAST_BUILD_BLOCK_ROWS = "broadcast_join_build_block_rows";
+    /// Decompress up to this many blocks of the broadcast build side at once while it is deserialized. 0 decompresses
+    /// inline.
+    inline static const String BROADCAST_BUILD_DECOMPRESS_THREADS = "broadcast_join_build_decompress_threads";
+    /// Size of the process-wide pool the broadcast build sides decompress on.
+    inline static const String BROADCAST_BUILD_DECOMPRESS_POOL_SIZE = "broadcast_join_build_decompress_pool_size";
+    /// Build runtime filters (bloom_filter_agg) as split block bloom filters, which probe one cache line per key.
+    inline static const String RUNTIME_FILTER_SPLIT_BLOCK_BLOOM_FILTER = "runtime_filter_split_block_bloom_filter";
+
     bool prefer_multi_join_on_clauses = true;
     size_t multi_join_on_clauses_build_side_rows_limit = 10000000;
+    size_t broadcast_build_block_rows = 1048576;
+    size_t broadcast_build_decompress_threads = 4;
+    size_t broadcast_build_decompress_pool_size = 16;
+    bool runtime_filter_split_block_bloom_filter = false;
 
     static JoinConfig loadFromContext(const DB::ContextPtr & context);
 };
@@ -150,6 +188,79 @@ struct GlutenJobSchedulerConfig
     static GlutenJobSchedulerConfig loadFromContext(const DB::ContextPtr & context);
 };
 
+struct ShuffleConfig
+{
+    /// Compress shuffle blocks with up to this many threads per writer. 0 compresses inline.
+    inline static const String SHUFFLE_COMPRESS_THREADS = "shuffle_compress_threads";
+    /// Size of the process-wide pool the writers compress on.
+    inline static const String SHUFFLE_COMPRESS_POOL_SIZE = "shuffle_compress_pool_size";
+
+    size_t shuffle_compress_threads = 0;
+    size_t shuffle_compress_pool_size = 16;
+
+    static ShuffleConfig loadFromContext(const DB::ContextPtr & context);
+};
+
+struct ParquetMetaCacheConfig
+{
+    /// Memory budget of the process-wide cache of Parquet footers and page indexes, 0 disables it.
+    inline static const String PARQUET_META_CACHE_MAX_BYTES = "parquet_meta_cache_max_bytes";
+
+    size_t parquet_meta_cache_max_bytes = 256_MiB;
+
+    static ParquetMetaCacheConfig loadFromContext(const DB::ContextPtr & context);
+};
+
+struct ParquetDecodeConfig
+{
+    /// Decode the columns of a batch with up to this many threads per file in the vectorized Parquet reader. 0 or 1
+    /// decodes them one by one on the reading thread.
+    inline static const String PARQUET_DECODE_THREADS = "parquet_decode_threads";
+    /// Size of the process-wide pool the readers decode on.
+    inline static const String PARQUET_DECODE_POOL_SIZE = "parquet_decode_pool_size";
+    /// Bound of the estimated bytes of the columns decoded at once.
+    inline static const String PARQUET_DECODE_MEMORY_BUDGET = "parquet_decode_memory_budget";
+
+    size_t parquet_decode_threads = 0;
+    size_t parquet_decode_pool_size = 16;
+    size_t parquet_decode_memory_budget = 128_MiB;
+
+    static ParquetDecodeConfig loadFromContext(const DB::ContextPtr & context);
+};
+
+struct FileSourceConfig
+{
+    /// Open up to this many files of a split ahead of the one being read. 0 or 1 opens them one by one.
+    inline static const String PARALLEL_READ_FILES = "file_source_parallel_read_files";
+    /// Return the files of a split in order. Otherwise the first file opened ahead is read first.
+    inline static const String PRESERVE_FILE_ORDER = "file_source_preserve_file_order";
+    /// Read remote Parquet and ORC files up to this size in one request into memory, instead of fetching the footer and
+    /// the column chunks one by one. It also fetches the columns that are not projected. 0 disables it.
+    inline static const String SMALL_FILE_THRESHOLD = "file_source_small_file_threshold";
+    /// Size of the process-wide pool the files are opened ahead on.
+    inline static const String PREFETCH_POOL_SIZE = "file_source_prefetch_pool_size";
+
+    size_t parallel_read_files = 0;
+    bool preserve_file_order = true;
+    size_t prefetch_pool_size = 16;
+    size_t small_file_threshold = 0;
+
+    static FileSourceConfig loadFromContext(const DB::ContextPtr & context);
+};
+
+struct DeleteFileCacheConfig
+{
+    /// Memory limit of the process-wide cache of Iceberg equality delete sets. 0 disables the cache.
+    inline static const String EQUALITY_DELETE_CACHE_MAX_BYTES = "iceberg_equality_delete_cache_max_bytes";
+    /// Memory limit of the process-wide cache of Delta deletion vectors and Iceberg positional deletes. 0 disables it.
+    inline static const String DELETION_BITMAP_CACHE_MAX_BYTES = "deletion_bitmap_cache_max_bytes";
+
+    size_t equality_delete_cache_max_bytes = 256_MiB;
+    size_t deletion_bitmap_cache_max_bytes = 256_MiB;
+
+    static DeleteFileCacheConfig loadFromContext(const DB::ContextPtr & context);
+};
+
 struct MergeTreeCacheConfig
 {
     inline static const String ENABLE_DATA_PREFETCH = "enable_data_prefetch";
@@ -164,8 +275,13 @@ struct WindowConfig
 public:
     inline static const String WINDOW_AGGREGATE_TOPK_SAMPLE_ROWS = "window.aggregate_topk_sample_rows";
     inline static const String WINDOW_AGGREGATE_TOPK_HIGH_CARDINALITY_THRESHOLD = "window.aggregate_topk_high_cardinality_threshold";
+    inline static const String WINDOW_HASH_TOPK_MAX_BYTES_IN_MEMORY = "window.hash_topk_max_bytes_in_memory";
+    inline static const String WINDOW_HASH_TOPK_SPILL_BUCKETS = "window.hash_topk_spill_buckets";
     size_t aggregate_topk_sample_rows = 50000;
     double aggregate_topk_high_cardinality_threshold = 0.4;
+    /// The hash top-K of window group limit spills the partitions by hash into buckets once its rows take more memory.
+    size_t hash_topk_max_bytes_in_memory = 512 * 1024 * 1024;
+    size_t hash_topk_spill_buckets = 16;
     static WindowConfig loadFromContext(const DB::ContextPtr & context);
 };
 
@@ -0,0 +1,89 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "LocalThreadPools.h"
+
+#include <Common/GlutenConfig.h>
+#include <Common/ThreadPool.h>
+
+namespace CurrentMetrics
+{
+extern const Metric LocalThread;
+extern const Metric LocalThreadActive;
+extern const Metric LocalThreadScheduled;
+}
+
+namespace local_engine
+{
+namespace
+{
+void resize(ThreadPool & pool, size_t max_threads)
+{
+    pool.setMaxThreads(max_threads);
+    pool.setMaxFreeThreads(max_threads);
+}
+}
+
+void LocalThreadPools::initialize(const DB::ContextPtr & context)
+{
+    resize(shuffleCompress(), ShuffleConfig::loadFromContext(context).shuffle_compress_pool_size);
+    resize(parquetDecode(), ParquetDecodeConfig::loadFromContext(context).parquet_decode_pool_size);
+    resize(fileSourcePrefetch(), FileSourceConfig::loadFromContext(context).prefetch_pool_size);
+    resize(graceAggregateMerge(), GraceMergingAggregateConfig::loadFromContext(context).parallel_merging_pool_size);
+    resize(broadcastDecompress(), JoinConfig::loadFromContext(context).broadcast_build_decompress_pool_size);
+}
+
+ThreadPool & LocalThreadPools::shuffleCompress()
+{
+    static const size_t max_threads = ShuffleConfig{}.shuffle_compress_pool_size;
+    static ThreadPool pool(
+        CurrentMetrics::LocalThread, CurrentMetrics::LocalThreadActive, CurrentMetrics::LocalThreadScheduled, max_threads, max_threads, 0);
+    return pool;
+}
+
+ThreadPool & LocalThreadPools::parquetDecode()
+{
+    static const size_t max_threads = ParquetDecodeConfig{}.parquet_decode_pool_size;
+    static ThreadPool pool(
+        CurrentMetrics::LocalThread, CurrentMetrics::LocalThreadActive, CurrentMetrics::LocalThreadScheduled, max_threads, max_threads, 0);
+    return pool;
+}
+
+ThreadPool & LocalThreadPools::fileSourcePrefetch()
+{
+    static const size_t max_threads = FileSourceConfig{}.prefetch_pool_size;
+    static ThreadPool pool(
+        CurrentMetrics::LocalThread, CurrentMetrics::LocalThreadActive, CurrentMetrics::LocalThreadScheduled, max_threads, max_threads, 0);
+    return pool;
+}
+
+ThreadPool & LocalThreadPools::graceAggregateMerge()
+{
+    static const size_t max_threads = GraceMergingAggregateConfig{}.parallel_merging_pool_size;
+    static ThreadPool pool(
+        CurrentMetrics::LocalThread, CurrentMetrics::LocalThreadActive, CurrentMetrics::LocalThreadScheduled, max_threads, max_threads, 0);
+    return pool;
+}
+
+ThreadPool & LocalThreadPools::broadcastDecompress()
+{
+    static const size_t max_threads = JoinConfig{}.broadcast_build_decompress_pool_size;
+    static ThreadPool pool(
+        CurrentMetrics::LocalThread, CurrentMetrics::LocalThreadActive, CurrentMetrics::LocalThreadScheduled, max_threads, max_threads, 0);
+    return pool;
+}
+
+}
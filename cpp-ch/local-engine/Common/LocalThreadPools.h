@@ -0,0 +1,50 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <Interpreters/Context_fwd.h>
+#include <Common/ThreadPool_fwd.h>
+
+namespace local_engine
+{
+
+/// Process-wide pools for work that a single operator or buffer spreads over several threads. Instances schedule on
+/// these pools instead of owning one, so the number of threads is bounded per executor and no threads are spawned per
+/// instance. The per-instance thread settings only cap how much work one instance keeps in flight.
+class LocalThreadPools
+{
+public:
+    /// Sizes the pools from the backend config.
+    static void initialize(const DB::ContextPtr & context);
+
+    /// Compresses shuffle blocks for pipelined CompressedWriteBuffer instances.
+    static ThreadPool & shuffleCompress();
+
+    /// Reads and decodes the columns of a batch for VectorizedParquetRecordReader instances.
+    static ThreadPool & parquetDecode();
+
+    /// Opens the next files of a split ahead for SubstraitFileSource instances.
+    static ThreadPool & fileSourcePrefetch();
+
+    /// Merges spilled buckets for GraceAggregatingTransform instances.
+    static ThreadPool & graceAggregateMerge();
+
+    /// Decompresses the blocks of broadcast build sides for PipelinedCompressedReadBuffer instances.
+    static ThreadPool & broadcastDecompress();
+};
+
+}
@@ -0,0 +1,130 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include <base/types.h>
+#include <Common/HashTable/Hash.h>
+
+namespace local_engine
+{
+
+/// Bloom filter that sets all bits of a key in one 256-bit block, as the Parquet split block bloom filter does.
+///
+/// A key hashes to one block and to one bit in each of the block's eight 32-bit words, so adding or probing touches a
+/// single cache line instead of one per hash function. The eight words are handled the same way with different salts,
+/// so the loops over them compile to one 256-bit (or two 128-bit) vector operation.
+class SplitBlockBloomFilter
+{
+public:
+    static constexpr size_t WORDS_PER_BLOCK = 8;
+
+    struct alignas(32) Block
+    {
+        UInt32 words[WORDS_PER_BLOCK];
+    };
+
+    SplitBlockBloomFilter() = default;
+
+    /// The size is rounded up to whole blocks.
+    SplitBlockBloomFilter(size_t size_bytes, UInt64 seed_)
+        : blocks(std::max<size_t>((size_bytes + sizeof(Block) - 1) / sizeof(Block), 1), Block{})
+        , seed(seed_)
+    {
+    }
+
+    size_t getSize() const { return blocks.size() * sizeof(Block); }
+    UInt64 getSeed() const { return seed; }
+
+    char * data() { return reinterpret_cast<char *>(blocks.data()); }
+    const char * data() const { return reinterpret_cast<const char *>(blocks.data()); }
+
+    void add(UInt64 key)
+    {
+        const UInt64 hash = hashKey(key);
+        UInt32 mask[WORDS_PER_BLOCK];
+        makeMask(static_cast<UInt32>(hash), mask);
+        auto & block = blocks[blockIndex(hash)];
+        for (size_t i = 0; i < WORDS_PER_BLOCK; ++i)
+            block.words[i] |= mask[i];
+    }
+
+    bool find(UInt64 key) const
+    {
+        const UInt64 hash = hashKey(key);
+        return findHash(blocks[blockIndex(hash)], static_cast<UInt32>(hash));
+    }
+
+    /// Hashes a batch of keys and prefetches their blocks before probing them, so the cache misses of a large filter
+    /// overlap.
+    void findBatch(const UInt64 * __restrict keys, size_t num_keys, UInt8 * __restrict result) const
+    {
+        static constexpr size_t BATCH_SIZE = 16;
+        UInt64 hashes[BATCH_SIZE];
+        for (size_t begin = 0; begin < num_keys; begin += BATCH_SIZE)
+        {
+            const size_t end = std::min(begin + BATCH_SIZE, num_keys);
+            for (size_t i = begin; i < end; ++i)
+            {
+                hashes[i - begin] = hashKey(keys[i]);
+                __builtin_prefetch(&blocks[blockIndex(hashes[i - begin])]);
+            }
+            for (size_t i = begin; i < end; ++i)
+                result[i] = findHash(blocks[blockIndex(hashes[i - begin])], static_cast<UInt32>(hashes[i - begin]));
+        }
+    }
+
+    /// Both filters must have the same size and seed.
+    void merge(const SplitBlockBloomFilter & other)
+    {
+        for (size_t block_i = 0; block_i < blocks.size(); ++block_i)
+            for (size_t i = 0; i < WORDS_PER_BLOCK; ++i)
+                blocks[block_i].words[i] |= other.blocks[block_i].words[i];
+    }
+
+private:
+    /// Odd constants from the Parquet specification, one per word.
+    static constexpr UInt32 SALT[WORDS_PER_BLOCK]
+        = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+    UInt64 hashKey(UInt64 key) const { return DB::intHash64(key ^ seed); }
+
+    /// Multiplies the upper half of the hash into the number of blocks, which maps it to a block without a division.
+    size_t blockIndex(UInt64 hash) const { return static_cast<size_t>(((hash >> 32) * blocks.size()) >> 32); }
+
+    static void makeMask(UInt32 key, UInt32 (&mask)[WORDS_PER_BLOCK])
+    {
+        for (size_t i = 0; i < WORDS_PER_BLOCK; ++i)
+            mask[i] = 1U << ((key * SALT[i]) >> 27);
+    }
+
+    static bool findHash(const Block & block, UInt32 key)
+    {
+        UInt32 mask[WORDS_PER_BLOCK];
+        makeMask(key, mask);
+        UInt32 missing = 0;
+        for (size_t i = 0; i < WORDS_PER_BLOCK; ++i)
+            missing |= mask[i] & ~block.words[i];
+        return missing == 0;
+    }
+
+    std::vector<Block> blocks;
+    UInt64 seed = 0;
+};
+
+}
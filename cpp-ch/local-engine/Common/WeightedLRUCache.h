@@ -0,0 +1,139 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <base/types.h>
+
+namespace local_engine
+{
+
+/// Thread-safe LRU cache bounded by the total weight of its values, usually an estimate of their memory.
+///
+/// Values are loaded outside of the lock, since loading usually means reading a file. Concurrent misses of the same key
+/// may therefore both load it, the first one inserted is kept. A max_weight of 0 disables the cache, every lookup loads
+/// and is not counted as a hit or a miss.
+template <typename Value>
+class WeightedLRUCache
+{
+public:
+    using Load = std::function<Value()>;
+    using Weigh = std::function<size_t(const Value &)>;
+
+    explicit WeightedLRUCache(Weigh weigh_) : weigh(std::move(weigh_)) { }
+
+    /// Drops all entries.
+    void setMaxWeight(size_t max_weight_)
+    {
+        std::lock_guard lock(mutex);
+        max_weight = max_weight_;
+        lru.clear();
+        entries.clear();
+        current_weight = 0;
+    }
+
+    Value getOrLoad(const String & key, const Load & load)
+    {
+        bool enabled = false;
+        {
+            std::lock_guard lock(mutex);
+            enabled = max_weight != 0;
+            if (enabled)
+            {
+                if (auto it = entries.find(key); it != entries.end())
+                {
+                    ++hit_count;
+                    lru.splice(lru.begin(), lru, it->second.lru_pos);
+                    return it->second.value;
+                }
+                ++miss_count;
+            }
+        }
+
+        /// Also when the cache is disabled, loads must not wait for each other.
+        Value value = load();
+        if (!enabled)
+            return value;
+        const size_t weight = weigh(value);
+
+        std::lock_guard lock(mutex);
+        if (auto it = entries.find(key); it != entries.end())
+            return it->second.value;
+        /// Values heavier than the whole cache would only evict everything else. The cache may also have been disabled
+        /// while loading.
+        if (weight > max_weight || max_weight == 0)
+            return value;
+
+        while (current_weight + weight > max_weight)
+        {
+            auto it = entries.find(lru.back());
+            current_weight -= it->second.weight;
+            entries.erase(it);
+            lru.pop_back();
+        }
+
+        lru.push_front(key);
+        current_weight += weight;
+        entries.emplace(key, Entry{.value = value, .weight = weight, .lru_pos = lru.begin()});
+        return value;
+    }
+
+    size_t maxWeight() const
+    {
+        std::lock_guard lock(mutex);
+        return max_weight;
+    }
+
+    size_t weight() const
+    {
+        std::lock_guard lock(mutex);
+        return current_weight;
+    }
+
+    size_t count() const
+    {
+        std::lock_guard lock(mutex);
+        return entries.size();
+    }
+
+    size_t hits() const { return hit_count; }
+    size_t misses() const { return miss_count; }
+
+private:
+    struct Entry
+    {
+        Value value;
+        size_t weight = 0;
+        std::list<String>::iterator lru_pos;
+    };
+
+    const Weigh weigh;
+    mutable std::mutex mutex;
+    size_t max_weight = 0;
+    size_t current_weight = 0;
+    /// Most recently used key at the front.
+    std::list<String> lru;
+    std::unordered_map<String, Entry> entries;
+    std::atomic<size_t> hit_count{0};
+    std::atomic<size_t> miss_count{0};
+};
+
+}
@@ -39,6 +39,7 @@
 #include <IO/ReadBufferFromMemory.h>
 #include <Interpreters/castColumn.h>
 #include <base/types.h>
+#include <base/unaligned.h>
 #include <Common/typeid_cast.h>
 
 
@@ -134,7 +135,7 @@ private:
                 = *reinterpret_cast<AggregateFunctionGroupBloomFilterData *>(bloom_filter_state);
         if (second_arg_const)
         {
-            vec_to[0] = bloom_filter_data_0.bloom_filter.find(typeid_cast<const DB::ColumnConst &>(*column_ptr).getDataAt(0).data(), sizeof(T));
+            vec_to[0] = bloom_filter_data_0.find(unalignedLoad<T>(typeid_cast<const DB::ColumnConst &>(*column_ptr).getDataAt(0).data()));
             // copy to all rows, better use constant column
             std::memcpy(&vec_to[1], &vec_to[0], (input_rows_count - 1) * sizeof(UInt8));
 
@@ -142,6 +143,13 @@ private:
         }
 
         container_of_int = &typeid_cast<const ColumnType &>(*column_ptr).getData();
+        if (bloom_filter_data_0.split_block)
+        {
+            bloom_filter_data_0.split_block_filter.findBatch(
+                reinterpret_cast<const UInt64 *>(container_of_int->data()), input_rows_count, vec_to.data());
+            return;
+        }
+
         for (size_t i = 0; i < input_rows_count; ++i)
         {
             const T v = (*container_of_int)[i];
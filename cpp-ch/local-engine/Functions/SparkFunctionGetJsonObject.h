@@ -15,12 +15,15 @@
  * limitations under the License.
  */
 #pragma once
+#include <atomic>
 #include <cerrno>
 #include <limits>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <Columns/ColumnNullable.h>
+#include <Columns/ColumnsNumber.h>
 #include <Columns/ColumnTuple.h>
 #include <DataTypes/DataTypeNullable.h>
 #include <DataTypes/DataTypeString.h>
@@ -648,9 +651,15 @@ private:
     mutable bool is_most_normal_json_text = true;
     mutable size_t total_parsed_rows = 0;
     mutable size_t total_normalized_rows = 0;
+    /// If too few rows repeat a document of the same block, stop looking them up. The function is shared by the
+    /// threads of a query, so the statistics are atomic.
+    mutable std::atomic<bool> is_memo_effective = true;
+    mutable std::atomic<size_t> total_memo_rows = 0;
+    mutable std::atomic<size_t> total_memo_hits = 0;
 
+    /// `normalized_json` is the caller's buffer for the normalized json text, reused across rows.
     template <typename JSONParser>
-    bool safeParseJson(std::string_view str, JSONParser & parser, JSONParser::Element & doc) const
+    bool safeParseJson(std::string_view str, JSONParser & parser, JSONParser::Element & doc, std::vector<char> & normalized_json) const
     {
         total_parsed_rows++;
         if (total_parsed_rows > 10000 && total_normalized_rows * 100 / total_parsed_rows > 90)
@@ -666,15 +675,14 @@ private:
         if (!is_doc_ok && str.size() > 0)
         {
             total_normalized_rows++;
-            std::vector<char> buf;
-            buf.resize(str.size(), 0);
-            char * buf_pos = buf.data();
+            /// Too large numbers are replaced by a longer "Infinity" string, so the result may outgrow the input.
+            normalized_json.resize(str.size() * 3);
+            char * buf_pos = normalized_json.data();
             const char * pos = JSONTextNormalizer::normalize(str.data(), str.data() + str.size(), buf_pos);
             if (pos)
             {
-                std::string n_str(buf.data(), buf_pos - buf.data());
                 // LOG_DEBUG(getLogger("GetJsonObject"), "xxx normalize {} to {}", str, n_str);
-                is_doc_ok = parser.parse(n_str, doc);
+                is_doc_ok = parser.parse(std::string_view(normalized_json.data(), buf_pos - normalized_json.data()), doc);
             }
         }
         return is_doc_ok;
@@ -762,10 +770,11 @@ private:
         using Element = typename JSONParser::Element;
         Element document;
         bool document_ok = false;
+        std::vector<char> normalized_json;
         if (col_json_const)
         {
             std::string_view json{reinterpret_cast<const char *>(chars.data()), offsets[0]};
-            document_ok = safeParseJson(json, parser, document);
+            document_ok = safeParseJson(json, parser, document, normalized_json);
         }
 
         size_t tuple_size = tuple_columns.size();
@@ -776,12 +785,32 @@ private:
             std::back_inserter(generator_json_paths),
             [](const auto & ast) { return std::make_shared<DB::GeneratorJSONPath<JSONParser>>(ast); });
 
-        for (const auto i : collections::range(0, arguments[0].column->size()))
+        /// Event payloads often repeat within a block. Each distinct document is parsed and extracted once, into the
+        /// rows of the distinct documents, which are gathered to all rows at the end.
+        const size_t rows = arguments[0].column->size();
+        const bool use_memo = !col_json_const && is_memo_effective.load(std::memory_order_relaxed);
+        std::unordered_map<std::string_view, UInt64> memo;
+        auto memo_indexes = DB::ColumnUInt64::create();
+        size_t memo_hits = 0;
+        if (use_memo)
+            memo_indexes->reserve(rows);
+
+        for (const auto i : collections::range(0, rows))
         {
             if (!col_json_const)
             {
                 std::string_view json{reinterpret_cast<const char *>(&chars[offsets[i - 1]]), offsets[i] - offsets[i - 1]};
-                document_ok = safeParseJson(json, parser, document);
+                if (use_memo)
+                {
+                    auto [it, inserted] = memo.try_emplace(json, memo.size());
+                    memo_indexes->getData().push_back(it->second);
+                    if (!inserted)
+                    {
+                        ++memo_hits;
+                        continue;
+                    }
+                }
+                document_ok = safeParseJson(json, parser, document, normalized_json);
             }
             if (document_ok)
             {
@@ -803,6 +832,23 @@ private:
             }
         }
 
+        if (use_memo)
+        {
+            const size_t memo_rows = total_memo_rows.fetch_add(rows, std::memory_order_relaxed) + rows;
+            const size_t hits = total_memo_hits.fetch_add(memo_hits, std::memory_order_relaxed) + memo_hits;
+            if (memo_rows > 10000 && hits * 100 / memo_rows < 10)
+                is_memo_effective.store(false, std::memory_order_relaxed);
+
+            if (memo_hits)
+            {
+                DB::Columns gathered_columns;
+                gathered_columns.reserve(tuple_size);
+                for (const auto & column : tuple_columns)
+                    gathered_columns.emplace_back(column->index(*memo_indexes, 0));
+                return DB::ColumnTuple::create(std::move(gathered_columns));
+            }
+        }
+
         return DB::ColumnTuple::create(std::move(tuple_columns));
     }
 };
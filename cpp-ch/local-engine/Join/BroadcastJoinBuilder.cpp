@@ -27,6 +27,7 @@
 #include <jni/jni_common.h>
 #include <Poco/StringTokenizer.h>
 #include <Common/CHUtil.h>
+#include <Common/GlutenConfig.h>
 #include <Common/JNIUtils.h>
 #include <Common/logger_useful.h>
 #include <DataTypes/DataTypesNumber.h>
@@ -127,9 +128,11 @@ static void collectBlocksForCountingRows(NativeReader & block_stream, Block & he
     header = BlockUtil::buildRowCountHeader();
 }
 
-static void collectBlocksForJoinRel(NativeReader & reader, Block & header, Blocks & result)
+void collectBlocksForJoinRel(NativeReader & reader, Block & header, Blocks & result, size_t squash_rows)
 {
     ProfileInfo profile;
+    Blocks pending_blocks;
+    size_t pending_rows = 0;
     Block block = reader.read();
     while (!block.empty())
     {
@@ -142,13 +145,26 @@ static void collectBlocksForJoinRel(NativeReader & reader, Block & header, Block
 
         DB::Block final_block(columns);
         profile.update(final_block);
-        result.emplace_back(std::move(final_block));
+        pending_rows += final_block.rows();
+        pending_blocks.emplace_back(std::move(final_block));
+
+        /// The hash join keeps every block and prepares each one on insertion, a few large blocks are much cheaper
+        /// to build from and to probe than the many small ones the build side was shuffled in.
+        if (pending_rows >= squash_rows)
+        {
+            result.emplace_back(BlockUtil::concatenateBlocksMemoryEfficiently(std::move(pending_blocks)));
+            pending_blocks.clear();
+            pending_rows = 0;
+        }
 
         block = reader.read();
     }
+    if (!pending_blocks.empty())
+        result.emplace_back(BlockUtil::concatenateBlocksMemoryEfficiently(std::move(pending_blocks)));
 }
 
 std::shared_ptr<StorageJoinFromReadBuffer> buildJoin(
+    const DB::ContextPtr & context,
     const std::string & key,
     DB::ReadBuffer & input,
     jlong row_count,
@@ -184,6 +200,7 @@ std::shared_ptr<StorageJoinFromReadBuffer> buildJoin(
     if (only_one_column)
         header = BlockUtil::buildRowCountBlock(0).getColumnsWithTypeAndName();
 
+    const auto join_config = JoinConfig::loadFromContext(context);
     Blocks data;
     auto collect_data = [&]()
     {
@@ -191,7 +208,7 @@ std::shared_ptr<StorageJoinFromReadBuffer> buildJoin(
         if (only_one_column)
             collectBlocksForCountingRows(block_stream, header, data);
         else
-            collectBlocksForJoinRel(block_stream, header, data);
+            collectBlocksForJoinRel(block_stream, header, data, std::max<size_t>(join_config.broadcast_build_block_rows, 1));
 
         // For not cross join, we need to add a constant join key column
         // to make it behavior like a normal join.
@@ -18,6 +18,8 @@
 #include <cstdint>
 #include <memory>
 #include <jni.h>
+#include <Core/Block.h>
+#include <Interpreters/Context_fwd.h>
 #include <substrait/algebra.pb.h>
 
 namespace DB
@@ -27,10 +29,16 @@ class ReadBuffer;
 
 namespace local_engine
 {
+class NativeReader;
 class StorageJoinFromReadBuffer;
 namespace BroadcastJoinBuilder
 {
+/// Reads the build side blocks, converts them to the types of `header` and squashes them into blocks of at least
+/// `squash_rows` rows, the last one excepted.
+void collectBlocksForJoinRel(NativeReader & reader, DB::Block & header, DB::Blocks & result, size_t squash_rows);
+
 std::shared_ptr<StorageJoinFromReadBuffer> buildJoin(
+    const DB::ContextPtr & context,
     const std::string & key,
     DB::ReadBuffer & input,
     jlong row_count,
@@ -143,6 +143,7 @@ AdvancedExpandTransform::AdvancedExpandTransform(
     , grouping_keys(grouping_keys_)
     , project_set_exprs(project_set_exprs_)
     , input_header(input_header_)
+    , columns_builder(input_header, project_set_exprs)
 {
     for (size_t i = 0; i < project_set_exprs.getExpandRows(); ++i)
     {
@@ -210,6 +211,7 @@ DB::IProcessor::Status AdvancedExpandTransform::prepare()
         if (!input.hasData())
             return Status::NeedData;
         input_chunk = input.pull(true);
+        columns_builder.setInput(input_chunk);
         has_input = true;
         expand_expr_iterator = 0;
         input_blocks += 1;
@@ -226,41 +228,7 @@ void AdvancedExpandTransform::work()
 
 void AdvancedExpandTransform::expandInputChunk()
 {
-    const auto & input_columns = input_chunk.getColumns();
-    const auto & types = project_set_exprs.getTypes();
-    const auto & kinds = project_set_exprs.getKinds()[expand_expr_iterator];
-    const auto & fields = project_set_exprs.getFields()[expand_expr_iterator];
-    size_t rows = input_chunk.getNumRows();
-
-    DB::Columns columns(types.size());
-    for (size_t col_i = 0; col_i < types.size(); ++col_i)
-    {
-        const auto & type = types[col_i];
-        const auto & kind = kinds[col_i];
-        const auto & field = fields[col_i];
-
-        if (kind == EXPAND_FIELD_KIND_SELECTION)
-        {
-            auto index = field.safeGet<Int32>();
-            const auto & input_column = input_columns[index];
-
-            DB::ColumnWithTypeAndName input_arg;
-            input_arg.column = input_column;
-            input_arg.type = input_header->getByPosition(index).type;
-            /// input_column maybe non-Nullable
-            columns[col_i] = DB::castColumn(input_arg, type);
-        }
-        else if (kind == EXPAND_FIELD_KIND_LITERAL)
-        {
-            /// Add const column with field value
-            auto column = type->createColumnConst(rows, field)->convertToFullColumnIfConst();
-            columns[col_i] = std::move(column);
-        }
-        else
-            throw DB::Exception(DB::ErrorCodes::LOGICAL_ERROR, "Unknown ExpandFieldKind {}", magic_enum::enum_name(kind));
-    }
-
-    output_chunk = DB::Chunk(std::move(columns), rows);
+    output_chunk = DB::Chunk(columns_builder.build(expand_expr_iterator), input_chunk.getNumRows());
     has_output = true;
 
     ++expand_expr_iterator;
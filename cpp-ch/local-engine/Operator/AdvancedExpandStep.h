@@ -19,6 +19,7 @@
 #include <Core/Block.h>
 #include <Core/Names.h>
 #include <Interpreters/AggregateDescription.h>
+#include <Operator/ExpandTransform.h>
 #include <Parser/ExpandField.h>
 #include <Processors/Chunk.h>
 #include <Processors/IProcessor.h>
@@ -75,6 +76,7 @@ private:
     size_t grouping_keys = 0;
     ExpandField project_set_exprs;
     DB::SharedHeader input_header;
+    ExpandColumnsBuilder columns_builder;
     bool has_input = false;
     bool has_output = false;
     size_t expand_expr_iterator = 0;
@@ -16,6 +16,7 @@
  */
 #include "ExpandTransform.h"
 
+#include <algorithm>
 #include <memory>
 #include <Columns/ColumnsNumber.h>
 #include <Columns/IColumn.h>
@@ -36,8 +37,76 @@ extern const int LOGICAL_ERROR;
 
 namespace local_engine
 {
+ExpandColumnsBuilder::ExpandColumnsBuilder(const DB::SharedHeader & input_header_, const ExpandField & project_set_exprs_)
+    : input_header(input_header_)
+    , project_set_exprs(project_set_exprs_)
+    , selected_indexes(project_set_exprs.getExpandCols(), -1)
+    , selected_columns(project_set_exprs.getExpandCols())
+    , literal_columns(project_set_exprs.getExpandCols())
+{
+}
+
+void ExpandColumnsBuilder::setInput(const DB::Chunk & input_chunk)
+{
+    input_columns = input_chunk.getColumns();
+    rows = input_chunk.getNumRows();
+    std::fill(selected_indexes.begin(), selected_indexes.end(), -1);
+    std::fill(selected_columns.begin(), selected_columns.end(), nullptr);
+    if (rows != literal_rows)
+    {
+        for (auto & columns : literal_columns)
+            columns.clear();
+        literal_rows = rows;
+    }
+}
+
+DB::Columns ExpandColumnsBuilder::build(size_t expand_row)
+{
+    const auto & types = project_set_exprs.getTypes();
+    const auto & kinds = project_set_exprs.getKinds()[expand_row];
+    const auto & fields = project_set_exprs.getFields()[expand_row];
+
+    DB::Columns columns(types.size());
+    for (size_t col_i = 0; col_i < types.size(); ++col_i)
+    {
+        const auto & type = types[col_i];
+        const auto & kind = kinds[col_i];
+        const auto & field = fields[col_i];
+
+        if (kind == EXPAND_FIELD_KIND_SELECTION)
+        {
+            auto index = field.safeGet<Int32>();
+            if (selected_indexes[col_i] != index)
+            {
+                DB::ColumnWithTypeAndName input_arg;
+                input_arg.column = input_columns[index];
+                input_arg.type = input_header->getByPosition(index).type;
+                /// input_column maybe non-Nullable
+                selected_columns[col_i] = DB::castColumn(input_arg, type);
+                selected_indexes[col_i] = index;
+            }
+            columns[col_i] = selected_columns[col_i];
+        }
+        else if (kind == EXPAND_FIELD_KIND_LITERAL)
+        {
+            auto & literals = literal_columns[col_i];
+            auto it = std::find_if(literals.begin(), literals.end(), [&](const auto & literal) { return literal.first == field; });
+            if (it == literals.end())
+            {
+                /// Add const column with field value
+                literals.emplace_back(field, type->createColumnConst(rows, field)->convertToFullColumnIfConst());
+                it = std::prev(literals.end());
+            }
+            columns[col_i] = it->second;
+        }
+        else
+            throw DB::Exception(DB::ErrorCodes::LOGICAL_ERROR, "Unknown ExpandFieldKind {}", magic_enum::enum_name(kind));
+    }
+    return columns;
+}
+
 ExpandTransform::ExpandTransform(const DB::SharedHeader & input_, const DB::SharedHeader & output_, const ExpandField & project_set_exprs_)
-    : DB::IProcessor({input_}, {output_}), project_set_exprs(project_set_exprs_)
+    : DB::IProcessor({input_}, {output_}), project_set_exprs(project_set_exprs_), columns_builder(input_, project_set_exprs)
 {
 }
 
@@ -79,6 +148,7 @@ ExpandTransform::Status ExpandTransform::prepare()
             return Status::NeedData;
 
         input_chunk = input.pull(true);
+        columns_builder.setInput(input_chunk);
         has_input = true;
         expand_expr_iterator = 0;
     }
@@ -91,42 +161,7 @@ void ExpandTransform::work()
     if (expand_expr_iterator >= project_set_exprs.getExpandRows())
         throw DB::Exception(DB::ErrorCodes::LOGICAL_ERROR, "expand_expr_iterator >= project_set_exprs.getExpandRows()");
 
-    const auto & input_header = getInputs().front().getHeader();
-    const auto & input_columns = input_chunk.getColumns();
-    const auto & types = project_set_exprs.getTypes();
-    const auto & kinds = project_set_exprs.getKinds()[expand_expr_iterator];
-    const auto & fields = project_set_exprs.getFields()[expand_expr_iterator];
-    size_t rows = input_chunk.getNumRows();
-
-    DB::Columns columns(types.size());
-    for (size_t col_i = 0; col_i < types.size(); ++col_i)
-    {
-        const auto & type = types[col_i];
-        const auto & kind = kinds[col_i];
-        const auto & field = fields[col_i];
-
-        if (kind == EXPAND_FIELD_KIND_SELECTION)
-        {
-            auto index = field.safeGet<Int32>();
-            const auto & input_column = input_columns[index];
-
-            DB::ColumnWithTypeAndName input_arg;
-            input_arg.column = input_column;
-            input_arg.type = input_header.getByPosition(index).type;
-            /// input_column maybe non-Nullable
-            columns[col_i] = DB::castColumn(input_arg, type);
-        }
-        else if (kind == EXPAND_FIELD_KIND_LITERAL)
-        {
-            /// Add const column with field value
-            auto column = type->createColumnConst(rows, field)->convertToFullColumnIfConst();
-            columns[col_i] = std::move(column);
-        }
-        else
-            throw DB::Exception(DB::ErrorCodes::LOGICAL_ERROR, "Unknown ExpandFieldKind {}", magic_enum::enum_name(kind));
-    }
-
-    output_chunk = DB::Chunk(std::move(columns), rows);
+    output_chunk = DB::Chunk(columns_builder.build(expand_expr_iterator), input_chunk.getNumRows());
     has_output = true;
 
     ++expand_expr_iterator;
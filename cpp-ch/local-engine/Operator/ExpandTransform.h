@@ -24,13 +24,46 @@
 
 namespace local_engine
 {
+/// Builds the output columns of the expand projections of one input chunk.
+///
+/// Projections share columns instead of copying them. A selected column is cast once per input chunk and reused by
+/// every projection selecting it, and a literal column is reused by all projections and chunks with the same number of
+/// rows. Only the columns of the first projection that needs them are materialized. Columns are immutable once in a
+/// chunk, a transform changing one downstream clones it first.
+class ExpandColumnsBuilder
+{
+public:
+    ExpandColumnsBuilder(const DB::SharedHeader & input_header_, const ExpandField & project_set_exprs_);
+
+    /// Drops the columns cast from the previous input chunk.
+    void setInput(const DB::Chunk & input_chunk);
+
+    DB::Columns build(size_t expand_row);
+
+private:
+    DB::SharedHeader input_header;
+    const ExpandField & project_set_exprs;
+
+    DB::Columns input_columns;
+    size_t rows = 0;
+
+    /// Per output column, the input column it was last cast from and the result.
+    std::vector<Int32> selected_indexes;
+    DB::Columns selected_columns;
+
+    /// Per output column, the literal columns of `literal_rows` rows built so far.
+    std::vector<std::vector<std::pair<DB::Field, DB::ColumnPtr>>> literal_columns;
+    size_t literal_rows = 0;
+};
+
 // For handling substrait expand node.
 // The implementation in spark for groupingsets/rollup/cube is different from Clickhouse.
 // We have two ways to support groupingsets/rollup/cube
 // - Rewrite the substrait plan in local engine and reuse the implementation of clickhouse. This
 //   may be more complex.
 // - Implement new transform to do the expandation. It's simpler, but may suffer some performance
-//   issues. We try this first.
+//   issues. We try this first. ExpandColumnsBuilder shares the columns between the projections, so
+//   an input chunk is not copied once per grouping set.
 class ExpandTransform : public DB::IProcessor
 {
 public:
@@ -44,6 +77,7 @@ public:
 
 private:
     ExpandField project_set_exprs;
+    ExpandColumnsBuilder columns_builder;
     bool has_input = false;
     bool has_output = false;
     size_t expand_expr_iterator = 0;
@@ -81,8 +81,8 @@ FillingDeltaInternalRowDeletedTransform::FillingDeltaInternalRowDeletedTransform
         {
             std::shared_ptr<DeltaVirtualMeta::DeltaDVBitmapConfig> bitmap_config =
                             DeltaVirtualMeta::DeltaDVBitmapConfig::parse_config(part.row_index_filter_id_encoded);
-            std::unique_ptr<DeltaDVRoaringBitmapArray> bitmap_array = std::make_unique<DeltaDVRoaringBitmapArray>();
-            bitmap_array->rb_read(bitmap_config->path_or_inline_dv, bitmap_config->offset, bitmap_config->size_in_bytes, context);
+            auto bitmap_array = DeletionBitmapCache::instance().getOrReadDeletionVector(
+                bitmap_config->path_or_inline_dv, bitmap_config->offset, bitmap_config->size_in_bytes, context);
             std::string part_path_key;
             part_path_key.append(merge_tree_table.absolute_path).append("/").append(part.name);
             dv_map.emplace(part_path_key, std::move(bitmap_array));
@@ -19,7 +19,7 @@
 #include <Processors/ISimpleTransform.h>
 #include <Processors/QueryPlan/ITransformingStep.h>
 #include <Storages/MergeTree/SparkMergeTreeMeta.h>
-#include <Storages/SubstraitSource/Delta/Bitmap/DeltaDVRoaringBitmapArray.h>
+#include <Storages/SubstraitSource/Delta/Bitmap/DeletionBitmapCache.h>
 
 namespace local_engine
 {
@@ -52,6 +52,6 @@ public:
 
 private:
     DB::Block read_header;
-    std::unordered_map<String, std::unique_ptr<DeltaDVRoaringBitmapArray>> dv_map;
+    std::unordered_map<String, DeletionBitmapPtr> dv_map;
 };
 }
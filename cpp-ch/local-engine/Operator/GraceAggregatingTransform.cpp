@@ -22,8 +22,10 @@
 #include <Common/CHUtil.h>
 #include <Common/CurrentThread.h>
 #include <Common/GlutenConfig.h>
+#include <Common/LocalThreadPools.h>
 #include <Common/QueryContext.h>
 #include <Common/formatReadable.h>
+#include <Common/setThreadName.h>
 
 namespace DB::ErrorCodes
 {
@@ -38,6 +40,18 @@ GraceAggregatingTransform::GraceAggregatingTransform(
     DB::ContextPtr context_,
     bool no_pre_aggregated_,
     bool final_output_)
+    : GraceAggregatingTransform(
+          header_, params_, context_, no_pre_aggregated_, final_output_, GraceMergingAggregateConfig::loadFromContext(context_))
+{
+}
+
+GraceAggregatingTransform::GraceAggregatingTransform(
+    const DB::SharedHeader & header_,
+    DB::AggregatingTransformParamsPtr params_,
+    DB::ContextPtr context_,
+    bool no_pre_aggregated_,
+    bool final_output_,
+    const GraceMergingAggregateConfig & config)
     : IProcessor({header_}, {params_->getHeader()})
     , header(header_)
     , params(params_)
@@ -49,13 +63,15 @@ GraceAggregatingTransform::GraceAggregatingTransform(
     , tmp_data_disk(context_->getTempDataOnDisk())
 {
     output_header = params->getHeader();
-    auto config = GraceMergingAggregateConfig::loadFromContext(context);
     max_buckets = config.max_grace_aggregate_merging_buckets;
     throw_on_overflow_buckets = config.throw_on_overflow_grace_aggregate_merging_buckets;
     aggregated_keys_before_extend_buckets = config.aggregated_keys_before_extend_grace_aggregate_merging_buckets;
     aggregated_keys_before_extend_buckets = PODArrayUtil::adjustMemoryEfficientSize(aggregated_keys_before_extend_buckets);
     max_pending_flush_blocks_per_bucket = config.max_pending_flush_blocks_per_grace_aggregate_merging_bucket;
     max_allowed_memory_usage_ratio = config.max_allowed_memory_usage_ratio_for_aggregate_merging;
+    parallel_merging_threads = config.parallel_merging_threads;
+    parallel_merging_memory_budget = config.parallel_merging_memory_budget;
+    parallel_merging_ordered_output = config.parallel_merging_ordered_output;
     // bucket 0 is for in-memory data, it's just a placeholder.
     buckets.emplace(0, BufferFileStream());
     enable_spill_test = config.enable_spill_test;
@@ -69,6 +85,10 @@ GraceAggregatingTransform::GraceAggregatingTransform(
 
 GraceAggregatingTransform::~GraceAggregatingTransform()
 {
+    /// The merging tasks refer to the buckets.
+    for (auto & bucket : merging_buckets)
+        bucket.data_variants.wait();
+
     LOG_INFO(
         logger,
         "Metrics. total_input_blocks: {}, total_input_rows: {}, total_output_blocks: {}, total_output_rows: {}, total_spill_disk_bytes: "
@@ -137,7 +157,9 @@ GraceAggregatingTransform::Status GraceAggregatingTransform::prepare()
         return Status::Ready;
     }
 
-    if (current_bucket_index >= getBucketsNum() && (!block_converter || !block_converter->hasNext()))
+    const bool all_buckets_output = isParallelMerging() ? next_bucket_to_merge >= getBucketsNum() && merging_buckets.empty()
+                                                        : current_bucket_index >= getBucketsNum();
+    if (all_buckets_output && (!block_converter || !block_converter->hasNext()))
     {
         output.finish();
         return Status::Finished;
@@ -160,13 +182,28 @@ void GraceAggregatingTransform::work()
         if (!block_converter || !block_converter->hasNext())
         {
             block_converter = nullptr;
-            while (current_bucket_index < getBucketsNum())
+            if (isParallelMerging())
             {
-                block_converter = prepareBucketOutputBlocks(current_bucket_index);
-                if (block_converter)
-                    break;
-                current_bucket_index++;
+                if (force_spill)
+                {
+                    std::lock_guard lock(forward_mutex);
+                    flushUnscheduledBuckets();
+                    force_spill = false;
+                }
+                block_converter = takeMergedBucket();
             }
+            else
+            {
+                while (current_bucket_index < getBucketsNum() && !isParallelMerging())
+                {
+                    block_converter = prepareBucketOutputBlocks(current_bucket_index);
+                    if (block_converter)
+                        break;
+                    current_bucket_index++;
+                }
+            }
+            if (parallel_merging_threads > 1 && !parallel_merging_stopped)
+                scheduleBucketMerges();
         }
         if (!block_converter)
         {
@@ -186,7 +223,8 @@ void GraceAggregatingTransform::work()
         if (!block_converter->hasNext())
         {
             block_converter = nullptr;
-            current_bucket_index++;
+            if (!isParallelMerging())
+                current_bucket_index++;
         }
     }
 }
@@ -291,6 +329,7 @@ void GraceAggregatingTransform::addBlockIntoFileBucket(size_t bucket_index, cons
             DB::ErrorCodes::LOGICAL_ERROR, "Add invalid block with bucket_num {} into bucket {}", block.info.bucket_num, bucket_index);
     }
     auto & file_stream = buckets[bucket_index];
+    file_stream.scattered_buckets_nums.insert(block.info.bucket_num);
     file_stream.pending_bytes += block.allocatedBytes();
     if (is_original_block && no_pre_aggregated)
         file_stream.original_blocks.push_back(block);
@@ -343,7 +382,7 @@ static size_t flushBlocksInfoDisk(std::optional<DB::TemporaryBlockStreamHolder>
 size_t GraceAggregatingTransform::flushBucket(size_t bucket_index)
 {
     Stopwatch watch;
-    auto & file_stream = buckets[bucket_index];
+    auto & file_stream = buckets.at(bucket_index);
     size_t flush_bytes = 0;
     if (!file_stream.original_blocks.empty())
     {
@@ -360,6 +399,7 @@ size_t GraceAggregatingTransform::flushBucket(size_t bucket_index)
         }
         flush_bytes += flushBlocksInfoDisk(file_stream.intermediate_file_stream, file_stream.intermediate_blocks);
     }
+    file_stream.spilled_bytes += flush_bytes;
     total_spill_disk_bytes += flush_bytes;
     total_spill_disk_time += watch.elapsedMilliseconds();
     return flush_bytes;
@@ -446,6 +486,198 @@ std::unique_ptr<AggregateDataBlockConverter> GraceAggregatingTransform::prepareB
     return std::move(converter);
 }
 
+bool GraceAggregatingTransform::mayForwardRows(size_t from_bucket, size_t to_bucket) const
+{
+    /// Rows of a block scattered by n buckets into from_bucket have hash % n == from_bucket. Since the buckets number
+    /// only doubles, n divides the current one and the rows go to the buckets with index % n == from_bucket.
+    const auto buckets_num = static_cast<Int32>(getBucketsNum());
+    for (auto scattered_buckets_num : buckets.at(from_bucket).scattered_buckets_nums)
+        if (scattered_buckets_num < buckets_num && to_bucket % scattered_buckets_num == from_bucket)
+            return true;
+    return false;
+}
+
+void GraceAggregatingTransform::scheduleBucketMerges()
+{
+    while (next_bucket_to_merge < getBucketsNum())
+    {
+        const size_t bucket_index = next_bucket_to_merge;
+        size_t running = 0;
+        for (const auto & bucket : merging_buckets)
+        {
+            if (bucket.data_variants.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                continue;
+            /// Forwarded rows must arrive before the bucket is merged.
+            if (mayForwardRows(bucket.bucket_index, bucket_index))
+                return;
+            ++running;
+        }
+        if (running >= parallel_merging_threads)
+            return;
+
+        size_t estimated_bytes = 0;
+        {
+            std::lock_guard lock(forward_mutex);
+            const auto & file_stream = buckets.at(bucket_index);
+            estimated_bytes = file_stream.spilled_bytes + file_stream.pending_bytes;
+        }
+        /// A bucket larger than the budget on its own is left to takeMergedBucket, which merges it one by one.
+        if (merging_bytes + estimated_bytes > parallel_merging_memory_budget)
+            return;
+
+        auto task = std::make_shared<std::packaged_task<DB::AggregatedDataVariantsPtr()>>(
+            [this, bucket_index, thread_group = DB::CurrentThread::getGroup()]
+            {
+                DB::ThreadGroupSwitcher switcher(thread_group, ThreadName::ASYNC_MERGE);
+                return mergeBucket(bucket_index);
+            });
+        merging_buckets.push_back({bucket_index, estimated_bytes, task->get_future()});
+        merging_bytes += estimated_bytes;
+        LocalThreadPools::graceAggregateMerge().scheduleOrThrow([task] { (*task)(); });
+        ++next_bucket_to_merge;
+    }
+}
+
+DB::AggregatedDataVariantsPtr GraceAggregatingTransform::mergeBucket(size_t bucket_index)
+{
+    Stopwatch watch;
+    size_t read_bytes = 0;
+    size_t read_rows = 0;
+    const size_t buckets_num = getBucketsNum();
+    auto & buffer_file_stream = buckets.at(bucket_index);
+    auto data_variants = std::make_shared<DB::AggregatedDataVariants>();
+    DB::ColumnRawPtrs bucket_key_columns(params->params.keys_size);
+    DB::Aggregator::AggregateColumns bucket_aggregate_columns(params->params.aggregates_size);
+    bool bucket_no_more_keys = false;
+
+    auto merge_block = [&](const DB::Block & block, bool is_original_block)
+    {
+        if (!block.rows())
+            return;
+        DB::Block bucket_block = block;
+        if (block.info.bucket_num != static_cast<Int32>(buckets_num))
+        {
+            auto scattered_blocks = DB::JoinCommon::scatterBlockByHash(params->params.keys, block, buckets_num);
+            std::lock_guard lock(forward_mutex);
+            for (size_t i = 0; i < buckets_num; ++i)
+            {
+                auto & scattered_block = scattered_blocks[i];
+                if (i == bucket_index || !scattered_block.rows())
+                    continue;
+                scattered_block.info.bucket_num = static_cast<Int32>(buckets_num);
+                auto & file_stream = buckets.at(i);
+                file_stream.pending_bytes += scattered_block.allocatedBytes();
+                if (is_original_block && no_pre_aggregated)
+                    file_stream.original_blocks.push_back(std::move(scattered_block));
+                else
+                    file_stream.intermediate_blocks.push_back(std::move(scattered_block));
+                /// Bucket i is not merged before this one is, so its blocks can be spilled here.
+                if (file_stream.pending_bytes > max_pending_flush_blocks_per_bucket || enable_spill_test)
+                {
+                    flushBucket(i);
+                    file_stream.pending_bytes = 0;
+                }
+            }
+            bucket_block = std::move(scattered_blocks[bucket_index]);
+        }
+        if (is_original_block && no_pre_aggregated)
+            params->aggregator.executeOnBlock(
+                bucket_block, *data_variants, bucket_key_columns, bucket_aggregate_columns, bucket_no_more_keys);
+        else
+            params->aggregator.mergeOnBlock(bucket_block, *data_variants, bucket_no_more_keys, is_cancelled);
+    };
+
+    auto merge_file_stream = [&](std::optional<DB::TemporaryBlockStreamHolder> & file_stream, bool is_original_block)
+    {
+        if (!file_stream)
+            return;
+        file_stream->finishWriting();
+        auto reader = file_stream->getReadStream();
+        while (true)
+        {
+            auto block = reader->read();
+            if (!block.rows())
+                break;
+            read_bytes += block.bytes();
+            read_rows += block.rows();
+            merge_block(block, is_original_block);
+        }
+        file_stream.reset();
+    };
+
+    /// The buckets forwarding rows into this one are merged already, nothing changes the in-memory blocks anymore.
+    merge_file_stream(buffer_file_stream.intermediate_file_stream, false);
+    for (auto & block : buffer_file_stream.intermediate_blocks)
+    {
+        merge_block(block, false);
+        block = {};
+    }
+    merge_file_stream(buffer_file_stream.original_file_stream, true);
+    for (auto & block : buffer_file_stream.original_blocks)
+    {
+        merge_block(block, true);
+        block = {};
+    }
+
+    LOG_INFO(
+        logger,
+        "merged bucket {} in parallel, aggregated result keys: {}, read bytes from disk: {}, read rows: {}, time: {} ms",
+        bucket_index,
+        data_variants->size(),
+        ReadableSize(read_bytes),
+        read_rows,
+        watch.elapsedMilliseconds());
+    return data_variants;
+}
+
+void GraceAggregatingTransform::flushUnscheduledBuckets()
+{
+    for (size_t i = next_bucket_to_merge; i < getBucketsNum(); ++i)
+    {
+        flushBucket(i);
+        buckets.at(i).pending_bytes = 0;
+    }
+}
+
+std::unique_ptr<AggregateDataBlockConverter> GraceAggregatingTransform::takeMergedBucket()
+{
+    scheduleBucketMerges();
+    if (merging_buckets.empty())
+    {
+        /// Nothing is running, so the next bucket is larger than the budget. Merge it and the rest one by one, where a
+        /// bucket that does not fit in memory is split again.
+        if (next_bucket_to_merge < getBucketsNum())
+        {
+            LOG_INFO(
+                logger,
+                "Bucket {} is over the parallel merging budget {}, merge the remaining buckets one by one",
+                next_bucket_to_merge,
+                ReadableSize(parallel_merging_memory_budget));
+            parallel_merging_stopped = true;
+            current_bucket_index = next_bucket_to_merge;
+        }
+        return nullptr;
+    }
+
+    auto it = merging_buckets.begin();
+    if (!parallel_merging_ordered_output)
+    {
+        auto ready = std::find_if(
+            merging_buckets.begin(),
+            merging_buckets.end(),
+            [](const auto & bucket) { return bucket.data_variants.wait_for(std::chrono::seconds(0)) == std::future_status::ready; });
+        if (ready != merging_buckets.end())
+            it = ready;
+    }
+
+    Stopwatch watch;
+    auto data_variants = it->data_variants.get();
+    LOG_DEBUG(logger, "Take merged bucket {}, waited {} ms", it->bucket_index, watch.elapsedMilliseconds());
+    merging_bytes -= it->estimated_bytes;
+    merging_buckets.erase(it);
+    return std::make_unique<AggregateDataBlockConverter>(params->aggregator, data_variants, final_output);
+}
+
 std::unique_ptr<AggregateDataBlockConverter> GraceAggregatingTransform::currentDataVariantToBlockConverter(bool final)
 {
     if (!current_data_variants)
@@ -597,15 +829,19 @@ bool GraceAggregatingTransform::isMemoryOverflow()
 DB::ProcessorMemoryStats GraceAggregatingTransform::getMemoryStats()
 {
     DB::ProcessorMemoryStats stats;
+    {
+        /// The merging tasks forward rows into the buckets not scheduled yet.
+        std::lock_guard lock(forward_mutex);
+        const size_t first_pending_bucket = isParallelMerging() ? next_bucket_to_merge : current_bucket_index + 1;
+        for (size_t i = first_pending_bucket; i < getBucketsNum(); ++i)
+            stats.spillable_memory_bytes += buckets.at(i).pending_bytes;
+    }
+    /// The hash tables of the buckets merged in parallel are not spillable, estimated by the bytes they are built from.
+    stats.need_reserved_memory_bytes = merging_bytes;
     if (!current_data_variants)
         return stats;
 
-    stats.need_reserved_memory_bytes = current_data_variants->aggregates_pool->allocatedBytes();
-    for (size_t i = current_bucket_index + 1; i < getBucketsNum(); ++i)
-    {
-        auto & file_stream = buckets[i];
-        stats.spillable_memory_bytes += file_stream.pending_bytes;
-    }
+    stats.need_reserved_memory_bytes += current_data_variants->aggregates_pool->allocatedBytes();
 
     if (per_key_memory_usage > 0)
     {
@@ -15,6 +15,10 @@
  * limitations under the License.
  */
 #pragma once
+#include <deque>
+#include <future>
+#include <mutex>
+#include <set>
 #include <Core/Block.h>
 #include <Interpreters/Aggregator.h>
 #include <Interpreters/Context.h>
@@ -24,6 +28,7 @@
 #include <Processors/Transforms/AggregatingTransform.h>
 #include <Poco/Logger.h>
 #include <Common/AggregateUtil.h>
+#include <Common/GlutenConfig.h>
 #include <Common/MemorySpillScheduler.h>
 
 
@@ -34,6 +39,13 @@ namespace local_engine
  * when the memory usage is over limit.
  * If the input data is original data, no_pre_aggregated is true. If it's intermediate aggregating result, no_pre_aggregated is false.
  * IF the output data is final aggregating result, final is true, otherwise it false.
+ *
+ * Once the input is finished, the spilled buckets are merged one by one. With grace_aggregate_merging_parallel_threads > 1
+ * they are merged into separate hash tables on LocalThreadPools::graceAggregateMerge() instead, bounded by a memory budget
+ * on their spilled bytes. The number of buckets is fixed while buckets are merged in parallel. Blocks scattered before the
+ * last extension of the buckets hold rows of higher buckets, which are forwarded to them and spilled like the input, so a
+ * bucket is only merged after the buckets that may forward to it. A bucket larger than the budget on its own stops the
+ * parallel merging, and it and the following buckets are merged one by one, where the buckets can be extended again.
  */
 class GraceAggregatingTransform : public DB::IProcessor
 {
@@ -45,6 +57,13 @@ public:
         DB::ContextPtr context_,
         bool no_pre_aggregated_,
         bool final_output_);
+    GraceAggregatingTransform(
+        const DB::SharedHeader & header_,
+        DB::AggregatingTransformParamsPtr params_,
+        DB::ContextPtr context_,
+        bool no_pre_aggregated_,
+        bool final_output_,
+        const GraceMergingAggregateConfig & config);
     ~GraceAggregatingTransform() override;
 
     Status prepare() override;
@@ -76,6 +95,12 @@ private:
     double max_allowed_memory_usage_ratio = 0.9;
     // configured by max_pending_flush_blocks_per_grace_merging_bucket
     size_t max_pending_flush_blocks_per_bucket = 0;
+    // configured by grace_aggregate_merging_parallel_threads
+    size_t parallel_merging_threads = 0;
+    // configured by grace_aggregate_merging_parallel_memory_budget
+    size_t parallel_merging_memory_budget = 0;
+    // configured by grace_aggregate_merging_parallel_ordered_output
+    bool parallel_merging_ordered_output = true;
 
     struct BufferFileStream
     {
@@ -88,6 +113,9 @@ private:
         /// Only be used when there is no pre-aggregated step
         std::optional<DB::TemporaryBlockStreamHolder> original_file_stream;
         size_t pending_bytes = 0;
+        size_t spilled_bytes = 0;
+        /// The buckets numbers the blocks of this bucket were scattered by.
+        std::set<Int32> scattered_buckets_nums;
     };
     std::unordered_map<size_t, BufferFileStream> buckets;
 
@@ -108,6 +136,34 @@ private:
     /// Merge one block into current_data_variants.
     void mergeOneBlock(const DB::Block & block, bool is_original_block);
 
+    // parallel merging of the buckets after the input is finished
+    struct MergingBucket
+    {
+        size_t bucket_index;
+        size_t estimated_bytes;
+        std::future<DB::AggregatedDataVariantsPtr> data_variants;
+    };
+    /// Buckets scheduled and not output yet, in bucket order.
+    std::deque<MergingBucket> merging_buckets;
+    size_t merging_bytes = 0;
+    /// Bucket 0 holds the in-memory data and is output first, in this thread.
+    size_t next_bucket_to_merge = 1;
+    /// Set once a bucket is too large to be merged in parallel. The remaining buckets are merged one by one.
+    bool parallel_merging_stopped = false;
+    /// Protects the in-memory blocks and the spill streams of the buckets while the merging tasks forward rows.
+    std::mutex forward_mutex;
+
+    bool isParallelMerging() const { return parallel_merging_threads > 1 && current_bucket_index > 0 && !parallel_merging_stopped; }
+    /// Whether merging `from_bucket` may forward rows into `to_bucket`.
+    bool mayForwardRows(size_t from_bucket, size_t to_bucket) const;
+    void scheduleBucketMerges();
+    /// Runs on the merging pool.
+    DB::AggregatedDataVariantsPtr mergeBucket(size_t bucket_index);
+    /// Spills the pending blocks of the buckets not scheduled yet. Requires forward_mutex.
+    void flushUnscheduledBuckets();
+    /// Waits for a merged bucket and makes an AggregateDataBlockConverter for it.
+    std::unique_ptr<AggregateDataBlockConverter> takeMergedBucket();
+
     // spill control
     bool isMemoryOverflow();
     DB::ProcessorMemoryStats getMemoryStats() override;
@@ -0,0 +1,620 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HashWindowGroupLimitStep.h"
+
+#include <Columns/IColumn.h>
+#include <Core/Defines.h>
+#include <Interpreters/Context.h>
+#include <Interpreters/TemporaryDataOnDisk.h>
+#include <Processors/Chunk.h>
+#include <Processors/IProcessor.h>
+#include <Processors/Port.h>
+#include <QueryPipeline/QueryPipelineBuilder.h>
+#include <Common/GlutenConfig.h>
+#include <Common/HashTable/HashMap.h>
+#include <Common/SipHash.h>
+#include <Common/Stopwatch.h>
+#include <Common/logger_useful.h>
+
+namespace DB::ErrorCodes
+{
+extern const int LOGICAL_ERROR;
+}
+
+namespace local_engine
+{
+
+enum class HashWindowGroupLimitFunction
+{
+    RowNumber,
+    Rank,
+    DenseRank
+};
+
+/// Keeps the top `limit` rows of each partition of unsorted input.
+///
+/// The kept rows are copied into one set of columns, and each partition refers to its rows there. Once a partition
+/// holds twice the rows it kept after its last pruning, its rows are sorted and the ones ranked after `limit` are
+/// dropped. The last row kept becomes the partition's threshold when the partition is full, later rows ranked after it
+/// are dropped before being copied.
+///
+/// When the kept rows and the partitions take more than max_bytes_in_memory, the partitions are scattered by hash into
+/// buckets. Bucket 0 stays in memory and the other buckets are written to disk. If bucket 0 goes over the limit again,
+/// its pruned rows are written to disk as well. The spilled buckets are processed one after another at the end, and a
+/// bucket going over the limit is scattered again with another hash, up to MAX_SPILL_LEVEL times.
+class HashWindowGroupLimitTransform : public DB::IProcessor
+{
+public:
+    using Status = DB::IProcessor::Status;
+    HashWindowGroupLimitTransform(
+        const DB::SharedHeader & header_,
+        const DB::ContextPtr & context_,
+        HashWindowGroupLimitFunction function_,
+        const std::vector<size_t> & partition_columns_,
+        const DB::SortDescription & sort_description_,
+        size_t limit_,
+        const WindowConfig & config_)
+        : DB::IProcessor({header_}, {header_})
+        , header(header_)
+        , function(function_)
+        , partition_columns(partition_columns_)
+        , limit(limit_)
+        , max_bytes_in_memory(config_.hash_topk_max_bytes_in_memory)
+        , spill_buckets_num(config_.hash_topk_spill_buckets)
+        , tmp_data_disk(context_->getTempDataOnDisk())
+    {
+        if (!limit)
+            throw DB::Exception(DB::ErrorCodes::LOGICAL_ERROR, "Invalid limit {} in HashWindowGroupLimit", limit);
+        for (const auto & sort_column : sort_description_)
+            sort_columns.push_back(
+                {header->getPositionByName(sort_column.column_name), sort_column.direction, sort_column.nulls_direction});
+        resetPartitions();
+    }
+    ~HashWindowGroupLimitTransform() override = default;
+    String getName() const override { return "HashWindowGroupLimitTransform"; }
+
+    Status prepare() override
+    {
+        auto & output = outputs.front();
+        auto & input = inputs.front();
+        if (output.isFinished() || isCancelled())
+        {
+            input.close();
+            return Status::Finished;
+        }
+
+        if (!output_chunks.empty())
+        {
+            if (output.canPush())
+            {
+                output.push(std::move(output_chunks.front()));
+                output_chunks.pop_front();
+            }
+            return Status::PortFull;
+        }
+
+        if (has_input)
+            return Status::Ready;
+
+        if (input_finished)
+        {
+            if (!all_buckets_output)
+                return Status::Ready;
+            output.finish();
+            return Status::Finished;
+        }
+
+        if (input.isFinished())
+        {
+            input_finished = true;
+            return Status::Ready;
+        }
+        input.setNeeded();
+        if (!input.hasData())
+            return Status::NeedData;
+        input_chunk = input.pull(true);
+        has_input = true;
+        return Status::Ready;
+    }
+
+    void work() override
+    {
+        if (has_input)
+        {
+            auto rows = input_chunk.getNumRows();
+            addRows(input_chunk.detachColumns(), rows);
+            has_input = false;
+        }
+        else if (input_finished && !all_buckets_output)
+        {
+            finishBucket();
+            loadNextSpilledBucket();
+        }
+    }
+
+private:
+    /// Each level scatters the rows of a bucket with a different hash, so a bucket too large for memory is split up by
+    /// the next level. The last level keeps all its rows in memory.
+    static constexpr size_t MAX_SPILL_LEVEL = 4;
+
+    struct SortColumn
+    {
+        size_t position;
+        int direction;
+        int nulls_direction;
+    };
+
+    struct Partition
+    {
+        // Positions of the rows in kept_columns.
+        std::vector<size_t> rows;
+        size_t prune_at = 0;
+        // The last row kept by the last pruning, set once the partition is full.
+        std::optional<size_t> threshold;
+    };
+
+    struct SpilledBucket
+    {
+        DB::TemporaryBlockStreamHolder stream;
+        size_t level;
+    };
+
+    DB::SharedHeader header;
+    HashWindowGroupLimitFunction function;
+    std::vector<size_t> partition_columns;
+    std::vector<SortColumn> sort_columns;
+    size_t limit = 0;
+    size_t max_bytes_in_memory = 0;
+    size_t spill_buckets_num = 0;
+
+    bool has_input = false;
+    bool input_finished = false;
+    bool all_buckets_output = false;
+    DB::Chunk input_chunk;
+    std::list<DB::Chunk> output_chunks;
+
+    HashMap<UInt128, size_t, UInt128TrivialHash> partition_index;
+    std::vector<Partition> partitions;
+    DB::MutableColumns kept_columns;
+    DB::ColumnRawPtrs kept_raw_columns;
+    // Rows in kept_columns, including the ones dropped by pruning.
+    size_t kept_rows = 0;
+    size_t live_rows = 0;
+
+    DB::TemporaryDataOnDiskScopePtr tmp_data_disk;
+    // The level of the rows in memory, 0 for the input and the level of the bucket being processed after it.
+    size_t spill_level = 0;
+    // Empty until the rows of this level are scattered. A bucket's stream is created by its first spilled rows, bucket
+    // 0 only has one once its in-memory rows are flushed.
+    std::vector<std::optional<DB::TemporaryBlockStreamHolder>> spill_streams;
+    std::vector<SpilledBucket> spilled_buckets;
+    size_t total_spill_rows = 0;
+    size_t total_spill_buckets = 0;
+
+    LoggerPtr logger = getLogger("HashWindowGroupLimitTransform");
+
+    static DB::ColumnRawPtrs getRawColumns(const DB::Columns & columns)
+    {
+        DB::ColumnRawPtrs raw_columns;
+        raw_columns.reserve(columns.size());
+        for (const auto & column : columns)
+            raw_columns.push_back(column.get());
+        return raw_columns;
+    }
+
+    int compareRows(const DB::ColumnRawPtrs & lhs, size_t lhs_row, const DB::ColumnRawPtrs & rhs, size_t rhs_row) const
+    {
+        for (const auto & sort_column : sort_columns)
+        {
+            int res = lhs[sort_column.position]->compareAt(lhs_row, rhs_row, *rhs[sort_column.position], sort_column.nulls_direction);
+            if (res)
+                return res * sort_column.direction;
+        }
+        return 0;
+    }
+
+    /// Whether a row ranks after the threshold row of a full partition.
+    bool isOutOfLimit(const DB::ColumnRawPtrs & columns, size_t row, size_t threshold) const
+    {
+        int res = compareRows(columns, row, kept_raw_columns, threshold);
+        // Peers of the threshold row get the same rank, but not the same row number.
+        return function == HashWindowGroupLimitFunction::RowNumber ? res >= 0 : res > 0;
+    }
+
+    size_t getMemoryBytes() const
+    {
+        // The row positions of the partitions are counted by kept_rows, their vectors grow up to twice the kept rows.
+        size_t bytes = partition_index.getBufferSizeInBytes() + partitions.capacity() * sizeof(Partition) + kept_rows * sizeof(size_t);
+        for (const auto & column : kept_columns)
+            bytes += column->allocatedBytes();
+        return bytes;
+    }
+
+    void resetPartitions()
+    {
+        partition_index.clearAndShrink();
+        partitions.clear();
+        partitions.shrink_to_fit();
+        kept_columns = header->cloneEmptyColumns();
+        kept_raw_columns.clear();
+        for (const auto & column : kept_columns)
+            kept_raw_columns.push_back(column.get());
+        kept_rows = 0;
+        live_rows = 0;
+    }
+
+    void addRows(DB::Columns columns, size_t num_rows)
+    {
+        if (!num_rows)
+            return;
+        if (!spill_streams.empty())
+        {
+            auto scattered_columns = scatterRows(columns, num_rows);
+            for (size_t i = 1; i < scattered_columns.size(); ++i)
+                writeToBucket(i, header->cloneWithColumns(std::move(scattered_columns[i])));
+            num_rows = scattered_columns[0].front()->size();
+            if (!num_rows)
+                return;
+            columns = std::move(scattered_columns[0]);
+        }
+
+        insertRows(getRawColumns(columns), num_rows);
+
+        if (getMemoryBytes() > max_bytes_in_memory)
+            spill();
+    }
+
+    /// Splits the rows by the hash of their partition keys, salted by the spill level.
+    std::vector<DB::Columns> scatterRows(const DB::Columns & columns, size_t num_rows) const
+    {
+        DB::IColumn::Selector selector(num_rows);
+        for (size_t row = 0; row < num_rows; ++row)
+        {
+            SipHash hash;
+            hash.update(spill_level);
+            for (auto pos : partition_columns)
+                columns[pos]->updateHashWithValue(row, hash);
+            selector[row] = hash.get64() % spill_streams.size();
+        }
+
+        std::vector<DB::Columns> scattered_columns(spill_streams.size());
+        for (const auto & column : columns)
+        {
+            auto scattered = column->scatter(spill_streams.size(), selector);
+            for (size_t i = 0; i < scattered.size(); ++i)
+                scattered_columns[i].push_back(std::move(scattered[i]));
+        }
+        return scattered_columns;
+    }
+
+    void writeToBucket(size_t bucket, const DB::Block & block)
+    {
+        if (!block.rows())
+            return;
+        auto & stream = spill_streams[bucket];
+        if (!stream)
+            stream.emplace(header, tmp_data_disk);
+        stream.value()->write(block);
+        total_spill_rows += block.rows();
+    }
+
+    void insertRows(const DB::ColumnRawPtrs & columns, size_t num_rows)
+    {
+        DB::IColumn::Filter selected(num_rows, 0);
+        std::vector<size_t> selected_partitions;
+        selected_partitions.reserve(num_rows);
+        for (size_t row = 0; row < num_rows; ++row)
+        {
+            SipHash hash;
+            for (auto pos : partition_columns)
+                columns[pos]->updateHashWithValue(row, hash);
+
+            HashMap<UInt128, size_t, UInt128TrivialHash>::LookupResult it;
+            bool inserted;
+            partition_index.emplace(hash.get128(), it, inserted);
+            if (inserted)
+            {
+                it->getMapped() = partitions.size();
+                partitions.emplace_back().prune_at = 2 * limit;
+            }
+
+            const auto & partition = partitions[it->getMapped()];
+            if (partition.threshold && isOutOfLimit(columns, row, *partition.threshold))
+                continue;
+            selected[row] = 1;
+            selected_partitions.push_back(it->getMapped());
+        }
+        if (selected_partitions.empty())
+            return;
+
+        const size_t selected_rows = selected_partitions.size();
+        for (size_t i = 0; i < kept_columns.size(); ++i)
+        {
+            if (selected_rows == num_rows)
+                kept_columns[i]->insertRangeFrom(*columns[i], 0, num_rows);
+            else
+                kept_columns[i]->insertRangeFrom(*columns[i]->filter(selected, selected_rows), 0, selected_rows);
+        }
+        for (size_t i = 0; i < selected_rows; ++i)
+            partitions[selected_partitions[i]].rows.push_back(kept_rows + i);
+        kept_rows += selected_rows;
+        live_rows += selected_rows;
+
+        for (auto partition_id : selected_partitions)
+        {
+            auto & partition = partitions[partition_id];
+            if (partition.rows.size() >= partition.prune_at)
+                prune(partition);
+        }
+
+        // Pruned rows stay in kept_columns until they make up most of them.
+        if (kept_rows > DB::DEFAULT_BLOCK_SIZE && kept_rows > 2 * live_rows)
+            compact();
+    }
+
+    /// Sorts the rows of a partition and drops the ones ranked after `limit`.
+    void prune(Partition & partition)
+    {
+        auto & rows = partition.rows;
+        std::sort(
+            rows.begin(),
+            rows.end(),
+            [&](size_t lhs, size_t rhs) { return compareRows(kept_raw_columns, lhs, kept_raw_columns, rhs) < 0; });
+
+        size_t rank = 0;
+        size_t keep = 0;
+        for (; keep < rows.size(); ++keep)
+        {
+            if (function == HashWindowGroupLimitFunction::RowNumber)
+                rank = keep + 1;
+            else if (keep == 0 || compareRows(kept_raw_columns, rows[keep - 1], kept_raw_columns, rows[keep]) != 0)
+                rank = function == HashWindowGroupLimitFunction::Rank ? keep + 1 : rank + 1;
+            if (rank > limit)
+                break;
+        }
+
+        live_rows -= rows.size() - keep;
+        rows.resize(keep);
+        const bool full = function == HashWindowGroupLimitFunction::DenseRank ? rank >= limit : keep >= limit;
+        if (full)
+            partition.threshold = rows.back();
+        // Ties of rank and dense_rank can keep many rows, don't sort them again for every new row.
+        partition.prune_at = std::max(2 * limit, 2 * keep);
+    }
+
+    /// Returns the permutation of the kept rows grouped by partition. Pruning the partitions first sorts the rows
+    /// inside each of them.
+    DB::IColumn::Permutation collectRows(bool prune_partitions)
+    {
+        DB::IColumn::Permutation permutation;
+        permutation.reserve(live_rows);
+        for (auto & partition : partitions)
+        {
+            if (prune_partitions)
+                prune(partition);
+            permutation.insert(partition.rows.begin(), partition.rows.end());
+        }
+        return permutation;
+    }
+
+    DB::Columns permuteKeptColumns(const DB::IColumn::Permutation & permutation, size_t offset, size_t rows) const
+    {
+        DB::IColumn::Permutation slice(permutation.begin() + offset, permutation.begin() + offset + rows);
+        DB::Columns columns;
+        for (const auto & column : kept_columns)
+            columns.push_back(column->permute(slice, rows));
+        return columns;
+    }
+
+    void compact()
+    {
+        auto permutation = collectRows(false);
+        for (size_t i = 0; i < kept_columns.size(); ++i)
+        {
+            kept_columns[i] = DB::IColumn::mutate(kept_columns[i]->permute(permutation, permutation.size()));
+            kept_raw_columns[i] = kept_columns[i].get();
+        }
+        size_t row = 0;
+        for (auto & partition : partitions)
+        {
+            for (auto & partition_row : partition.rows)
+            {
+                if (partition.threshold == partition_row)
+                    partition.threshold = row;
+                partition_row = row++;
+            }
+        }
+        kept_rows = row;
+    }
+
+    /// Scatters the partitions into buckets on the first call of a level, and flushes bucket 0 on the later ones.
+    void spill()
+    {
+        if (spill_level >= MAX_SPILL_LEVEL || spill_buckets_num < 2 || partition_columns.empty())
+            return;
+        Stopwatch watch;
+        const size_t partitions_num = partitions.size();
+        if (!spill_streams.empty())
+        {
+            flushInMemoryBucket();
+            LOG_DEBUG(
+                logger, "Flush {} partitions of spill level {}, time: {} ms", partitions_num, spill_level, watch.elapsedMilliseconds());
+            return;
+        }
+
+        spill_streams.resize(spill_buckets_num);
+        auto permutation = collectRows(false);
+        auto columns = permuteKeptColumns(permutation, 0, permutation.size());
+        resetPartitions();
+        addRows(std::move(columns), permutation.size());
+        LOG_INFO(
+            logger,
+            "Spill {} partitions of spill level {} into {} buckets, {} partitions left in memory, time: {} ms",
+            partitions_num,
+            spill_level,
+            spill_buckets_num,
+            partitions.size(),
+            watch.elapsedMilliseconds());
+    }
+
+    /// Writes the top rows of the in-memory partitions to the stream of bucket 0.
+    void flushInMemoryBucket()
+    {
+        auto permutation = collectRows(true);
+        for (size_t offset = 0; offset < permutation.size(); offset += DB::DEFAULT_BLOCK_SIZE)
+        {
+            const size_t rows = std::min(DB::DEFAULT_BLOCK_SIZE, permutation.size() - offset);
+            writeToBucket(0, header->cloneWithColumns(permuteKeptColumns(permutation, offset, rows)));
+        }
+        resetPartitions();
+    }
+
+    void outputPartitions()
+    {
+        auto permutation = collectRows(true);
+        for (size_t offset = 0; offset < permutation.size(); offset += DB::DEFAULT_BLOCK_SIZE)
+        {
+            const size_t rows = std::min(DB::DEFAULT_BLOCK_SIZE, permutation.size() - offset);
+            output_chunks.emplace_back(permuteKeptColumns(permutation, offset, rows), rows);
+        }
+        resetPartitions();
+    }
+
+    /// Outputs the rows in memory, unless bucket 0 was flushed, and queues the buckets spilled at this level.
+    void finishBucket()
+    {
+        if (!spill_streams.empty() && spill_streams[0])
+            flushInMemoryBucket();
+        else
+            outputPartitions();
+
+        for (auto & stream : spill_streams)
+        {
+            if (!stream)
+                continue;
+            stream->finishWriting();
+            spilled_buckets.push_back({std::move(*stream), spill_level + 1});
+            ++total_spill_buckets;
+        }
+        spill_streams.clear();
+    }
+
+    void loadNextSpilledBucket()
+    {
+        while (!spilled_buckets.empty())
+        {
+            auto bucket = std::move(spilled_buckets.back());
+            spilled_buckets.pop_back();
+            spill_level = bucket.level;
+            auto reader = bucket.stream.getReadStream();
+            size_t read_rows = 0;
+            while (true)
+            {
+                auto block = reader->read();
+                if (!block.rows())
+                    break;
+                read_rows += block.rows();
+                auto rows = block.rows();
+                addRows(block.getColumns(), rows);
+            }
+            if (read_rows)
+            {
+                LOG_DEBUG(
+                    logger, "Load spilled bucket of spill level {}, rows: {}, partitions: {}", spill_level, read_rows, partitions.size());
+                return;
+            }
+        }
+        all_buckets_output = true;
+        if (total_spill_rows)
+            LOG_INFO(logger, "Spilled rows: {}, buckets: {}", total_spill_rows, total_spill_buckets);
+    }
+};
+
+static DB::ITransformingStep::Traits getTraits()
+{
+    return DB::ITransformingStep::Traits{
+        {
+            .preserves_number_of_streams = true,
+            .preserves_sorting = false,
+        },
+        {
+            .preserves_number_of_rows = false,
+        }};
+}
+
+HashWindowGroupLimitStep::HashWindowGroupLimitStep(
+    const DB::ContextPtr & context_,
+    const DB::SharedHeader & input_header_,
+    const String & function_name_,
+    const std::vector<size_t> & partition_columns_,
+    const DB::SortDescription & sort_description_,
+    size_t limit_)
+    : HashWindowGroupLimitStep(
+          context_, input_header_, function_name_, partition_columns_, sort_description_, limit_, WindowConfig::loadFromContext(context_))
+{
+}
+
+HashWindowGroupLimitStep::HashWindowGroupLimitStep(
+    const DB::ContextPtr & context_,
+    const DB::SharedHeader & input_header_,
+    const String & function_name_,
+    const std::vector<size_t> & partition_columns_,
+    const DB::SortDescription & sort_description_,
+    size_t limit_,
+    const WindowConfig & config_)
+    : DB::ITransformingStep(input_header_, input_header_, getTraits())
+    , context(context_)
+    , function_name(function_name_)
+    , partition_columns(partition_columns_)
+    , sort_description(sort_description_)
+    , limit(limit_)
+    , config(config_)
+{
+}
+
+void HashWindowGroupLimitStep::describePipeline(DB::IQueryPlanStep::FormatSettings & settings) const
+{
+    if (!processors.empty())
+        DB::IQueryPlanStep::describePipeline(processors, settings);
+}
+
+void HashWindowGroupLimitStep::updateOutputHeader()
+{
+    output_header = input_headers.front();
+}
+
+void HashWindowGroupLimitStep::transformPipeline(DB::QueryPipelineBuilder & pipeline, const DB::BuildQueryPipelineSettings & /*settings*/)
+{
+    HashWindowGroupLimitFunction function;
+    if (function_name == "row_number")
+        function = HashWindowGroupLimitFunction::RowNumber;
+    else if (function_name == "rank")
+        function = HashWindowGroupLimitFunction::Rank;
+    else if (function_name == "dense_rank")
+        function = HashWindowGroupLimitFunction::DenseRank;
+    else
+        throw DB::Exception(DB::ErrorCodes::LOGICAL_ERROR, "Unsupport function {} in HashWindowGroupLimit", function_name);
+
+    pipeline.addSimpleTransform(
+        [&](const DB::SharedHeader & header)
+        {
+            return std::make_shared<HashWindowGroupLimitTransform>(
+                header, context, function, partition_columns, sort_description, limit, config);
+        });
+}
+}
@@ -0,0 +1,66 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include <vector>
+#include <Core/SortDescription.h>
+#include <Interpreters/Context_fwd.h>
+#include <Processors/QueryPlan/ITransformingStep.h>
+#include <Common/GlutenConfig.h>
+
+namespace local_engine
+{
+/// Same as WindowGroupLimitStep, but the input doesn't need to be sorted by the partition and sort keys.
+/// The top `limit` rows of each partition are kept in a hash table, so a small limit needs no full sort of the input.
+/// The output is grouped by the partition keys and sorted by the sort keys inside each partition.
+class HashWindowGroupLimitStep : public DB::ITransformingStep
+{
+public:
+    explicit HashWindowGroupLimitStep(
+        const DB::ContextPtr & context_,
+        const DB::SharedHeader & input_header_,
+        const String & function_name_,
+        const std::vector<size_t> & partition_columns_,
+        const DB::SortDescription & sort_description_,
+        size_t limit_);
+    HashWindowGroupLimitStep(
+        const DB::ContextPtr & context_,
+        const DB::SharedHeader & input_header_,
+        const String & function_name_,
+        const std::vector<size_t> & partition_columns_,
+        const DB::SortDescription & sort_description_,
+        size_t limit_,
+        const WindowConfig & config_);
+    ~HashWindowGroupLimitStep() override = default;
+
+    String getName() const override { return "HashWindowGroupLimitStep"; }
+
+    void transformPipeline(DB::QueryPipelineBuilder & pipeline, const DB::BuildQueryPipelineSettings & settings) override;
+    void describePipeline(DB::IQueryPlanStep::FormatSettings & settings) const override;
+    void updateOutputHeader() override;
+
+private:
+    DB::ContextPtr context;
+    // window function name, one of row_number, rank and dense_rank
+    String function_name;
+    std::vector<size_t> partition_columns;
+    DB::SortDescription sort_description;
+    size_t limit;
+    WindowConfig config;
+};
+
+}
@@ -16,6 +16,7 @@
  */
 
 #include "StreamingAggregatingStep.h"
+#include <Columns/ColumnAggregateFunction.h>
 #include <Processors/Port.h>
 #include <Processors/Transforms/AggregatingTransform.h>
 #include <QueryPipeline/QueryPipelineBuilder.h>
@@ -39,17 +40,30 @@ namespace local_engine
 {
 StreamingAggregatingTransform::StreamingAggregatingTransform(
     DB::ContextPtr context_, const DB::SharedHeader & header_, DB::AggregatingTransformParamsPtr params_)
+    : StreamingAggregatingTransform(context_, header_, params_, StreamingAggregateConfig::loadFromContext(context_))
+{
+}
+
+StreamingAggregatingTransform::StreamingAggregatingTransform(
+    DB::ContextPtr context_,
+    const DB::SharedHeader & header_,
+    DB::AggregatingTransformParamsPtr params_,
+    const StreamingAggregateConfig & config)
     : DB::IProcessor({header_}, {params_->getHeader()})
     , context(context_)
     , key_columns(params_->params.keys_size)
     , aggregate_columns(params_->params.aggregates_size)
     , params(params_)
 {
-    auto config = StreamingAggregateConfig::loadFromContext(context);
     aggregated_keys_before_evict = config.aggregated_keys_before_streaming_aggregating_evict;
     aggregated_keys_before_evict = PODArrayUtil::adjustMemoryEfficientSize(aggregated_keys_before_evict);
     max_allowed_memory_usage_ratio = config.max_memory_usage_ratio_for_streaming_aggregating;
     high_cardinality_threshold = config.high_cardinality_threshold_for_streaming_aggregating;
+    /// Without keys every row would become one more state to merge. Merging states into states gains nothing from it.
+    enable_bypass = config.enable_streaming_aggregating_bypass && params->params.keys_size && !params->params.only_merge;
+    bypass_window_rows = config.streaming_aggregating_bypass_window_rows;
+    bypass_min_reduction_ratio = config.streaming_aggregating_bypass_min_reduction_ratio;
+    bypass_rows = config.streaming_aggregating_bypass_rows;
 }
 
 StreamingAggregatingTransform::~StreamingAggregatingTransform()
@@ -57,7 +71,8 @@ StreamingAggregatingTransform::~StreamingAggregatingTransform()
     LOG_INFO(
         logger,
         "Metrics. total_input_blocks: {}, total_input_rows: {},  total_output_blocks: {}, total_output_rows: {}, "
-        "total_clear_data_variants_num: {}, total_aggregate_time: {}, total_convert_data_variants_time: {}, current mem usage: {}",
+        "total_clear_data_variants_num: {}, total_aggregate_time: {}, total_convert_data_variants_time: {}, total_bypassed_rows: {}, "
+        "total_bypass_switches: {}, current mem usage: {}",
         total_input_blocks,
         total_input_rows,
         total_output_blocks,
@@ -65,6 +80,8 @@ StreamingAggregatingTransform::~StreamingAggregatingTransform()
         total_clear_data_variants_num,
         total_aggregate_time,
         total_convert_data_variants_time,
+        total_bypassed_rows,
+        total_bypass_switches,
         ReadableSize(currentThreadGroupMemoryUsage()));
 }
 
@@ -191,6 +208,71 @@ bool StreamingAggregatingTransform::needEvict()
     return false;
 }
 
+void StreamingAggregatingTransform::updateBypassWindow(size_t input_rows, size_t new_keys)
+{
+    window_input_rows += input_rows;
+    window_new_keys += new_keys;
+    if (window_input_rows < bypass_window_rows)
+        return;
+
+    auto reduction_ratio = 1.0 - static_cast<double>(window_new_keys) / window_input_rows;
+    if (reduction_ratio < bypass_min_reduction_ratio)
+    {
+        LOG_INFO(
+            logger,
+            "Partial aggregation reduced {} rows to {} keys, bypass it for the next {} rows",
+            window_input_rows,
+            window_new_keys,
+            bypass_rows);
+        bypass_rows_left = bypass_rows;
+        total_bypass_switches++;
+    }
+    window_input_rows = 0;
+    window_new_keys = 0;
+}
+
+DB::Chunk StreamingAggregatingTransform::convertToIntermediateStates(DB::Chunk chunk) const
+{
+    const auto & input_header = getInputs().front().getHeader();
+    const auto & output_header = getOutputs().front().getHeader();
+    const auto & aggregator_params = params->params;
+    auto num_rows = chunk.getNumRows();
+    auto input_columns = chunk.detachColumns();
+    for (auto & column : input_columns)
+        column = column->convertToFullIfNeeded();
+
+    DB::Columns columns;
+    columns.reserve(output_header.columns());
+    for (const auto & key : aggregator_params.keys)
+        columns.push_back(input_columns[input_header.getPositionByName(key)]);
+
+    DB::PODArray<DB::AggregateDataPtr> places(num_rows);
+    DB::ColumnRawPtrs arguments;
+    for (size_t i = 0; i < aggregator_params.aggregates_size; ++i)
+    {
+        const auto & aggregate = aggregator_params.aggregates[i];
+        const auto & function = aggregate.function;
+        auto column = output_header.getByPosition(aggregator_params.keys_size + i).type->createColumn();
+        auto & states_column = typeid_cast<DB::ColumnAggregateFunction &>(*column);
+        auto & arena = states_column.createOrGetArena();
+        auto & states = states_column.getData();
+        states.reserve_exact(num_rows);
+        for (size_t row = 0; row < num_rows; ++row)
+        {
+            places[row] = arena.alignedAlloc(function->sizeOfData(), function->alignOfData());
+            function->create(places[row]);
+            /// The column destroys the states it holds, also when a later one throws.
+            states.push_back(places[row]);
+        }
+
+        arguments.clear();
+        for (const auto & argument_name : aggregate.argument_names)
+            arguments.push_back(input_columns[input_header.getPositionByName(argument_name)].get());
+        function->addBatch(0, num_rows, places.data(), 0, arguments.data(), &arena);
+        columns.push_back(std::move(column));
+    }
+    return DB::Chunk(std::move(columns), num_rows);
+}
 
 void StreamingAggregatingTransform::work()
 {
@@ -234,23 +316,42 @@ void StreamingAggregatingTransform::work()
             throw DB::Exception(DB::ErrorCodes::LOGICAL_ERROR, "block_converter should be null");
         }
 
+        has_input = false;
+        if (bypass_rows_left && input_chunk.getNumRows())
+        {
+            auto num_rows = input_chunk.getNumRows();
+            Stopwatch watch;
+            output_chunk = convertToIntermediateStates(std::move(input_chunk));
+            total_aggregate_time += watch.elapsedMicroseconds();
+            input_chunk = {};
+            has_output = true;
+            total_bypassed_rows += num_rows;
+            bypass_rows_left -= std::min(bypass_rows_left, num_rows);
+            if (!bypass_rows_left)
+                LOG_DEBUG(logger, "Aggregate again after bypassing {} rows", bypass_rows);
+            return;
+        }
+
         if (!data_variants)
         {
             data_variants = std::make_shared<DB::AggregatedDataVariants>();
         }
 
-        has_input = false;
         if (input_chunk.getNumRows())
         {
             auto num_rows = input_chunk.getNumRows();
+            auto keys_before = data_variants->size();
             Stopwatch watch;
             params->aggregator.executeOnBlock(
                 input_chunk.detachColumns(), 0, num_rows, *data_variants, key_columns, aggregate_columns, no_more_keys);
             total_aggregate_time += watch.elapsedMicroseconds();
             input_chunk = {};
+            if (enable_bypass)
+                updateBypassWindow(num_rows, data_variants->size() - keys_before);
         }
 
-        if (needEvict())
+        /// Flush the aggregated keys before bypassing, the bypassed rows are merged with them downstream.
+        if (needEvict() || bypass_rows_left)
         {
             block_converter = std::make_unique<AggregateDataBlockConverter>(params->aggregator, data_variants, false);
             data_variants = nullptr;
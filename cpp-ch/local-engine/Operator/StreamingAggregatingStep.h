@@ -26,23 +26,34 @@
 #include <Processors/Transforms/AggregatingTransform.h>
 #include <Poco/Logger.h>
 #include <Common/AggregateUtil.h>
+#include <Common/GlutenConfig.h>
 
 namespace local_engine
 {
 /// A memory efficient aggregating processor.
 /// When the memory usage reaches the limit, it will evict current AggregatedDataVariants and generate
 /// intermediate aggregated result blocks, and its downstream processor should be GraceMergingAggregatedTransform.
+/// When the keys are nearly unique, aggregating barely reduces the rows. It then bypasses the hash table for a while
+/// and turns every input row into its own intermediate states.
 class StreamingAggregatingTransform : public DB::IProcessor
 {
 public:
     using Status = DB::IProcessor::Status;
     explicit StreamingAggregatingTransform(
         DB::ContextPtr context_, const DB::SharedHeader & header_, DB::AggregatingTransformParamsPtr params_);
+    StreamingAggregatingTransform(
+        DB::ContextPtr context_,
+        const DB::SharedHeader & header_,
+        DB::AggregatingTransformParamsPtr params_,
+        const StreamingAggregateConfig & config);
     ~StreamingAggregatingTransform() override;
     String getName() const override { return "StreamingAggregatingTransform"; }
     Status prepare() override;
     void work() override;
 
+    /// Rows turned into intermediate states without aggregating, reported in the RelMetric of the step.
+    size_t getBypassedRows() const { return total_bypassed_rows; }
+
 private:
     DB::ContextPtr context;
     DB::ColumnRawPtrs key_columns;
@@ -58,6 +69,16 @@ private:
     // If the cardinality of the keys is larger than this threshold, we will evict data once the keys size in
     // aggregate data variant is over aggregated_keys_before_evict, avoid the aggregated hash table becomes too large.
     double high_cardinality_threshold = 0.8;
+    bool enable_bypass = true;
+    size_t bypass_window_rows = 100000;
+    double bypass_min_reduction_ratio = 0.1;
+    size_t bypass_rows = 1000000;
+
+    /// Input rows and new keys of the current measuring window.
+    size_t window_input_rows = 0;
+    size_t window_new_keys = 0;
+    /// Rows to bypass before aggregating again. Not 0 while bypassing.
+    size_t bypass_rows_left = 0;
 
     bool no_more_keys = false;
     bool is_consume_finished = false;
@@ -82,8 +103,12 @@ private:
     size_t total_clear_data_variants_num = 0;
     size_t total_aggregate_time = 0;
     size_t total_convert_data_variants_time = 0;
+    size_t total_bypassed_rows = 0;
+    size_t total_bypass_switches = 0;
 
     bool needEvict();
+    void updateBypassWindow(size_t input_rows, size_t new_keys);
+    DB::Chunk convertToIntermediateStates(DB::Chunk chunk) const;
 };
 
 class StreamingAggregatingStep : public DB::ITransformingStep
@@ -167,6 +167,7 @@ WindowGroupOptimizationInfo WindowGroupOptimizationInfo::parse(const String & ad
     auto & kvs = kkvs["WindowGroupLimitParameters"];
     tryAssign(kvs, "window_function", info.window_function);
     tryAssign(kvs, "is_aggregate_group_limit", info.is_aggregate_group_limit);
+    tryAssign(kvs, "is_hash_topk", info.is_hash_topk);
     return info;
 }
 }
@@ -50,6 +50,8 @@ struct WindowGroupOptimizationInfo
 {
     String window_function;
     bool is_aggregate_group_limit = false;
+    /// The input is not sorted, the top-K of each partition is kept in a hash table.
+    bool is_hash_topk = false;
     static WindowGroupOptimizationInfo parse(const String & advnace);
 };
 }
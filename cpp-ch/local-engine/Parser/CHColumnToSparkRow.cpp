@@ -17,8 +17,12 @@
 #include "CHColumnToSparkRow.h"
 #include <Columns/ColumnArray.h>
 #include <Columns/ColumnConst.h>
+#include <Columns/ColumnDecimal.h>
+#include <Columns/ColumnFixedString.h>
+#include <Columns/ColumnMap.h>
 #include <Columns/ColumnNullable.h>
 #include <Columns/ColumnString.h>
+#include <Columns/ColumnTuple.h>
 #include <Columns/IColumn.h>
 #include <DataTypes/DataTypeArray.h>
 #include <DataTypes/DataTypeLowCardinality.h>
@@ -28,6 +32,7 @@
 #include <DataTypes/DataTypesDecimal.h>
 #include <jni/jni_common.h>
 #include <Common/Exception.h>
+#include <Common/assert_cast.h>
 
 namespace DB
 {
@@ -79,6 +84,13 @@ ALWAYS_INLINE bool isBitSet(const char * bitmap, size_t index)
     return word & mask;
 }
 
+static const IColumn & skipNullable(const IColumn & column)
+{
+    if (const auto * nullable_column = checkAndGetColumn<ColumnNullable>(&column))
+        return nullable_column->getNestedColumn();
+    return column;
+}
+
 static void writeFixedLengthNonNullableValue(
     char * buffer_address,
     int64_t field_offset,
@@ -188,6 +200,15 @@ static void writeVariableLengthNonNullableValue(
             }
         }
     }
+    else if (BackingDataLengthCalculator::isColumnSupportDirectAccess(col.type, *col.column))
+    {
+        for (size_t i = 0; i < num_rows; i++)
+        {
+            size_t row_idx = masks == nullptr ? i : masks->at(i);
+            int64_t offset_and_size = writer.write(i, *col.column, row_idx, 0);
+            memcpy(buffer_address + offsets[i] + field_offset, &offset_and_size, 8);
+        }
+    }
     else
     {
         Field field;
@@ -243,6 +264,20 @@ static void writeVariableLengthNullableValue(
             }
         }
     }
+    else if (BackingDataLengthCalculator::isColumnSupportDirectAccess(type_without_nullable, nested_column))
+    {
+        for (size_t i = 0; i < num_rows; i++)
+        {
+            size_t row_idx = masks == nullptr ? i : masks->at(i);
+            if (null_map[row_idx])
+                bitSet(buffer_address + offsets[i], col_index);
+            else
+            {
+                int64_t offset_and_size = writer.write(i, nested_column, row_idx, 0);
+                memcpy(buffer_address + offsets[i] + field_offset, &offset_and_size, 8);
+            }
+        }
+    }
     else
     {
         Field field;
@@ -346,11 +381,23 @@ SparkRowInfo::SparkRowInfo(
             else
             {
                 BackingDataLengthCalculator calculator(type_without_nullable);
-                for (size_t i = 0; i < num_rows; ++i)
+                auto column = col.column->convertToFullIfNeeded();
+                if (BackingDataLengthCalculator::isColumnSupportDirectAccess(removeLowCardinality(col.type), *column))
                 {
-                    size_t row_idx = masks == nullptr ? i : masks->at(i);
-                    const auto field = (*col.column)[row_idx];
-                    lengths[i] += calculator.calculate(field);
+                    for (size_t i = 0; i < num_rows; ++i)
+                    {
+                        size_t row_idx = masks == nullptr ? i : masks->at(i);
+                        lengths[i] += calculator.calculate(*column, row_idx);
+                    }
+                }
+                else
+                {
+                    for (size_t i = 0; i < num_rows; ++i)
+                    {
+                        size_t row_idx = masks == nullptr ? i : masks->at(i);
+                        const auto field = (*col.column)[row_idx];
+                        lengths[i] += calculator.calculate(field);
+                    }
                 }
             }
         }
@@ -569,6 +616,132 @@ int64_t BackingDataLengthCalculator::calculate(const Field & field) const
         ErrorCodes::UNKNOWN_TYPE, "Doesn't support type {} for BackingBufferLengthCalculator", type_without_nullable->getName());
 }
 
+/// Backing data length of elements [begin, end) of nested_column written as an UnsafeArrayData
+static int64_t calculateArrayLength(const DataTypePtr & nested_type, const IColumn & nested_column, size_t begin, size_t end)
+{
+    const auto num_elems = end - begin;
+    int64_t res = 8 + calculateBitSetWidthInBytes(num_elems);
+    res += roundNumberOfBytesToNearestWord(BackingDataLengthCalculator::getArrayElementSize(nested_type) * num_elems);
+    if (BackingDataLengthCalculator::isFixedLengthDataType(removeNullable(nested_type)))
+        return res;
+
+    BackingDataLengthCalculator calculator(nested_type);
+    for (size_t i = begin; i < end; ++i)
+        res += calculator.calculate(nested_column, i);
+    return res;
+}
+
+int64_t BackingDataLengthCalculator::calculate(const IColumn & column, size_t row_idx) const
+{
+    if (column.isNullAt(row_idx))
+        return 0;
+
+    if (isFixedLengthDataType(type_without_nullable))
+        return 0;
+
+    const auto & data_column = skipNullable(column);
+    if (which.isStringOrFixedString())
+        return roundNumberOfBytesToNearestWord(data_column.getDataAt(row_idx).size());
+
+    if (which.isDecimal128())
+        return 16;
+
+    if (which.isArray())
+    {
+        const auto & array_column = assert_cast<const ColumnArray &>(data_column);
+        const auto & array_offsets = array_column.getOffsets();
+        const auto * array_type = typeid_cast<const DataTypeArray *>(type_without_nullable.get());
+        return calculateArrayLength(
+            array_type->getNestedType(), array_column.getData(), array_offsets[row_idx - 1], array_offsets[row_idx]);
+    }
+
+    if (which.isMap())
+    {
+        /// Length of UnsafeArrayData of key(8B) |  UnsafeArrayData of key | UnsafeArrayData of value
+        const auto & map_column = assert_cast<const ColumnMap &>(data_column);
+        const auto & map_offsets = map_column.getNestedColumn().getOffsets();
+        const auto & pairs = map_column.getNestedData();
+        const auto * map_type = typeid_cast<const DataTypeMap *>(type_without_nullable.get());
+        const size_t begin = map_offsets[row_idx - 1];
+        const size_t end = map_offsets[row_idx];
+        return 8 + calculateArrayLength(map_type->getKeyType(), pairs.getColumn(0), begin, end)
+            + calculateArrayLength(map_type->getValueType(), pairs.getColumn(1), begin, end);
+    }
+
+    if (which.isTuple())
+    {
+        const auto & tuple_column = assert_cast<const ColumnTuple &>(data_column);
+        const auto * type_tuple = typeid_cast<const DataTypeTuple *>(type_without_nullable.get());
+        const auto & type_fields = type_tuple->getElements();
+        const auto num_fields = type_fields.size();
+        int64_t res = calculateBitSetWidthInBytes(num_fields) + 8 * num_fields;
+        for (size_t i = 0; i < num_fields; ++i)
+        {
+            BackingDataLengthCalculator calculator(type_fields[i]);
+            res += calculator.calculate(tuple_column.getColumn(i), row_idx);
+        }
+        return res;
+    }
+
+    throw Exception(
+        ErrorCodes::UNKNOWN_TYPE, "Doesn't support type {} for BackingBufferLengthCalculator", type_without_nullable->getName());
+}
+
+bool BackingDataLengthCalculator::isColumnSupportDirectAccess(const DataTypePtr & type, const IColumn & column)
+{
+    const auto * nullable_column = checkAndGetColumn<ColumnNullable>(&column);
+    if (type->isNullable() != (nullable_column != nullptr))
+        return false;
+
+    const auto & data_column = nullable_column ? nullable_column->getNestedColumn() : column;
+    const auto type_without_nullable = removeNullable(type);
+    const WhichDataType which(type_without_nullable);
+    if (which.isNothing())
+        return false;
+
+    if (isFixedLengthDataType(type_without_nullable))
+        return data_column.isFixedAndContiguous() && data_column.sizeOfValueIfFixed() == type_without_nullable->getSizeOfValueInMemory();
+
+    if (which.isString())
+        return checkAndGetColumn<ColumnString>(&data_column) != nullptr;
+
+    if (which.isFixedString())
+        return checkAndGetColumn<ColumnFixedString>(&data_column) != nullptr;
+
+    if (which.isDecimal128())
+        return checkAndGetColumn<ColumnDecimal<Decimal128>>(&data_column) != nullptr;
+
+    if (which.isArray())
+    {
+        const auto * array_column = checkAndGetColumn<ColumnArray>(&data_column);
+        const auto * array_type = typeid_cast<const DataTypeArray *>(type_without_nullable.get());
+        return array_column && isColumnSupportDirectAccess(array_type->getNestedType(), array_column->getData());
+    }
+
+    if (which.isMap())
+    {
+        const auto * map_column = checkAndGetColumn<ColumnMap>(&data_column);
+        const auto * map_type = typeid_cast<const DataTypeMap *>(type_without_nullable.get());
+        return map_column && isColumnSupportDirectAccess(map_type->getKeyType(), map_column->getNestedData().getColumn(0))
+            && isColumnSupportDirectAccess(map_type->getValueType(), map_column->getNestedData().getColumn(1));
+    }
+
+    if (which.isTuple())
+    {
+        const auto * tuple_column = checkAndGetColumn<ColumnTuple>(&data_column);
+        const auto * tuple_type = typeid_cast<const DataTypeTuple *>(type_without_nullable.get());
+        const auto & field_types = tuple_type->getElements();
+        if (!tuple_column || tuple_column->tupleSize() != field_types.size())
+            return false;
+        for (size_t i = 0; i < field_types.size(); ++i)
+            if (!isColumnSupportDirectAccess(field_types[i], tuple_column->getColumn(i)))
+                return false;
+        return true;
+    }
+
+    return false;
+}
+
 int64_t BackingDataLengthCalculator::getArrayElementSize(const DataTypePtr & nested_type)
 {
     const WhichDataType nested_which(removeNullable(nested_type));
@@ -615,14 +788,18 @@ bool BackingDataLengthCalculator::isBigEndianInSparkRow(const DB::DataTypePtr &
 void BackingDataLengthCalculator::swapDecimalEndianBytes(String & buf)
 {
     assert(buf.size() == 16);
+    swapDecimalEndianBytes(buf.data());
+}
 
+void BackingDataLengthCalculator::swapDecimalEndianBytes(char * buf)
+{
     using base_type = Decimal128::NativeType::base_type;
-    auto * decimal128 = reinterpret_cast<Decimal128 *>(buf.data());
+    auto * decimal128 = reinterpret_cast<Decimal128 *>(buf);
     for (size_t i = 0; i != std::size(decimal128->value.items); ++i)
         decimal128->value.items[i] = __builtin_bswap64(decimal128->value.items[i]);
 
-    base_type * high = reinterpret_cast<base_type *>(buf.data() + 8);
-    base_type * low = reinterpret_cast<base_type *>(buf.data());
+    base_type * high = reinterpret_cast<base_type *>(buf + 8);
+    base_type * low = reinterpret_cast<base_type *>(buf);
     std::swap(*high, *low);
 }
 
@@ -832,6 +1009,182 @@ int64_t VariableLengthDataWriter::write(size_t row_idx, const DB::Field & field,
     throw Exception(ErrorCodes::UNKNOWN_TYPE, "Doesn't support type {} for BackingDataWriter", type_without_nullable->getName());
 }
 
+int64_t VariableLengthDataWriter::writeArray(
+    size_t row_idx, const DataTypePtr & nested_type, const IColumn & nested_column, size_t begin, size_t end, int64_t parent_offset)
+{
+    /// 内存布局：numElements(8B) | null_bitmap(与numElements成正比) | values(每个值长度与类型有关) | backing data
+    const auto & offset = offsets[row_idx];
+    auto & cursor = buffer_cursor[row_idx];
+    const auto num_elems = end - begin;
+
+    /// Write numElements(8B)
+    const auto start = cursor;
+    memcpy(buffer_address + offset + cursor, &num_elems, 8);
+    cursor += 8;
+    if (num_elems == 0)
+        return BackingDataLengthCalculator::getOffsetAndSize(start - parent_offset, 8);
+
+    /// Skip null_bitmap and values(already reset to zero)
+    const auto len_null_bitmap = calculateBitSetWidthInBytes(num_elems);
+    const auto elem_size = BackingDataLengthCalculator::getArrayElementSize(nested_type);
+    cursor += len_null_bitmap + roundNumberOfBytesToNearestWord(elem_size * num_elems);
+
+    char * null_bitmap = buffer_address + offset + start + 8;
+    char * values = null_bitmap + len_null_bitmap;
+    const auto & data_column = skipNullable(nested_column);
+    const bool nullable = &data_column != &nested_column;
+    if (BackingDataLengthCalculator::isFixedLengthDataType(removeNullable(nested_type)))
+    {
+        /// If nested type is fixed-length data type, update null_bitmap and values in place
+        FixedLengthDataWriter writer(nested_type);
+        if (!nullable && static_cast<int64_t>(data_column.sizeOfValueIfFixed()) == elem_size)
+        {
+            /// Values have the same layout in CH and Spark, copy them at once
+            memcpy(values, data_column.getDataAt(begin).data(), elem_size * num_elems);
+        }
+        else
+        {
+            for (size_t i = 0; i < num_elems; ++i)
+            {
+                if (nested_column.isNullAt(begin + i))
+                    bitSet(null_bitmap, i);
+                else
+                    writer.write(data_column, begin + i, values + i * elem_size);
+            }
+        }
+    }
+    else
+    {
+        /// If nested type is not fixed-length data type, update null_bitmap in place
+        /// And append values in backing data recursively
+        VariableLengthDataWriter writer(nested_type, buffer_address, offsets, buffer_cursor);
+        for (size_t i = 0; i < num_elems; ++i)
+        {
+            if (nested_column.isNullAt(begin + i))
+                bitSet(null_bitmap, i);
+            else
+            {
+                const auto offset_and_size = writer.write(row_idx, data_column, begin + i, start);
+                memcpy(values + i * elem_size, &offset_and_size, 8);
+            }
+        }
+    }
+    return BackingDataLengthCalculator::getOffsetAndSize(start - parent_offset, cursor - start);
+}
+
+int64_t VariableLengthDataWriter::writeMap(size_t row_idx, const ColumnMap & map_column, size_t elem_idx, int64_t parent_offset)
+{
+    /// 内存布局：Length of UnsafeArrayData of key(8B) |  UnsafeArrayData of key | UnsafeArrayData of value
+    const auto & offset = offsets[row_idx];
+    auto & cursor = buffer_cursor[row_idx];
+
+    /// Skip length of UnsafeArrayData of key(8B)
+    const auto start = cursor;
+    cursor += 8;
+
+    const auto & map_offsets = map_column.getNestedColumn().getOffsets();
+    const size_t begin = map_offsets[elem_idx - 1];
+    const size_t end = map_offsets[elem_idx];
+    const auto & pairs = map_column.getNestedData();
+    const auto * map_type = typeid_cast<const DB::DataTypeMap *>(type_without_nullable.get());
+
+    /// Append UnsafeArrayData of key
+    const auto key_array_size = BackingDataLengthCalculator::extractSize(
+        writeArray(row_idx, map_type->getKeyType(), pairs.getColumn(0), begin, end, start + 8));
+
+    /// Fill length of UnsafeArrayData of key
+    memcpy(buffer_address + offset + start, &key_array_size, 8);
+
+    /// Append UnsafeArrayData of value
+    writeArray(row_idx, map_type->getValueType(), pairs.getColumn(1), begin, end, start + 8 + key_array_size);
+    return BackingDataLengthCalculator::getOffsetAndSize(start - parent_offset, cursor - start);
+}
+
+int64_t VariableLengthDataWriter::writeStruct(size_t row_idx, const ColumnTuple & tuple_column, size_t elem_idx, int64_t parent_offset)
+{
+    /// 内存布局：null_bitmap(字节数与字段数成正比) | values(num_fields * 8B) | backing data
+    const auto & offset = offsets[row_idx];
+    auto & cursor = buffer_cursor[row_idx];
+    const auto start = cursor;
+
+    const auto * tuple_type = typeid_cast<const DataTypeTuple *>(type_without_nullable.get());
+    const auto & field_types = tuple_type->getElements();
+    const auto num_fields = field_types.size();
+    if (num_fields == 0)
+        return BackingDataLengthCalculator::getOffsetAndSize(start - parent_offset, 0);
+    const auto len_null_bitmap = calculateBitSetWidthInBytes(num_fields);
+    cursor += len_null_bitmap + num_fields * 8;
+
+    for (size_t i = 0; i < num_fields; ++i)
+    {
+        const auto & field_column = tuple_column.getColumn(i);
+        const auto & field_type = field_types[i];
+        if (field_column.isNullAt(elem_idx))
+        {
+            bitSet(buffer_address + offset + start, i);
+            continue;
+        }
+
+        if (BackingDataLengthCalculator::isFixedLengthDataType(removeNullable(field_type)))
+        {
+            FixedLengthDataWriter writer(field_type);
+            writer.write(skipNullable(field_column), elem_idx, buffer_address + offset + start + len_null_bitmap + i * 8);
+        }
+        else
+        {
+            VariableLengthDataWriter writer(field_type, buffer_address, offsets, buffer_cursor);
+            const auto offset_and_size = writer.write(row_idx, field_column, elem_idx, start);
+            memcpy(buffer_address + offset + start + len_null_bitmap + 8 * i, &offset_and_size, 8);
+        }
+    }
+    return BackingDataLengthCalculator::getOffsetAndSize(start - parent_offset, cursor - start);
+}
+
+int64_t VariableLengthDataWriter::write(size_t row_idx, const IColumn & column, size_t elem_idx, int64_t parent_offset)
+{
+    assert(row_idx < offsets.size());
+
+    if (column.isNullAt(elem_idx))
+        return 0;
+
+    const auto & data_column = skipNullable(column);
+    if (which.isStringOrFixedString())
+    {
+        const auto str = data_column.getDataAt(elem_idx);
+        return writeUnalignedBytes(row_idx, str.data(), str.size(), parent_offset);
+    }
+
+    if (which.isDecimal128())
+    {
+        char buf[sizeof(Decimal128)];
+        memcpy(buf, data_column.getDataAt(elem_idx).data(), sizeof(Decimal128));
+        BackingDataLengthCalculator::swapDecimalEndianBytes(buf);
+        return writeUnalignedBytes(row_idx, buf, sizeof(Decimal128), parent_offset);
+    }
+
+    if (which.isArray())
+    {
+        const auto & array_column = assert_cast<const ColumnArray &>(data_column);
+        const auto & array_offsets = array_column.getOffsets();
+        const auto * array_type = typeid_cast<const DataTypeArray *>(type_without_nullable.get());
+        return writeArray(
+            row_idx,
+            array_type->getNestedType(),
+            array_column.getData(),
+            array_offsets[elem_idx - 1],
+            array_offsets[elem_idx],
+            parent_offset);
+    }
+
+    if (which.isMap())
+        return writeMap(row_idx, assert_cast<const ColumnMap &>(data_column), elem_idx, parent_offset);
+
+    if (which.isTuple())
+        return writeStruct(row_idx, assert_cast<const ColumnTuple &>(data_column), elem_idx, parent_offset);
+
+    throw Exception(ErrorCodes::UNKNOWN_TYPE, "Doesn't support type {} for BackingDataWriter", type_without_nullable->getName());
+}
+
 int64_t BackingDataLengthCalculator::getOffsetAndSize(int64_t cursor, int64_t size)
 {
     return (cursor << 32) | size;
@@ -935,6 +1288,18 @@ void FixedLengthDataWriter::write(const DB::Field & field, char * buffer)
         throw Exception(ErrorCodes::UNKNOWN_TYPE, "FixedLengthDataWriter doesn't support type {}", type_without_nullable->getName());
 }
 
+void FixedLengthDataWriter::write(const IColumn & column, size_t row_idx, char * buffer)
+{
+    if (which.isDecimal32())
+    {
+        /// Decimal32 is stored as 8 bytes in Spark Row
+        const Int64 decimal = assert_cast<const ColumnDecimal<Decimal32> &>(column).getElement(row_idx).value;
+        memcpy(buffer, &decimal, 8);
+    }
+    else
+        unsafeWrite(column.getDataAt(row_idx), buffer);
+}
+
 void FixedLengthDataWriter::unsafeWrite(const std::string_view & str, char * buffer)
 {
     memcpy(buffer, str.data(), str.size());
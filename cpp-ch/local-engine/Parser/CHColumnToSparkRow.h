@@ -23,6 +23,12 @@
 #include <Common/Allocator.h>
 #include <Common/Arena.h>
 
+namespace DB
+{
+class ColumnMap;
+class ColumnTuple;
+}
+
 namespace local_engine
 {
 int64_t calculateBitSetWidthInBytes(int64_t num_fields);
@@ -105,6 +111,10 @@ public:
     /// Return length is guaranteed to round up to 8
     virtual int64_t calculate(const DB::Field & field) const;
 
+    /// Same as calculate(const DB::Field &) for the value at row_idx, read from the column without materializing a Field.
+    /// The column must pass isColumnSupportDirectAccess.
+    int64_t calculate(const DB::IColumn & column, size_t row_idx) const;
+
     static int64_t getArrayElementSize(const DB::DataTypePtr & nested_type);
 
     /// Is CH DataType can be converted to fixed-length data type in Spark?
@@ -116,6 +126,10 @@ public:
     /// If Data Type can use raw data between CH Column and Spark Row if value is not null
     static bool isDataTypeSupportRawData(const DB::DataTypePtr & type_without_nullable);
 
+    /// If values of the column can be read directly from ColumnArray/ColumnMap/ColumnTuple offsets and child columns,
+    /// instead of through Fields. False for const, sparse and low cardinality columns at any nesting level.
+    static bool isColumnSupportDirectAccess(const DB::DataTypePtr & type, const DB::IColumn & column);
+
     /// If bytes in Spark Row is big-endian. If true, we have to transform them to little-endian afterwords
     static bool isBigEndianInSparkRow(const DB::DataTypePtr & type_without_nullable);
 
@@ -123,6 +137,7 @@ public:
     /// Note: Spark unsafeRow biginteger is big-endian.
     ///       CH Int128 is little-endian, is same as system(std::endian::native).
     static void swapDecimalEndianBytes(String & buf);
+    static void swapDecimalEndianBytes(char * buf);
 
     static int64_t getOffsetAndSize(int64_t cursor, int64_t size);
     static int64_t extractOffset(int64_t offset_and_size);
@@ -153,6 +168,10 @@ public:
     /// parent_offset: the starting offset of current structure in which we are updating it's backing data region
     virtual int64_t write(size_t row_idx, const DB::Field & field, int64_t parent_offset);
 
+    /// Same as write(row_idx, field, parent_offset) for the value at elem_idx of column, which must pass
+    /// BackingDataLengthCalculator::isColumnSupportDirectAccess. Nested values are written from child columns directly.
+    int64_t write(size_t row_idx, const DB::IColumn & column, size_t elem_idx, int64_t parent_offset);
+
     /// Only support String/FixedString/Decimal128
     int64_t writeUnalignedBytes(size_t row_idx, const char * src, size_t size, int64_t parent_offset);
 
@@ -161,6 +180,17 @@ private:
     int64_t writeMap(size_t row_idx, const DB::Map & map, int64_t parent_offset);
     int64_t writeStruct(size_t row_idx, const DB::Tuple & tuple, int64_t parent_offset);
 
+    /// Write elements [begin, end) of nested_column as an UnsafeArrayData
+    int64_t writeArray(
+        size_t row_idx,
+        const DB::DataTypePtr & nested_type,
+        const DB::IColumn & nested_column,
+        size_t begin,
+        size_t end,
+        int64_t parent_offset);
+    int64_t writeMap(size_t row_idx, const DB::ColumnMap & map_column, size_t elem_idx, int64_t parent_offset);
+    int64_t writeStruct(size_t row_idx, const DB::ColumnTuple & tuple_column, size_t elem_idx, int64_t parent_offset);
+
     // const DB::DataTypePtr type;
     const DB::DataTypePtr type_without_nullable;
     const DB::WhichDataType which;
@@ -183,6 +213,9 @@ public:
     /// It's caller's duty to make sure that struct fields or array elements are written in order
     virtual void write(const DB::Field & field, char * buffer);
 
+    /// Write non-null value at row_idx of column, which must not be Nullable
+    void write(const DB::IColumn & column, size_t row_idx, char * buffer);
+
     /// Copy memory chunk of Fixed length typed CH Column directory to buffer for performance.
     /// It is unsafe unless you know what you are doing.
     virtual void unsafeWrite(const std::string_view & str, char * buffer);
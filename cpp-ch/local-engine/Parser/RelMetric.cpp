@@ -16,6 +16,7 @@
  */
 #include "RelMetric.h"
 
+#include <Operator/StreamingAggregatingStep.h>
 #include <Processors/IProcessor.h>
 #include <Processors/QueryPlan/AggregatingStep.h>
 #include <Processors/QueryPlan/ReadFromMergeTree.h>
@@ -45,6 +46,7 @@ extern const Event CachedReadBufferReadFromCacheMisses;
 
 extern const Event ParquetMetadataCacheHits;
 extern const Event ParquetMetadataCacheMisses;
+extern const Event ParquetPrunedRowGroups;
 }
 
 namespace local_engine
@@ -175,6 +177,11 @@ void RelMetric::serialize(Writer<StringBuffer> & writer, bool) const
                 writer.Uint64(processor->getProcessorDataStats().input_rows);
                 writer.Key("input_bytes");
                 writer.Uint64(processor->getProcessorDataStats().input_bytes);
+                if (const auto * streaming_aggregating = dynamic_cast<const StreamingAggregatingTransform *>(processor.get()))
+                {
+                    writer.Key("bypassed_rows");
+                    writer.Uint64(streaming_aggregating->getBypassedRows());
+                }
                 writer.EndObject();
             }
             writer.EndArray();
@@ -195,6 +202,9 @@ void RelMetric::serialize(Writer<StringBuffer> & writer, bool) const
             else if (dynamic_cast<SubstraitFileSourceStep *>(step))
             {
                 writeCacheHits(writer);
+                writer.Key("parquet_pruned_row_groups");
+                writer.Uint64(
+                    QueryContext::currentThreadGroup()->performance_counters[ProfileEvents::ParquetPrunedRowGroups].load());
             }
 
             writer.EndObject();
@@ -33,6 +33,7 @@
 #include <Interpreters/WindowDescription.h>
 #include <Operator/BranchStep.h>
 #include <Operator/GraceMergingAggregatedStep.h>
+#include <Operator/HashWindowGroupLimitStep.h>
 #include <Operator/WindowGroupLimitStep.h>
 #include <Parser/AdvancedParametersParseUtil.h>
 #include <Parser/RelParsers/SortParsingUtils.h>
@@ -144,6 +145,18 @@ WindowGroupLimitRelParser::parse(DB::QueryPlanPtr current_plan_, const substrait
     auto sort_fields = parseSortFields(win_rel_def.sorts());
     size_t limit = static_cast<size_t>(win_rel_def.limit());
 
+    if (optimization_info.is_hash_topk)
+    {
+        // The input is not sorted, keep the top rows of each partition in a hash table.
+        auto sort_description = parseSortFields(*current_plan->getCurrentHeader(), win_rel_def.sorts());
+        auto hash_group_limit_step = std::make_unique<HashWindowGroupLimitStep>(
+            getContext(), current_plan->getCurrentHeader(), window_function_name, partition_fields, sort_description, limit);
+        hash_group_limit_step->setStepDescription("Hash window group limit");
+        steps.emplace_back(hash_group_limit_step.get());
+        current_plan->addStep(std::move(hash_group_limit_step));
+        return std::move(current_plan);
+    }
+
     auto window_group_limit_step = std::make_unique<WindowGroupLimitStep>(
         current_plan->getCurrentHeader(), window_function_name, partition_fields, sort_fields, limit);
     window_group_limit_step->setStepDescription("Window group limit");
@@ -141,7 +141,7 @@ size_t LocalPartitionWriter::evictPartitions()
         auto file = getNextSpillFile();
         WriteBufferFromFile output(file, options.io_buffer_size);
         auto codec = DB::CompressionCodecFactory::instance().get(boost::to_upper_copy(options.compress_method), options.compress_level);
-        CompressedWriteBuffer compressed_output(output, codec, options.io_buffer_size);
+        CompressedWriteBuffer compressed_output(output, codec, options.io_buffer_size, false, options.compress_threads);
         NativeWriter writer(compressed_output, output_header);
 
         SpillInfo info;
@@ -276,7 +276,7 @@ size_t MemorySortLocalPartitionWriter::evictPartitions()
         auto file = getNextSpillFile();
         WriteBufferFromFile output(file, options.io_buffer_size);
         auto codec = DB::CompressionCodecFactory::instance().get(boost::to_upper_copy(options.compress_method), options.compress_level);
-        CompressedWriteBuffer compressed_output(output, codec, options.io_buffer_size);
+        CompressedWriteBuffer compressed_output(output, codec, options.io_buffer_size, false, options.compress_threads);
         NativeWriter writer(compressed_output, output_header);
 
         SpillInfo info;
@@ -373,7 +373,7 @@ size_t MemorySortCelebornPartitionWriter::evictPartitions()
 
         WriteBufferFromOwnString output;
         auto codec = DB::CompressionCodecFactory::instance().get(boost::to_upper_copy(options.compress_method), options.compress_level);
-        CompressedWriteBuffer compressed_output(output, codec, options.io_buffer_size);
+        CompressedWriteBuffer compressed_output(output, codec, options.io_buffer_size, false, options.compress_threads);
         NativeWriter writer(compressed_output, output_header);
 
         MergeSorter sorter(toShared(sort_header), std::move(accumulated_blocks), sort_description, adaptiveBlockSize(), 0);
@@ -483,7 +483,7 @@ size_t CelebornPartitionWriter::evictSinglePartition(size_t partition_id)
 
         WriteBufferFromOwnString output;
         auto codec = DB::CompressionCodecFactory::instance().get(boost::to_upper_copy(options.compress_method), options.compress_level);
-        CompressedWriteBuffer compressed_output(output, codec, options.io_buffer_size);
+        CompressedWriteBuffer compressed_output(output, codec, options.io_buffer_size, false, options.compress_threads);
         NativeWriter writer(compressed_output, output_header);
 
         spilled_bytes += buffer->bytes();
@@ -45,6 +45,8 @@ struct SplitOptions
     std::string out_exprs;
     std::string compress_method = "zstd";
     std::optional<int> compress_level;
+    /// Threads compressing shuffle blocks of one writer, 0 compresses inline. See CompressedWriteBuffer.
+    size_t compress_threads = 0;
     size_t spill_threshold = 300 * 1024 * 1024;
     std::string hash_algorithm;
     size_t max_sort_buffer_size = 1_GiB;
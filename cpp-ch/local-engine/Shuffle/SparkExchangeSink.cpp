@@ -300,7 +300,7 @@ std::vector<UInt64> SparkExchangeManager::mergeSpills(DB::WriteBuffer & data_fil
     if (sinks.empty()) return {};
     auto codec = DB::CompressionCodecFactory::instance().get(boost::to_upper_copy(options.compress_method), options.compress_level);
 
-    CompressedWriteBuffer compressed_output(data_file, codec, options.io_buffer_size);
+    CompressedWriteBuffer compressed_output(data_file, codec, options.io_buffer_size, false, options.compress_threads);
     NativeWriter writer(compressed_output, sinks.front()->getOutputHeader());
 
     std::vector<UInt64> partition_length(options.partition_num, 0);
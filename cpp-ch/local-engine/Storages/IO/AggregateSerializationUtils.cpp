@@ -49,6 +49,41 @@ bool isFixedSizeAggregateFunction(const DB::AggregateFunctionPtr& function)
     return isFixedSizeStateAggregateFunction(function->getName()) && isFixedSizeArguments(function->getArgumentTypes());
 }
 
+template <size_t state_size>
+static void gatherFixedSizeStates(const ColumnAggregateFunction::Container & states, UInt8 * to)
+{
+    for (const auto * place : states)
+    {
+        memcpy(to, place, state_size);
+        to += state_size;
+    }
+}
+
+static void gatherFixedSizeStates(const ColumnAggregateFunction::Container & states, UInt8 * to, size_t state_size)
+{
+    /// The common states (count, sum, min/max and avg of numbers and decimals) are a few words each, a copy of a constant
+    /// size compiles to plain moves instead of a memcpy call per row.
+    switch (state_size)
+    {
+        case 8:
+            return gatherFixedSizeStates<8>(states, to);
+        case 16:
+            return gatherFixedSizeStates<16>(states, to);
+        case 24:
+            return gatherFixedSizeStates<24>(states, to);
+        case 32:
+            return gatherFixedSizeStates<32>(states, to);
+        case 48:
+            return gatherFixedSizeStates<48>(states, to);
+        default:
+            for (const auto * place : states)
+            {
+                memcpy(to, place, state_size);
+                to += state_size;
+            }
+    }
+}
+
 DB::ColumnWithTypeAndName convertAggregateStateToFixedString(const DB::ColumnWithTypeAndName& col)
 {
     const auto *aggregate_col = checkAndGetColumn<ColumnAggregateFunction>(&*col.column);
@@ -65,12 +100,31 @@ DB::ColumnWithTypeAndName convertAggregateStateToFixedString(const DB::ColumnWit
     auto res_type = std::make_shared<DataTypeFixedString>(state_size);
     auto res_col = res_type->createColumn();
     PaddedPODArray<UInt8> & column_chars_t = assert_cast<ColumnFixedString &>(*res_col).getChars();
-    column_chars_t.reserve_exact(aggregate_col->size() * state_size);
-    for (const auto & item : aggregate_col->getData())
+    column_chars_t.resize_exact(aggregate_col->size() * state_size);
+    gatherFixedSizeStates(aggregate_col->getData(), column_chars_t.data(), state_size);
+    return DB::ColumnWithTypeAndName(std::move(res_col), res_type, col.name);
+}
+
+char * appendFixedSizeAggregateStates(DB::ColumnAggregateFunction & column, size_t rows)
+{
+    if (!rows)
+        return nullptr;
+
+    const auto & function = column.getAggregateFunction();
+    size_t size_of_state = function->sizeOfData();
+    auto & arena = column.createOrGetArena();
+    /// sizeof is a multiple of alignof, so states allocated back to back stay aligned.
+    char * states = arena.alignedAlloc(rows * size_of_state, function->alignOfData());
+
+    ColumnAggregateFunction::Container & vec = column.getData();
+    vec.reserve_exact(vec.size() + rows);
+    for (size_t i = 0; i < rows; ++i)
     {
-        column_chars_t.insert_assume_reserved(item, item + state_size);
+        AggregateDataPtr place = states + i * size_of_state;
+        function->create(place);
+        vec.push_back(place);
     }
-    return DB::ColumnWithTypeAndName(std::move(res_col), res_type, col.name);
+    return states;
 }
 
 DB::ColumnWithTypeAndName convertAggregateStateToString(const DB::ColumnWithTypeAndName& col)
@@ -98,26 +152,11 @@ DB::ColumnWithTypeAndName convertFixedStringToAggregateState(const DB::ColumnWit
 {
     chassert(WhichDataType(type).isAggregateFunction());
     auto res_col = type->createColumn();
-    const auto * agg_type = checkAndGetDataType<DataTypeAggregateFunction>(type.get());
     ColumnAggregateFunction & real_column = typeid_cast<ColumnAggregateFunction &>(*res_col);
-    auto & arena = real_column.createOrGetArena();
-    ColumnAggregateFunction::Container & vec = real_column.getData();
-    vec.reserve_exact(col.column->size());
-    auto agg_function = agg_type->getFunction();
-    size_t size_of_state = agg_function->sizeOfData();
-    size_t align_of_state = agg_function->alignOfData();
-
-    for (size_t i = 0; i < col.column->size(); ++i)
-    {
-        AggregateDataPtr place = arena.alignedAlloc(size_of_state, align_of_state);
-
-        agg_function->create(place);
-
-        auto value = col.column->getDataAt(i);
-        memcpy(place, value.data(), value.size());
-
-        vec.push_back(place);
-    }
+    auto full_column = col.column->convertToFullColumnIfConst();
+    const auto & chars = assert_cast<const ColumnFixedString &>(*full_column).getChars();
+    if (char * states = appendFixedSizeAggregateStates(real_column, full_column->size()))
+        memcpy(states, chars.data(), chars.size());
     return DB::ColumnWithTypeAndName(std::move(res_col), type, col.name);
 }
 
@@ -19,6 +19,11 @@
 #include <Core/Block.h>
 #include <DataTypes/IDataType.h>
 
+namespace DB
+{
+class ColumnAggregateFunction;
+}
+
 namespace local_engine {
 
 bool isFixedSizeAggregateFunction(const DB::AggregateFunctionPtr & function);
@@ -29,6 +34,11 @@ DB::ColumnWithTypeAndName convertAggregateStateToFixedString(const DB::ColumnWit
 
 DB::ColumnWithTypeAndName convertAggregateStateToString(const DB::ColumnWithTypeAndName & col);
 
+/// Appends `rows` newly created states of a fixed-size aggregate function to the column and returns their memory, null
+/// if there are no rows. The states are allocated back to back in the column's arena, which is exactly the layout of
+/// the fixed-size serialization, so the serialized states are copied or read over all of them at once.
+char * appendFixedSizeAggregateStates(DB::ColumnAggregateFunction & column, size_t rows);
+
 DB::ColumnWithTypeAndName convertFixedStringToAggregateState(const DB::ColumnWithTypeAndName & col, const DB::DataTypePtr & type);
 
 }
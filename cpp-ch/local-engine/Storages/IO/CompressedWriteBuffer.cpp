@@ -24,7 +24,10 @@
 #include <IO/WriteHelpers.h>
 
 #include <Compression/CompressionFactory.h>
+#include <base/scope_guard.h>
+#include <Common/LocalThreadPools.h>
 #include <Common/Stopwatch.h>
+#include <Common/ThreadPool.h>
 #include "CompressedWriteBuffer.h"
 
 using namespace DB;
@@ -37,6 +40,12 @@ void CompressedWriteBuffer::nextImpl()
     if (!offset())
         return;
 
+    if (compress_threads)
+    {
+        submitBlock();
+        return;
+    }
+
     chassert(offset() <= INT_MAX);
     UInt32 decompressed_size = static_cast<UInt32>(offset());
     UInt32 compressed_reserve_size = codec->getCompressedReserveSize(decompressed_size);
@@ -86,13 +95,101 @@ void CompressedWriteBuffer::nextImpl()
     }
 }
 
+void CompressedWriteBuffer::submitBlock()
+{
+    if (blocks.empty())
+        blocks.resize(compress_threads * 2);
+
+    if (num_pending == blocks.size())
+        writeOldestBlock();
+
+    auto & block = blocks[(first_pending + num_pending) % blocks.size()];
+    chassert(offset() <= INT_MAX);
+    block.decompressed_size = static_cast<UInt32>(offset());
+    /// Allocate in the task thread, so that the memory is tracked by the task and the workers only compress.
+    block.compressed.resize_exact(codec->getCompressedReserveSize(block.decompressed_size));
+
+    /// Hand the filled buffer over to the block and continue writing into the buffer it held before.
+    memory.swap(block.data);
+    if (memory.size() < block.data.size())
+        memory.resize(block.data.size());
+    set(memory.data(), memory.size());
+
+    auto task = std::make_shared<std::packaged_task<void()>>([this, &block] { compressBlock(block); });
+    block.done = task->get_future();
+    LocalThreadPools::shuffleCompress().scheduleOrThrow([task] { (*task)(); });
+    ++num_pending;
+}
+
+void CompressedWriteBuffer::compressBlock(PendingBlock & block) const
+{
+    Stopwatch compress_time_watch;
+    block.compressed_size = codec->compress(block.data.data(), block.decompressed_size, block.compressed.data());
+    block.compress_time = compress_time_watch.elapsedNanoseconds();
+    CityHash_v1_0_2::uint128 checksum_(0, 0);
+    if (checksum)
+        checksum_ = CityHash_v1_0_2::CityHash128(block.compressed.data(), block.compressed_size);
+    block.checksum_low = checksum_.low64;
+    block.checksum_high = checksum_.high64;
+}
+
+void CompressedWriteBuffer::writeOldestBlock()
+{
+    auto & block = blocks[first_pending];
+    first_pending = (first_pending + 1) % blocks.size();
+    --num_pending;
+
+    /// Rethrows the exception of the worker, if any.
+    block.done.get();
+    compress_time += block.compress_time;
+
+    writeBinaryLittleEndian(block.checksum_low, out);
+    writeBinaryLittleEndian(block.checksum_high, out);
+    Stopwatch write_time_watch;
+    out.write(block.compressed.data(), block.compressed_size);
+    write_time += write_time_watch.elapsedNanoseconds();
+}
+
+void CompressedWriteBuffer::writePendingBlocks()
+{
+    while (num_pending)
+        writeOldestBlock();
+}
+
+void CompressedWriteBuffer::waitPendingBlocks()
+{
+    for (; num_pending; --num_pending)
+    {
+        blocks[first_pending].done.wait();
+        first_pending = (first_pending + 1) % blocks.size();
+    }
+}
+
+void CompressedWriteBuffer::sync()
+{
+    next();
+    writePendingBlocks();
+}
+
+void CompressedWriteBuffer::finalizeImpl()
+{
+    next();
+    writePendingBlocks();
+}
+
 CompressedWriteBuffer::~CompressedWriteBuffer()
 {
+    SCOPE_EXIT({ waitPendingBlocks(); });
     finalize();
 }
 
-CompressedWriteBuffer::CompressedWriteBuffer(WriteBuffer & out_, CompressionCodecPtr codec_, size_t buf_size, bool checksum_)
-    : BufferWithOwnMemory<WriteBuffer>(buf_size), out(out_), codec(std::move(codec_)), checksum(checksum_)
+CompressedWriteBuffer::CompressedWriteBuffer(
+    WriteBuffer & out_, CompressionCodecPtr codec_, size_t buf_size, bool checksum_, size_t compress_threads_)
+    : BufferWithOwnMemory<WriteBuffer>(buf_size)
+    , out(out_)
+    , codec(std::move(codec_))
+    , checksum(checksum_)
+    , compress_threads(compress_threads_)
 {
 }
 
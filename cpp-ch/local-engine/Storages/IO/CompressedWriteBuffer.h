@@ -16,7 +16,9 @@
  */
 #pragma once
 
+#include <future>
 #include <memory>
+#include <vector>
 
 #include <Common/PODArray.h>
 
@@ -29,6 +31,12 @@
 namespace local_engine
 {
 
+/// Writes blocks of compressed data, each prefixed with a 16-byte checksum (zeros if checksum is disabled).
+///
+/// With compress_threads > 0 the buffer runs in pipelined mode: every filled buffer is compressed on the process-wide
+/// LocalThreadPools::shuffleCompress() pool and the caller keeps writing into a spare buffer. Up to 2 * compress_threads
+/// blocks are in flight and they are written to `out` in the order they were filled, so the output is identical to the inline mode.
+/// sync() and finalize() wait for all pending blocks, so out.count() is exact after them.
 class CompressedWriteBuffer final : public DB::BufferWithOwnMemory<DB::WriteBuffer>
 {
 public:
@@ -36,14 +44,18 @@ public:
         DB::WriteBuffer & out_,
         DB::CompressionCodecPtr codec_ = DB::CompressionCodecFactory::instance().getDefaultCodec(),
         size_t buf_size = DB::DBMS_DEFAULT_BUFFER_SIZE,
-        bool checksum = false);
+        bool checksum = false,
+        size_t compress_threads = 0);
 
     ~CompressedWriteBuffer() override;
 
+    void sync() override;
+
     /// The amount of compressed data
     size_t getCompressedBytes()
     {
         nextIfAtEnd();
+        writePendingBlocks();
         return out.count();
     }
 
@@ -60,6 +72,7 @@ public:
         return offset();
     }
 
+    /// In pipelined mode, the sum of the compression time of all workers.
     size_t getCompressTime() const
     {
         return compress_time;
@@ -71,7 +84,29 @@ public:
     }
 
 private:
+    /// A block compressed by a worker in pipelined mode.
+    struct PendingBlock
+    {
+        DB::Memory<> data;
+        UInt32 decompressed_size = 0;
+        DB::PODArray<char> compressed;
+        UInt32 compressed_size = 0;
+        UInt64 checksum_low = 0;
+        UInt64 checksum_high = 0;
+        size_t compress_time = 0;
+        std::future<void> done;
+    };
+
     void nextImpl() override;
+    void finalizeImpl() override;
+
+    void submitBlock();
+    void compressBlock(PendingBlock & block) const;
+    /// Waits for the oldest pending block and writes it to out.
+    void writeOldestBlock();
+    void writePendingBlocks();
+    /// Waits for the workers without writing, the jobs reference the blocks.
+    void waitPendingBlocks();
 
     WriteBuffer & out;
     DB::CompressionCodecPtr codec;
@@ -80,6 +115,12 @@ private:
     bool checksum;
     size_t compress_time = 0;
     size_t write_time = 0;
+
+    size_t compress_threads;
+    /// Ring of blocks, the pending ones start at first_pending.
+    std::vector<PendingBlock> blocks;
+    size_t first_pending = 0;
+    size_t num_pending = 0;
 };
 
 }
@@ -85,22 +85,13 @@ DB::Block NativeReader::read()
     return result_block;
 }
 
+/// The states are read straight from the stream into their place in the arena, without going through a FixedString column.
 static void
 readFixedSizeAggregateData(DB::ReadBuffer & in, DB::ColumnPtr & column, size_t rows, NativeReader::ColumnParseUtil & column_parse_util)
 {
     ColumnAggregateFunction & real_column = typeid_cast<ColumnAggregateFunction &>(*column->assumeMutable());
-    auto & arena = real_column.createOrGetArena();
-    ColumnAggregateFunction::Container & vec = real_column.getData();
-    size_t initial_size = vec.size();
-    vec.reserve_exact(initial_size + rows);
-    for (size_t i = 0; i < rows; ++i)
-    {
-        AggregateDataPtr place = arena.alignedAlloc(column_parse_util.aggregate_state_size, column_parse_util.aggregate_state_align);
-        column_parse_util.aggregate_function->create(place);
-        auto n = in.read(place, column_parse_util.aggregate_state_size);
-        chassert(n == column_parse_util.aggregate_state_size);
-        vec.push_back(place);
-    }
+    if (char * states = appendFixedSizeAggregateStates(real_column, rows))
+        in.readStrict(states, rows * column_parse_util.aggregate_state_size);
 }
 
 static void
@@ -313,8 +304,9 @@ int ReadBufferFromJavaInputStream::readFromJava() const
     return count;
 }
 
+/// The byte array holds up to buffer_size bytes, so the own memory must be at least as large.
 ReadBufferFromJavaInputStream::ReadBufferFromJavaInputStream(jobject input_stream_, jbyteArray buffer_, const size_t buffer_size_)
-    : input_stream(input_stream_), buffer(buffer_), buffer_size(buffer_size_)
+    : DB::BufferWithOwnMemory<DB::ReadBuffer>(buffer_size_), input_stream(input_stream_), buffer_size(buffer_size_), buffer(buffer_)
 {
 }
 
@@ -18,6 +18,7 @@
 #include <IO/WriteBuffer.h>
 #include <IO/WriteHelpers.h>
 #include <DataTypes/Serializations/ISerialization.h>
+#include <Columns/ColumnAggregateFunction.h>
 #include <Columns/ColumnSparse.h>
 #include <Columns/ColumnString.h>
 #include <Storages/IO/AggregateSerializationUtils.h>
@@ -77,8 +78,13 @@ size_t NativeWriter::write(const DB::Block & block)
         original_type = recursiveRemoveLowCardinality(original_type);
         /// Type
         String type_name = original_type->getName();
+        /// Fixed-size states that were not converted are written in the same layout straight from the arena.
+        const auto * fixed_size_agg_col = checkAndGetColumn<ColumnAggregateFunction>(column.column.get());
+        if (fixed_size_agg_col && !isFixedSizeAggregateFunction(fixed_size_agg_col->getAggregateFunction()))
+            fixed_size_agg_col = nullptr;
         bool is_agg_opt = WhichDataType(original_type).isAggregateFunction()
-            && header.safeGetByPosition(i).column->getDataType() != block.safeGetByPosition(i).column->getDataType();
+            && (fixed_size_agg_col
+                || header.safeGetByPosition(i).column->getDataType() != block.safeGetByPosition(i).column->getDataType());
         if (is_agg_opt)
         {
             writeStringBinary(type_name + AGG_STATE_SUFFIX, ostr);
@@ -95,7 +101,13 @@ size_t NativeWriter::write(const DB::Block & block)
         if (rows)    /// Zero items of data is always represented as zero number of bytes.
         {
             const auto * agg_type = checkAndGetDataType<DataTypeAggregateFunction>(original_type.get());
-            if (is_agg_opt && agg_type && !isFixedSizeAggregateFunction(agg_type->getFunction()))
+            if (fixed_size_agg_col)
+            {
+                size_t state_size = fixed_size_agg_col->getAggregateFunction()->sizeOfData();
+                for (const auto * place : fixed_size_agg_col->getData())
+                    ostr.write(place, state_size);
+            }
+            else if (is_agg_opt && agg_type && !isFixedSizeAggregateFunction(agg_type->getFunction()))
             {
                 const auto * str_col = static_cast<const ColumnString *>(column.column.get());
                 const PaddedPODArray<UInt8> & column_chars = str_col->getChars();
@@ -29,6 +29,9 @@ class CompressedWriteBuffer;
 namespace local_engine
 {
 
+/// Writes blocks in ClickHouse's Native format, except for aggregate states. Aggregate function columns converted to
+/// FixedString, and fixed-size states that were not converted, are written as raw states under the type name with
+/// AGG_STATE_SUFFIX appended. Only local_engine::NativeReader reads such blocks back.
 class NativeWriter
 {
 public:
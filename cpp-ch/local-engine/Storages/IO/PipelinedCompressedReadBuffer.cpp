@@ -0,0 +1,130 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <city.h>
+#include <cstring>
+
+#include <base/types.h>
+#include <base/unaligned.h>
+
+#include <Compression/CompressionFactory.h>
+#include <Core/Defines.h>
+#include <Compression/CompressionInfo.h>
+#include <Common/Exception.h>
+#include <Common/LocalThreadPools.h>
+#include <Common/Stopwatch.h>
+#include <Common/ThreadPool.h>
+#include "PipelinedCompressedReadBuffer.h"
+
+namespace DB::ErrorCodes
+{
+extern const int CORRUPTED_DATA;
+extern const int TOO_LARGE_SIZE_COMPRESSED;
+}
+
+using namespace DB;
+
+namespace local_engine
+{
+
+bool PipelinedCompressedReadBuffer::nextImpl()
+{
+    /// One more than the blocks in flight, for the block being read.
+    if (blocks.empty())
+        blocks.resize(decompress_threads * 2 + 1);
+
+    /// The block before first_pending has been read, its slot can be refilled.
+    while (!in_finished && num_pending + 1 < blocks.size())
+        in_finished = !submitBlock();
+
+    if (!num_pending)
+        return false;
+
+    auto & block = blocks[first_pending];
+    first_pending = (first_pending + 1) % blocks.size();
+    --num_pending;
+
+    /// Rethrows the exception of the worker, if any.
+    block.done.get();
+    decompress_time += block.decompress_time;
+    working_buffer = Buffer(block.decompressed.data(), block.decompressed.data() + block.decompressed_size);
+    return true;
+}
+
+bool PipelinedCompressedReadBuffer::submitBlock()
+{
+    if (in.eof())
+        return false;
+
+    auto & block = blocks[(first_pending + num_pending) % blocks.size()];
+
+    in.ignore(sizeof(CityHash_v1_0_2::uint128));
+    constexpr size_t header_size = COMPRESSED_BLOCK_HEADER_SIZE;
+    char header[header_size];
+    in.readStrict(header, header_size);
+    const UInt8 method = static_cast<UInt8>(header[0]);
+    const UInt32 compressed_size = unalignedLoadLittleEndian<UInt32>(&header[1]);
+    const UInt32 decompressed_size = unalignedLoadLittleEndian<UInt32>(&header[5]);
+    if (compressed_size < header_size)
+        throw Exception(ErrorCodes::CORRUPTED_DATA, "Too small size_compressed_without_checksum {}", compressed_size);
+    /// Both sizes allocate buffers, don't trust a corrupted header with gigabytes.
+    if (compressed_size > DBMS_MAX_COMPRESSED_SIZE)
+        throw Exception(
+            ErrorCodes::TOO_LARGE_SIZE_COMPRESSED,
+            "Too large size_compressed_without_checksum: {}. Most likely corrupted data.",
+            compressed_size);
+    if (decompressed_size > DBMS_MAX_COMPRESSED_SIZE)
+        throw Exception(
+            ErrorCodes::TOO_LARGE_SIZE_COMPRESSED, "Too large size_decompressed: {}. Most likely corrupted data.", decompressed_size);
+
+    /// Allocate in the task thread, so that the memory is tracked by the task and the workers only decompress.
+    block.compressed.resize_exact(compressed_size);
+    memcpy(block.compressed.data(), header, header_size);
+    in.readStrict(block.compressed.data() + header_size, compressed_size - header_size);
+    block.codec = CompressionCodecFactory::instance().get(method);
+    block.decompressed_size = decompressed_size;
+    block.decompressed.resize(decompressed_size + block.codec->getAdditionalSizeAtTheEndOfBuffer());
+
+    auto task = std::make_shared<std::packaged_task<void()>>([&block] { decompressBlock(block); });
+    block.done = task->get_future();
+    LocalThreadPools::broadcastDecompress().scheduleOrThrow([task] { (*task)(); });
+    ++num_pending;
+    return true;
+}
+
+void PipelinedCompressedReadBuffer::decompressBlock(PendingBlock & block)
+{
+    Stopwatch decompress_time_watch;
+    block.codec->decompress(block.compressed.data(), static_cast<UInt32>(block.compressed.size()), block.decompressed.data());
+    block.decompress_time = decompress_time_watch.elapsedNanoseconds();
+}
+
+PipelinedCompressedReadBuffer::~PipelinedCompressedReadBuffer()
+{
+    /// Blocks read ahead may still be decompressed.
+    for (auto & block : blocks)
+        if (block.done.valid())
+            block.done.wait();
+}
+
+PipelinedCompressedReadBuffer::PipelinedCompressedReadBuffer(ReadBuffer & in_, size_t decompress_threads_)
+    : ReadBuffer(nullptr, 0)
+    , in(in_)
+    , decompress_threads(std::max<size_t>(decompress_threads_, 1))
+{
+}
+
+}
@@ -0,0 +1,80 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <future>
+#include <memory>
+#include <vector>
+
+#include <Common/PODArray.h>
+
+#include <IO/BufferWithOwnMemory.h>
+#include <IO/ReadBuffer.h>
+#include <Compression/ICompressionCodec.h>
+
+
+namespace local_engine
+{
+
+/// Reads the blocks written by CompressedWriteBuffer and decompresses them on LocalThreadPools::broadcastDecompress().
+///
+/// Up to 2 * decompress_threads blocks are read ahead from `in` and decompressed concurrently, the reader gets them in
+/// the order they were written, so it sees the same bytes as with DB::CompressedReadBuffer. Checksums are not verified.
+class PipelinedCompressedReadBuffer final : public DB::ReadBuffer
+{
+public:
+    PipelinedCompressedReadBuffer(DB::ReadBuffer & in_, size_t decompress_threads_);
+
+    ~PipelinedCompressedReadBuffer() override;
+
+    /// The sum of the decompression time of all workers, of the blocks handed out so far.
+    size_t getDecompressTime() const
+    {
+        return decompress_time;
+    }
+
+private:
+    /// A block read from `in`, decompressed by a worker.
+    struct PendingBlock
+    {
+        DB::PODArray<char> compressed;
+        DB::Memory<> decompressed;
+        UInt32 decompressed_size = 0;
+        DB::CompressionCodecPtr codec;
+        size_t decompress_time = 0;
+        std::future<void> done;
+    };
+
+    bool nextImpl() override;
+
+    /// Reads the next block from `in` and hands it to the pool, false at the end of `in`.
+    bool submitBlock();
+    static void decompressBlock(PendingBlock & block);
+
+    DB::ReadBuffer & in;
+    size_t decompress_threads;
+    size_t decompress_time = 0;
+
+    /// Ring of blocks, the pending ones start at first_pending and the one before them is being read.
+    /// The destructor waits for the jobs referencing them.
+    std::vector<PendingBlock> blocks;
+    size_t first_pending = 0;
+    size_t num_pending = 0;
+    bool in_finished = false;
+};
+
+}
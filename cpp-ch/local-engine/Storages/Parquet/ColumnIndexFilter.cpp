@@ -989,5 +989,67 @@ RowRanges ColumnIndexFilter::calculateRowRanges(const ColumnIndexStore & index_s
 
     return rpn_stack[0];
 }
+
+std::unordered_set<std::string> ColumnIndexFilter::bloomFilterColumns() const
+{
+    std::unordered_set<std::string> columns;
+    for (const auto & element : rpn_)
+        if (element.function == DB::GlutenParquetColumnIndexFilter::RPNElement::FUNCTION_EQUALS
+            || element.function == DB::GlutenParquetColumnIndexFilter::RPNElement::FUNCTION_IN)
+            columns.insert(element.columnName);
+    return columns;
+}
+
+bool ColumnIndexFilter::mayMatchBloomFilters(const BloomFilterProbe & probe) const
+{
+    std::vector<bool> rpn_stack;
+
+    auto CALL_LOGICAL_OP = [&rpn_stack](bool is_and)
+    {
+        assert(rpn_stack.size() >= 2);
+        const bool arg1 = rpn_stack.back();
+        rpn_stack.pop_back();
+        rpn_stack.back() = is_and ? (arg1 && rpn_stack.back()) : (arg1 || rpn_stack.back());
+    };
+
+    for (const auto & element : rpn_)
+    {
+        switch (element.function)
+        {
+            case DB::GlutenParquetColumnIndexFilter::RPNElement::FUNCTION_EQUALS:
+                rpn_stack.push_back(probe(element.columnName, element.value).value_or(true));
+                break;
+            case DB::GlutenParquetColumnIndexFilter::RPNElement::FUNCTION_IN: {
+                bool may_match = false;
+                for (size_t i = 0; i < element.column->size() && !may_match; ++i)
+                    may_match = probe(element.columnName, (*element.column)[i]).value_or(true);
+                rpn_stack.push_back(may_match);
+                break;
+            }
+            case DB::GlutenParquetColumnIndexFilter::RPNElement::FUNCTION_NOT:
+                /// A bloom filter can't tell that all rows of a row group match, so the negation may always match.
+                assert(!rpn_stack.empty());
+                rpn_stack.back() = true;
+                break;
+            case DB::GlutenParquetColumnIndexFilter::RPNElement::FUNCTION_AND:
+                CALL_LOGICAL_OP(true);
+                break;
+            case DB::GlutenParquetColumnIndexFilter::RPNElement::FUNCTION_OR:
+                CALL_LOGICAL_OP(false);
+                break;
+            case DB::GlutenParquetColumnIndexFilter::RPNElement::ALWAYS_FALSE:
+                rpn_stack.push_back(false);
+                break;
+            default:
+                rpn_stack.push_back(true);
+                break;
+        }
+    }
+
+    if (rpn_stack.size() != 1)
+        throw DB::Exception(DB::ErrorCodes::LOGICAL_ERROR, "Unexpected stack size in ColumnIndexFilter::mayMatchBloomFilters");
+
+    return rpn_stack[0];
+}
 }
 #endif //USE_PARQUET
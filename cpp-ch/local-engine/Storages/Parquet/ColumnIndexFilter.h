@@ -18,7 +18,10 @@
 #include <config.h>
 
 #if USE_PARQUET
+#include <functional>
 #include <memory>
+#include <optional>
+#include <unordered_set>
 #include <Columns/IColumn.h>
 #include <Core/Field.h>
 #include <Interpreters/ActionsDAG.h>
@@ -37,7 +40,7 @@ namespace local_engine
 {
 class ColumnIndexFilter;
 class ColumnIndex;
-using ColumnIndexPtr = std::unique_ptr<ColumnIndex>;
+using ColumnIndexPtr = std::shared_ptr<ColumnIndex>;
 using PageIndexs = std::vector<Int32>;
 using ColumnIndexStore = std::unordered_map<std::string, ColumnIndexPtr>;
 using ColumnIndexFilterPtr = std::shared_ptr<ColumnIndexFilter>;
@@ -173,6 +176,17 @@ private:
 
 public:
     RowRanges calculateRowRanges(const ColumnIndexStore & index_store, size_t rowgroup_count) const;
+
+    /// Tells whether a row group may hold a value of a column, or nullopt if it can't tell, e.g. when the column has
+    /// no bloom filter.
+    using BloomFilterProbe = std::function<std::optional<bool>(const std::string & column_name, const DB::Field & value)>;
+
+    /// Names of the columns in equality and IN conditions, the only conditions a bloom filter can refute.
+    std::unordered_set<std::string> bloomFilterColumns() const;
+
+    /// Whether a row group may have rows matching the filter, judging the equality and IN conditions by `probe` and
+    /// taking every other condition as satisfiable.
+    bool mayMatchBloomFilters(const BloomFilterProbe & probe) const;
 };
 }
 #endif
@@ -22,10 +22,17 @@
 #include <Processors/Formats/Impl/ArrowBufferedStreams.h>
 #include <Processors/Formats/Impl/ArrowColumnToCHColumn.h>
 #include <Processors/Formats/Impl/ArrowFieldIndexUtil.h>
+#include <IO/SeekableReadBuffer.h>
 #include <Storages/Parquet/ArrowUtils.h>
+#include <Storages/Parquet/ParquetConverter.h>
+#include <arrow/io/memory.h>
 #include <parquet/arrow/reader.h>
 #include <parquet/arrow/schema.h>
+#include <parquet/bloom_filter.h>
+#include <parquet/bloom_filter_reader.h>
 #include <parquet/metadata.h>
+#include <Common/ProfileEvents.h>
+#include <Common/logger_useful.h>
 
 namespace DB
 {
@@ -35,12 +42,18 @@ extern const int BAD_ARGUMENTS;
 }
 }
 
+namespace ProfileEvents
+{
+extern const Event ParquetPrunedRowGroups;
+}
+
 using namespace DB;
 
 namespace local_engine
 {
 
-std::unique_ptr<parquet::ParquetFileReader> ParquetMetaBuilder::openInputParquetFile(ReadBuffer & read_buffer)
+std::unique_ptr<parquet::ParquetFileReader>
+ParquetMetaBuilder::openInputParquetFile(ReadBuffer & read_buffer, const std::shared_ptr<parquet::FileMetaData> & metadata)
 {
     const FormatSettings format_settings{
         .seekable_read = true,
@@ -48,7 +61,29 @@ std::unique_ptr<parquet::ParquetFileReader> ParquetMetaBuilder::openInputParquet
     std::atomic<int> is_stopped{0};
     auto arrow_file = asArrowFile(read_buffer, format_settings, is_stopped, "Parquet", PARQUET_MAGIC_BYTES);
 
-    return parquet::ParquetFileReader::Open(arrow_file, parquet::default_reader_properties(), nullptr);
+    return parquet::ParquetFileReader::Open(arrow_file, parquet::default_reader_properties(), metadata);
+}
+
+std::unique_ptr<parquet::ParquetFileReader> ParquetMetaBuilder::openFile(ReadBuffer & read_buffer)
+{
+    if (!fileKey)
+    {
+        auto reader = openInputParquetFile(read_buffer, nullptr);
+        fileMetaData = reader->metadata();
+        return reader;
+    }
+
+    std::unique_ptr<parquet::ParquetFileReader> reader;
+    fileMetaData = ParquetMetaCache::instance().getOrLoadFileMetaData(
+        *fileKey,
+        [&]
+        {
+            reader = openInputParquetFile(read_buffer, nullptr);
+            return reader->metadata();
+        });
+    if (!reader)
+        reader = openInputParquetFile(read_buffer, fileMetaData);
+    return reader;
 }
 
 Block ParquetMetaBuilder::collectFileSchema(const ContextPtr & context, ReadBuffer & read_buffer)
@@ -83,23 +118,47 @@ std::vector<Int32> ParquetMetaBuilder::pruneColumn(
     return column_indices;
 }
 
+namespace
+{
+/// Approximate memory of a column index: the page locations, and the min/max values both encoded and decoded.
+size_t columnIndexWeight(const parquet::ColumnIndex * column_index, const parquet::OffsetIndex * offset_index)
+{
+    size_t weight = sizeof(ColumnIndex);
+    if (offset_index)
+        weight += offset_index->page_locations().size() * sizeof(parquet::PageLocation);
+    if (column_index)
+    {
+        for (const auto & value : column_index->encoded_min_values())
+            weight += 2 * value.size();
+        for (const auto & value : column_index->encoded_max_values())
+            weight += 2 * value.size();
+        weight += column_index->null_pages().size() + column_index->null_counts().size() * sizeof(int64_t);
+    }
+    return weight;
+}
+}
+
 std::unique_ptr<ColumnIndexStore> ParquetMetaBuilder::collectColumnIndex(
-    const parquet::RowGroupMetaData & rgMeta,
-    parquet::RowGroupPageIndexReader & rowGroupPageIndex,
-    const std::vector<Int32> & column_indices,
-    bool case_insensitive)
+    const parquet::RowGroupMetaData & rgMeta, Int32 row_group_index, parquet::RowGroupPageIndexReader & rowGroupPageIndex) const
 {
     auto result = std::make_unique<ColumnIndexStore>();
     ColumnIndexStore & column_index_store = *result;
-    column_index_store.reserve(column_indices.size());
+    column_index_store.reserve(readColumns.size());
 
-    for (auto const column_index : column_indices)
+    auto & cache = ParquetMetaCache::instance();
+    for (auto const column_index : readColumns)
     {
         const auto * col_desc = rgMeta.schema()->Column(column_index);
-        const auto col_index = rowGroupPageIndex.GetColumnIndex(column_index);
-        const auto offset_index = rowGroupPageIndex.GetOffsetIndex(column_index);
         const std::string columnName = case_insensitive ? boost::to_lower_copy(col_desc->name()) : col_desc->name();
-        column_index_store[columnName] = ColumnIndex::create(col_desc, col_index, offset_index);
+        auto load = [&]
+        {
+            const auto col_index = rowGroupPageIndex.GetColumnIndex(column_index);
+            const auto offset_index = rowGroupPageIndex.GetOffsetIndex(column_index);
+            return std::make_pair(
+                ColumnIndex::create(col_desc, col_index, offset_index), columnIndexWeight(col_index.get(), offset_index.get()));
+        };
+        column_index_store[columnName]
+            = fileKey ? cache.getOrLoadColumnIndex(*fileKey, row_group_index, column_index, fileMetaData, load) : load().first;
     }
     return result;
 }
@@ -162,6 +221,169 @@ ParquetMetaBuilder & ParquetMetaBuilder::buildRequiredRowGroups(
     return *this;
 }
 
+namespace
+{
+/// Hash of `value` in the bloom filter of a column, or nullopt if the value can't be hashed the way the writer did.
+/// Only integers without a logical type other than a signed INT, and strings or binaries, are supported.
+std::optional<UInt64>
+bloomFilterHash(const parquet::BloomFilter & bloom_filter, const parquet::ColumnDescriptor & descr, const Field & value)
+{
+    const auto & logical_type = *descr.logical_type();
+    switch (descr.physical_type())
+    {
+        case parquet::Type::INT32:
+        case parquet::Type::INT64: {
+            const bool signed_int
+                = logical_type.is_int() && static_cast<const parquet::IntLogicalType &>(logical_type).is_signed();
+            if (!logical_type.is_none() && !signed_int)
+                return std::nullopt;
+            Int64 int_value;
+            if (value.getType() == Field::Types::Int64)
+                int_value = value.safeGet<Int64>();
+            else if (value.getType() == Field::Types::UInt64 && value.safeGet<UInt64>() <= std::numeric_limits<Int64>::max())
+                int_value = static_cast<Int64>(value.safeGet<UInt64>());
+            else
+                return std::nullopt;
+
+            if (descr.physical_type() == parquet::Type::INT64)
+                return bloom_filter.Hash(static_cast<int64_t>(int_value));
+            if (int_value < std::numeric_limits<Int32>::min() || int_value > std::numeric_limits<Int32>::max())
+                return std::nullopt;
+            return bloom_filter.Hash(static_cast<int32_t>(int_value));
+        }
+        case parquet::Type::BYTE_ARRAY: {
+            if ((!logical_type.is_none() && !logical_type.is_string()) || value.getType() != Field::Types::String)
+                return std::nullopt;
+            ToParquet<parquet::ByteArrayType> to_parquet;
+            const auto byte_array = to_parquet.as(value, descr);
+            return bloom_filter.Hash(&byte_array);
+        }
+        default:
+            return std::nullopt;
+    }
+}
+}
+
+ParquetMetaBuilder & ParquetMetaBuilder::buildBloomFilterSkip(
+    ReadBuffer & read_buffer,
+    parquet::ParquetFileReader & reader,
+    const parquet::FileMetaData & file_meta,
+    const ColumnIndexFilter * column_index_filter)
+{
+    auto * seekable = dynamic_cast<SeekableReadBuffer *>(&read_buffer);
+    if (!column_index_filter || !seekable || !format_settings.parquet.bloom_filter_push_down || readRowGroups.empty())
+        return *this;
+
+    const auto filter_columns = column_index_filter->bloomFilterColumns();
+    if (filter_columns.empty())
+        return *this;
+
+    /// Only top-level primitive columns, named as in the filter.
+    const auto & schema = *file_meta.schema();
+    std::unordered_map<std::string, Int32> leaf_columns;
+    for (Int32 i = 0; i < schema.num_columns(); ++i)
+    {
+        const auto * col_desc = schema.Column(i);
+        if (col_desc->path()->ToDotVector().size() != 1)
+            continue;
+        std::string name = case_insensitive ? boost::to_lower_copy(col_desc->name()) : col_desc->name();
+        if (filter_columns.contains(name))
+            leaf_columns.emplace(std::move(name), i);
+    }
+    if (leaf_columns.empty())
+        return *this;
+
+    /// Bloom filters of one file are usually written next to each other, so nearby ones are read together in a single
+    /// request instead of a seek and a read each. Filters written without their length are read one by one.
+    struct BloomFilterLocation
+    {
+        size_t row_group_pos;
+        Int32 column;
+        Int64 offset;
+        Int64 length;
+    };
+    std::vector<BloomFilterLocation> locations;
+    std::map<std::pair<size_t, Int32>, std::unique_ptr<parquet::BloomFilter>> bloom_filters;
+    for (size_t pos = 0; pos < readRowGroups.size(); ++pos)
+    {
+        const auto rg_meta = file_meta.RowGroup(readRowGroups[pos].index);
+        for (const auto & [name, column] : leaf_columns)
+        {
+            const auto chunk_meta = rg_meta->ColumnChunk(column);
+            const auto offset = chunk_meta->bloom_filter_offset();
+            if (!offset)
+                continue;
+            if (const auto length = chunk_meta->bloom_filter_length())
+                locations.push_back({pos, column, *offset, *length});
+            else if (auto bloom_filter = reader.GetBloomFilterReader().RowGroup(readRowGroups[pos].index)->GetColumnBloomFilter(column))
+                bloom_filters[{pos, column}] = std::move(bloom_filter);
+        }
+    }
+
+    std::ranges::sort(locations, {}, &BloomFilterLocation::offset);
+    const Int64 max_gap = format_settings.parquet.local_read_min_bytes_for_seek;
+    std::string buffer;
+    for (size_t begin = 0; begin < locations.size();)
+    {
+        const Int64 range_start = locations[begin].offset;
+        Int64 range_end = range_start + locations[begin].length;
+        size_t end = begin + 1;
+        for (; end < locations.size() && locations[end].offset <= range_end + max_gap; ++end)
+            range_end = std::max(range_end, locations[end].offset + locations[end].length);
+
+        buffer.resize(range_end - range_start);
+        seekable->seek(range_start, SEEK_SET);
+        seekable->readStrict(buffer.data(), buffer.size());
+        for (; begin < end; ++begin)
+        {
+            const auto & location = locations[begin];
+            arrow::io::BufferReader stream(
+                reinterpret_cast<const uint8_t *>(buffer.data()) + (location.offset - range_start), location.length);
+            bloom_filters[{location.row_group_pos, location.column}] = std::make_unique<parquet::BlockSplitBloomFilter>(
+                parquet::BlockSplitBloomFilter::Deserialize(parquet::default_reader_properties(), &stream, location.length));
+        }
+    }
+    if (bloom_filters.empty())
+        return *this;
+
+    for (size_t pos = 0; pos < readRowGroups.size(); ++pos)
+    {
+        auto probe = [&](const std::string & column_name, const Field & value) -> std::optional<bool>
+        {
+            /// Nothing equals null.
+            if (value.isNull())
+                return false;
+            const auto column = leaf_columns.find(column_name);
+            if (column == leaf_columns.end())
+                return std::nullopt;
+            const auto bloom_filter = bloom_filters.find({pos, column->second});
+            if (bloom_filter == bloom_filters.end())
+                return std::nullopt;
+            const auto hash = bloomFilterHash(*bloom_filter->second, *schema.Column(column->second), value);
+            if (!hash)
+                return std::nullopt;
+            return bloom_filter->second->FindHash(*hash);
+        };
+        if (!column_index_filter->mayMatchBloomFilters(probe))
+            bloomFilterSkippedRowGroups.insert(readRowGroups[pos].index);
+    }
+
+    if (bloomFilterSkippedRowGroups.empty())
+        return *this;
+
+    LOG_DEBUG(
+        getLogger("ParquetMetaBuilder"),
+        "Bloom filters skipped {} of {} row groups{}",
+        bloomFilterSkippedRowGroups.size(),
+        readRowGroups.size(),
+        fileKey ? " of " + fileKey->path : "");
+    ProfileEvents::increment(ProfileEvents::ParquetPrunedRowGroups, bloomFilterSkippedRowGroups.size());
+    if (!collectPageIndex)
+        std::erase_if(
+            readRowGroups, [&](const RowGroupInformation & row_group) { return bloomFilterSkippedRowGroups.contains(row_group.index); });
+    return *this;
+}
+
 ParquetMetaBuilder & ParquetMetaBuilder::buildSkipRowGroup(const parquet::FileMetaData & file_meta)
 {
     if (collectSkipRowGroup)
@@ -202,6 +424,11 @@ ParquetMetaBuilder & ParquetMetaBuilder::buildRowRange(
         readColumns = pruneColumn(readBlock, file_meta, case_insensitive, allow_missing_columns);
         for (auto & row_group : readRowGroups)
         {
+            if (bloomFilterSkippedRowGroups.contains(row_group.index))
+            {
+                row_group.rowRanges = RowRanges();
+                continue;
+            }
             const auto rgMeta = file_meta.RowGroup(row_group.index);
             const auto pageIndex = reader.GetPageIndexReader();
             const auto rowGroupPageIndex = pageIndex == nullptr ? nullptr : pageIndex->RowGroup(row_group.index);
@@ -209,7 +436,7 @@ ParquetMetaBuilder & ParquetMetaBuilder::buildRowRange(
                 row_group.rowRanges = RowRanges::createSingle(row_group.num_rows);
             else
             {
-                auto columnIndex = collectColumnIndex(*rgMeta, *rowGroupPageIndex, readColumns, case_insensitive);
+                auto columnIndex = collectColumnIndex(*rgMeta, row_group.index, *rowGroupPageIndex);
                 row_group.rowRanges = column_index_filter->calculateRowRanges(*columnIndex, row_group.num_rows);
                 row_group.columnIndexStore = std::move(columnIndex);
             }
@@ -224,9 +451,9 @@ ParquetMetaBuilder & ParquetMetaBuilder::build(
     const ColumnIndexFilter * column_index_filter,
     const std::function<bool(UInt64)> & should_include_row_group)
 {
-    auto reader = openInputParquetFile(read_buffer);
-    fileMetaData = reader->metadata();
+    auto reader = openFile(read_buffer);
     return buildRequiredRowGroups(*fileMetaData, should_include_row_group)
+        .buildBloomFilterSkip(read_buffer, *reader, *fileMetaData, column_index_filter)
         .buildSkipRowGroup(*fileMetaData)
         .buildSchema(*fileMetaData)
         .buildRowRange(*reader, *fileMetaData, readBlock, column_index_filter);
@@ -234,8 +461,7 @@ ParquetMetaBuilder & ParquetMetaBuilder::build(
 
 ParquetMetaBuilder & ParquetMetaBuilder::build(ReadBuffer & read_buffer, const std::function<bool(UInt64)> & should_include_row_group)
 {
-    auto reader = openInputParquetFile(read_buffer);
-    fileMetaData = reader->metadata();
+    auto reader = openFile(read_buffer);
     return buildRequiredRowGroups(*fileMetaData, should_include_row_group)
         .buildSkipRowGroup(*fileMetaData)
         .buildSchema(*fileMetaData)
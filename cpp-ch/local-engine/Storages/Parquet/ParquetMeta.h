@@ -16,9 +16,11 @@
  */
 #pragma once
 
+#include <unordered_set>
 #include <Core/Block.h>
 #include <Formats/FormatSettings.h>
 #include <Storages/Parquet/ColumnIndexFilter.h>
+#include <Storages/Parquet/ParquetMetaCache.h>
 #include <Storages/Parquet/RowRanges.h>
 #include <base/types.h>
 #include <parquet/file_reader.h>
@@ -48,6 +50,8 @@ struct ParquetMetaBuilder
     bool collectSkipRowGroup = false;
     bool collectPageIndex = false;
     bool collectSchema = false;
+    /// Set to look up and store the footer and the column indexes in ParquetMetaCache.
+    std::optional<ParquetFileKey> fileKey;
 
     std::shared_ptr<parquet::FileMetaData> fileMetaData;
 
@@ -63,6 +67,10 @@ struct ParquetMetaBuilder
     // collectSchema
     DB::Block fileHeader;
 
+    /// Row groups ruled out by bloom filters. They are dropped from readRowGroups, unless collectPageIndex, which needs
+    /// contiguous row groups, so they get empty row ranges instead.
+    std::unordered_set<Int32> bloomFilterSkippedRowGroups;
+
     ParquetMetaBuilder & build(
         DB::ReadBuffer & read_buffer,
         const DB::Block & readBlock,
@@ -72,13 +80,21 @@ struct ParquetMetaBuilder
     ParquetMetaBuilder &
     build(DB::ReadBuffer & read_buffer, const std::function<bool(UInt64)> & should_include_row_group = [](UInt64) { return true; });
 
-    static std::unique_ptr<parquet::ParquetFileReader> openInputParquetFile(DB::ReadBuffer & read_buffer);
+    static std::unique_ptr<parquet::ParquetFileReader>
+    openInputParquetFile(DB::ReadBuffer & read_buffer, const std::shared_ptr<parquet::FileMetaData> & metadata = nullptr);
 
     static DB::Block collectFileSchema(const DB::ContextPtr & context, DB::ReadBuffer & read_buffer);
 
 private:
+    /// Opens the file with the cached footer if there is one, and sets fileMetaData.
+    std::unique_ptr<parquet::ParquetFileReader> openFile(DB::ReadBuffer & read_buffer);
     ParquetMetaBuilder &
     buildRequiredRowGroups(const parquet::FileMetaData & file_meta, const std::function<bool(UInt64)> & should_include_row_group);
+    ParquetMetaBuilder & buildBloomFilterSkip(
+        DB::ReadBuffer & read_buffer,
+        parquet::ParquetFileReader & reader,
+        const parquet::FileMetaData & file_meta,
+        const ColumnIndexFilter * column_index_filter);
     ParquetMetaBuilder & buildSkipRowGroup(const parquet::FileMetaData & file_meta);
     ParquetMetaBuilder & buildAllRowRange(const parquet::FileMetaData & file_meta);
     ParquetMetaBuilder & buildRowRange(
@@ -89,11 +105,8 @@ private:
 
     static std::vector<Int32>
     pruneColumn(const DB::Block & header, const parquet::FileMetaData & metadata, bool case_insensitive, bool allow_missing_columns);
-    static std::unique_ptr<ColumnIndexStore> collectColumnIndex(
-        const parquet::RowGroupMetaData & rgMeta,
-        parquet::RowGroupPageIndexReader & rowGroupPageIndex,
-        const std::vector<Int32> & column_indices,
-        bool case_insensitive = false);
+    std::unique_ptr<ColumnIndexStore>
+    collectColumnIndex(const parquet::RowGroupMetaData & rgMeta, Int32 row_group_index, parquet::RowGroupPageIndexReader & rowGroupPageIndex) const;
 
     ParquetMetaBuilder & buildSchema(const parquet::FileMetaData & file_meta);
 };
@@ -121,8 +134,14 @@ inline DB::Block removeMetaColumns(const DB::Block & header)
 
 class ColumnIndexRowRangesProvider
 {
-    ColumnIndexRowRangesProvider(std::vector<RowGroupInformation> rowGroupInfos, std::vector<Int32> readColumns)
-        : startRowGroupIndex_(rowGroupInfos[0].index), rowGroupInfos_(std::move(rowGroupInfos)), readColumns_(std::move(readColumns))
+    ColumnIndexRowRangesProvider(
+        std::vector<RowGroupInformation> rowGroupInfos,
+        std::vector<Int32> readColumns,
+        std::shared_ptr<parquet::FileMetaData> fileMetaData = nullptr)
+        : startRowGroupIndex_(rowGroupInfos[0].index)
+        , rowGroupInfos_(std::move(rowGroupInfos))
+        , readColumns_(std::move(readColumns))
+        , fileMetaData_(std::move(fileMetaData))
     {
         for (const auto & rg : rowGroupInfos_)
             readRowGroups_.push_back(rg.index);
@@ -139,7 +158,8 @@ public:
     {
     }
     explicit ColumnIndexRowRangesProvider(ParquetMetaBuilder & meta_collect)
-        : ColumnIndexRowRangesProvider(std::move(meta_collect.readRowGroups), std::move(meta_collect.readColumns))
+        : ColumnIndexRowRangesProvider(
+              std::move(meta_collect.readRowGroups), std::move(meta_collect.readColumns), meta_collect.fileMetaData)
     {
     }
 
@@ -166,6 +186,8 @@ public:
 
     const std::vector<Int32> & getReadRowGroups() const { return readRowGroups_; };
     const std::vector<Int32> & getReadColumns() const { return readColumns_; };
+    /// The footer the row groups were selected from, so that readers need not parse it again. May be null.
+    const std::shared_ptr<parquet::FileMetaData> & getFileMetaData() const { return fileMetaData_; }
 
 private:
     Int32 adjustRowIndex(Int32 row_group_index) const
@@ -179,6 +201,7 @@ private:
     const std::vector<RowGroupInformation> rowGroupInfos_;
     std::vector<Int32> readRowGroups_;
     const std::vector<Int32> readColumns_;
+    const std::shared_ptr<parquet::FileMetaData> fileMetaData_;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,85 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ParquetMetaCache.h"
+
+#include <fmt/format.h>
+
+namespace local_engine
+{
+
+String ParquetFileKey::toString() const
+{
+    return fmt::format("{}@{}:{}", path, modification_time, file_size);
+}
+
+namespace
+{
+String columnIndexKey(const ParquetFileKey & key, Int32 row_group, Int32 column)
+{
+    return fmt::format("{}#{}#{}", key.toString(), row_group, column);
+}
+}
+
+ParquetMetaCache::ParquetMetaCache() : cache([](const Entry & entry) { return entry.weight; })
+{
+}
+
+ParquetMetaCache & ParquetMetaCache::instance()
+{
+    static ParquetMetaCache cache;
+    return cache;
+}
+
+void ParquetMetaCache::initialize(size_t max_bytes)
+{
+    instance().cache.setMaxWeight(max_bytes);
+}
+
+ParquetMetaCache::FileMetaDataPtr
+ParquetMetaCache::getOrLoadFileMetaData(const ParquetFileKey & key, const std::function<FileMetaDataPtr()> & load)
+{
+    return cache
+        .getOrLoad(
+            key.toString(),
+            [&]
+            {
+                auto metadata = load();
+                /// The parsed footer takes more memory than its serialized form, which is all we know of its size.
+                return Entry{.metadata = metadata, .weight = sizeof(parquet::FileMetaData) + 2 * static_cast<size_t>(metadata->size())};
+            })
+        .metadata;
+}
+
+ColumnIndexPtr ParquetMetaCache::getOrLoadColumnIndex(
+    const ParquetFileKey & key,
+    Int32 row_group,
+    Int32 column,
+    const FileMetaDataPtr & metadata,
+    const std::function<std::pair<ColumnIndexPtr, size_t>()> & load)
+{
+    return cache
+        .getOrLoad(
+            columnIndexKey(key, row_group, column),
+            [&]
+            {
+                auto [column_index, weight] = load();
+                return Entry{.metadata = metadata, .column_index = column_index, .weight = weight};
+            })
+        .column_index;
+}
+
+}
@@ -0,0 +1,86 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <functional>
+#include <Storages/Parquet/ColumnIndexFilter.h>
+#include <base/types.h>
+#include <parquet/metadata.h>
+#include <Common/WeightedLRUCache.h>
+
+namespace local_engine
+{
+
+/// Identifies one version of a Parquet file. A rewritten file has another modification time or size, so it never hits
+/// the entries of the old one.
+struct ParquetFileKey
+{
+    String path;
+    Int64 modification_time = 0;
+    UInt64 file_size = 0;
+
+    String toString() const;
+};
+
+/// Process-wide LRU cache of parsed Parquet footers and column (page) indexes, bounded by an estimate of their memory.
+///
+/// Splits of the same file, and repeated scans of hot files, reuse the footer and the page index instead of reading
+/// and parsing them again. Column indexes are cached per row group and column, since every split reads other row
+/// groups and queries read other columns. A cached column index keeps its footer alive, as it refers to the schema.
+///
+/// This is not the ParquetMetadataCache of the global context, which holds the footers of the native v3 reader. Both
+/// have their own budget, and hits and misses of this one are counted by hits() and misses().
+class ParquetMetaCache
+{
+public:
+    using FileMetaDataPtr = std::shared_ptr<parquet::FileMetaData>;
+
+    static ParquetMetaCache & instance();
+
+    /// A max_bytes of 0 disables the cache.
+    static void initialize(size_t max_bytes);
+
+    FileMetaDataPtr getOrLoadFileMetaData(const ParquetFileKey & key, const std::function<FileMetaDataPtr()> & load);
+
+    /// `load` returns the column index and an estimate of its memory. `metadata` is the footer the index refers to.
+    ColumnIndexPtr getOrLoadColumnIndex(
+        const ParquetFileKey & key,
+        Int32 row_group,
+        Int32 column,
+        const FileMetaDataPtr & metadata,
+        const std::function<std::pair<ColumnIndexPtr, size_t>()> & load);
+
+    size_t maxBytes() const { return cache.maxWeight(); }
+    size_t sizeInBytes() const { return cache.weight(); }
+    size_t count() const { return cache.count(); }
+    size_t hits() const { return cache.hits(); }
+    size_t misses() const { return cache.misses(); }
+
+private:
+    ParquetMetaCache();
+
+    struct Entry
+    {
+        FileMetaDataPtr metadata;
+        ColumnIndexPtr column_index;
+        size_t weight = 0;
+    };
+
+    WeightedLRUCache<Entry> cache;
+};
+
+}
@@ -17,18 +17,26 @@
 #include "VectorizedParquetRecordReader.h"
 
 #if USE_PARQUET
+#include <deque>
+#include <future>
 #include <numeric>
 #include <optional>
+#include <IO/SeekableReadBuffer.h>
 #include <Processors/Chunk.h>
 #include <Processors/Formats/Impl/ArrowBufferedStreams.h>
 #include <Processors/Formats/Impl/ArrowFieldIndexUtil.h>
 #include <Storages/Parquet/ArrowUtils.h>
 #include <Storages/Parquet/ParquetMeta.h>
 #include <arrow/io/memory.h>
+#include <arrow/util/byte_size.h>
 #include <arrow/util/int_util_overflow.h>
 #include <parquet/column_reader.h>
 #include <parquet/file_reader.h>
 #include <parquet/page_index.h>
+#include <Common/CurrentThread.h>
+#include <Common/LocalThreadPools.h>
+#include <Common/ThreadPool.h>
+#include <Common/setThreadName.h>
 
 namespace
 {
@@ -175,7 +183,8 @@ parquet::arrow::SchemaManifest VectorizedParquetRecordReader::createSchemaManife
 }
 
 
-VectorizedParquetRecordReader::VectorizedParquetRecordReader(const DB::Block & header, const DB::FormatSettings & format_settings)
+VectorizedParquetRecordReader::VectorizedParquetRecordReader(
+    const DB::Block & header, const DB::FormatSettings & format_settings, size_t decode_threads, size_t decode_memory_budget)
     : parquet_header_(header)
     , format_settings_(format_settings)
     , arrow_column_to_ch_column_(
@@ -188,13 +197,18 @@ VectorizedParquetRecordReader::VectorizedParquetRecordReader(const DB::Block & h
           format_settings_.null_as_default,
           format_settings_.date_time_overflow_behavior,
           format_settings_.parquet.case_insensitive_column_matching)
+    , decode_threads_(decode_threads)
+    , decode_memory_budget_(decode_memory_budget)
 {
 }
 
+VectorizedParquetRecordReader::~VectorizedParquetRecordReader() = default;
+
 bool VectorizedParquetRecordReader::initialize(
     const std::shared_ptr<arrow::io::RandomAccessFile> & arrow_file,
     const ColumnIndexRowRangesProvider & row_ranges_provider,
-    const std::shared_ptr<parquet::FileMetaData> & metadata)
+    const std::shared_ptr<parquet::FileMetaData> & metadata,
+    bool concurrent_reads)
 {
     auto file_reader = parquet::ParquetFileReader::Open(arrow_file, parquet::default_reader_properties(), metadata);
     const parquet::FileMetaData & file_metadata = *file_reader->metadata();
@@ -208,7 +222,8 @@ bool VectorizedParquetRecordReader::initialize(
     // initialize File Reader
     parquet::arrow::SchemaManifest manifest = createSchemaManifest(file_metadata);
     THROW_ARROW_NOT_OK_OR_ASSIGN(std::vector<int> field_indices, manifest.GetFieldIndices(column_indices));
-    file_reader_ = std::make_unique<ParquetFileReaderExt>(arrow_file, std::move(file_reader), row_ranges_provider, format_settings_);
+    file_reader_ = std::make_unique<ParquetFileReaderExt>(
+        arrow_file, std::move(file_reader), row_ranges_provider, format_settings_, concurrent_reads);
     column_readers_.reserve(field_indices.size());
 
     for (auto const & column_index : field_indices)
@@ -223,17 +238,87 @@ bool VectorizedParquetRecordReader::initialize(
             return false;
         }
     }
+
+    if (decode_threads_ > 1 && column_readers_.size() > 1)
+    {
+        /// A batch of the first row group takes about its share of the uncompressed column chunk.
+        const auto first_row_group = file_metadata.RowGroup(row_groups.front());
+        const double batch_fraction = std::min(
+            1.0, static_cast<double>(format_settings_.parquet.max_block_size) / std::max<int64_t>(first_row_group->num_rows(), 1));
+        decoded_bytes_.clear();
+        decoded_bytes_.reserve(field_indices.size());
+        for (auto const & column_index : field_indices)
+            decoded_bytes_.push_back(
+                static_cast<size_t>(first_row_group->ColumnChunk(column_index)->total_uncompressed_size() * batch_fraction));
+    }
     return true;
 }
 
+void VectorizedParquetRecordReader::readColumnsParallel(int64_t batch_size, std::vector<std::shared_ptr<arrow::ChunkedArray>> & columns)
+{
+    struct InFlight
+    {
+        size_t estimated_bytes;
+        std::future<void> done;
+    };
+    std::deque<InFlight> in_flight;
+    size_t in_flight_bytes = 0;
+
+    auto wait_oldest = [&]
+    {
+        in_flight_bytes -= in_flight.front().estimated_bytes;
+        auto done = std::move(in_flight.front().done);
+        in_flight.pop_front();
+        done.get();
+    };
+
+    try
+    {
+        for (size_t i = 0; i < column_readers_.size(); ++i)
+        {
+            /// A column larger than the budget on its own is decoded alone.
+            const size_t estimated_bytes = decoded_bytes_[i];
+            while (!in_flight.empty() && (in_flight.size() >= decode_threads_ || in_flight_bytes + estimated_bytes > decode_memory_budget_))
+                wait_oldest();
+
+            auto task = std::make_shared<std::packaged_task<void()>>(
+                [this, i, batch_size, &columns, thread_group = DB::CurrentThread::getGroup()]
+                {
+                    DB::ThreadGroupSwitcher switcher(thread_group, ThreadName::PARALLEL_READ);
+                    columns[i] = column_readers_[i].readBatch(batch_size);
+                    decoded_bytes_[i] = arrow::util::TotalBufferSize(*columns[i]);
+                });
+            in_flight.push_back({estimated_bytes, task->get_future()});
+            in_flight_bytes += estimated_bytes;
+            LocalThreadPools::parquetDecode().scheduleOrThrow([task] { (*task)(); });
+        }
+        while (!in_flight.empty())
+            wait_oldest();
+    }
+    catch (...)
+    {
+        /// The tasks refer to the readers and to `columns`.
+        for (auto & task : in_flight)
+            task.done.wait();
+        throw;
+    }
+}
+
 DB::Chunk VectorizedParquetRecordReader::nextBatch()
 {
     assert(initialized());
+    const int64_t batch_size = format_settings_.parquet.max_block_size;
     ::arrow::ChunkedArrayVector columns(column_readers_.size());
+    if (!decoded_bytes_.empty())
+        readColumnsParallel(batch_size, columns);
+    else
+        for (size_t i = 0; i < column_readers_.size(); ++i)
+            columns[i] = column_readers_[i].readBatch(batch_size);
+
     DB::ArrowColumnToCHColumn::NameToArrowColumn name_to_column_ptr;
-    for (auto & vectorized_column_reader : column_readers_)
-        name_to_column_ptr[lowerColumnNameIfNeed(vectorized_column_reader.columnName(), format_settings_)]
-            = {vectorized_column_reader.readBatch(format_settings_.parquet.max_block_size), vectorized_column_reader.arrowField()};
+    for (size_t i = 0; i < column_readers_.size(); ++i)
+        name_to_column_ptr[lowerColumnNameIfNeed(column_readers_[i].columnName(), format_settings_)]
+            = {std::move(columns[i]), column_readers_[i].arrowField()};
 
     if (const size_t num_rows = name_to_column_ptr.begin()->second.column->length(); num_rows > 0)
         return arrow_column_to_ch_column_.arrowColumnsToCHChunk(
@@ -245,11 +330,13 @@ ParquetFileReaderExt::ParquetFileReaderExt(
     const std::shared_ptr<arrow::io::RandomAccessFile> & source,
     std::unique_ptr<parquet::ParquetFileReader> parquetFileReader,
     const ColumnIndexRowRangesProvider & row_ranges_provider,
-    const DB::FormatSettings & format_settings)
+    const DB::FormatSettings & format_settings,
+    bool concurrent_reads)
     : source_(source)
     , file_reader_(std::move(parquetFileReader))
     , format_settings_(format_settings)
     , row_ranges_provider_(row_ranges_provider)
+    , concurrent_reads_(concurrent_reads)
 {
     THROW_ARROW_NOT_OK_OR_ASSIGN(const int64_t source_size, source_->GetSize());
     source_size_ = source_size;
@@ -302,6 +389,9 @@ ColumnChunkPageRead ParquetFileReaderExt::readColumnChunkPageBase(
     const auto col_range = computeColumnChunkRange(*file_metadata, *column_metadata, source_size_);
     const parquet::ReaderProperties properties;
     auto [read_ranges, read_sequence] = build_read(col_range);
+    std::unique_lock lock(read_mutex_, std::defer_lock);
+    if (!concurrent_reads_)
+        lock.lock();
     const auto input_stream = getStream(*source_, read_ranges);
     return std::make_pair(
         parquet::PageReader::Open(
@@ -314,8 +404,12 @@ VectorizedParquetBlockInputFormat::VectorizedParquetBlockInputFormat(
     DB::ReadBuffer & in_,
     const DB::SharedHeader & header_,
     const ColumnIndexRowRangesProvider & row_ranges_provider,
-    const DB::FormatSettings & format_settings)
-    : DB::IInputFormat(header_, &in_), record_reader_(getPort().getHeader(), format_settings), row_ranges_provider_(row_ranges_provider)
+    const DB::FormatSettings & format_settings,
+    size_t decode_threads,
+    size_t decode_memory_budget)
+    : DB::IInputFormat(header_, &in_)
+    , record_reader_(getPort().getHeader(), format_settings, decode_threads, decode_memory_budget)
+    , row_ranges_provider_(row_ranges_provider)
 {
 }
 
@@ -332,10 +426,14 @@ DB::Chunk VectorizedParquetBlockInputFormat::read()
 
     if (!record_reader_.initialized())
     {
-        const auto arrow_file = DB::asArrowFile(*in, record_reader_.formatSettings(), is_stopped, "Parquet", PARQUET_MAGIC_BYTES);
+        /// Parallel decoding loads column chunks from several threads, which only proceed at once over positional reads.
+        auto * seekable_in = dynamic_cast<DB::SeekableReadBuffer *>(in);
+        const bool concurrent_reads = record_reader_.decodesInParallel() && seekable_in && seekable_in->supportsReadAt();
+        const auto arrow_file = DB::asArrowFile(
+            *in, record_reader_.formatSettings(), is_stopped, "Parquet", PARQUET_MAGIC_BYTES, /* avoid_buffering */ concurrent_reads);
         if (is_stopped != 0)
             return {};
-        if (!record_reader_.initialize(arrow_file, row_ranges_provider_))
+        if (!record_reader_.initialize(arrow_file, row_ranges_provider_, row_ranges_provider_.getFileMetaData(), concurrent_reads))
             return {};
     }
     return record_reader_.nextBatch();
@@ -20,6 +20,7 @@
 
 #if USE_PARQUET
 
+#include <mutex>
 #include <Formats/FormatSettings.h>
 #include <Processors/Formats/IInputFormat.h>
 #include <Processors/Formats/Impl/ArrowColumnToCHColumn.h>
@@ -120,6 +121,10 @@ class ParquetFileReaderExt
     std::unique_ptr<parquet::ParquetFileReader> file_reader_;
     const DB::FormatSettings & format_settings_;
     const ColumnIndexRowRangesProvider & row_ranges_provider_;
+    /// Column readers may load their chunks from decode threads at once, while a RandomAccessFile over a ReadBuffer only
+    /// promises concurrent ReadAt calls when the buffer reads at offsets. Otherwise the loads are serialized on read_mutex_.
+    const bool concurrent_reads_;
+    mutable std::mutex read_mutex_;
 
     ColumnChunkPageRead
     readColumnChunkPageBase(const parquet::RowGroupMetaData & rg, Int32 column_index, const BuildRead & build_read) const;
@@ -129,7 +134,8 @@ public:
         const std::shared_ptr<arrow::io::RandomAccessFile> & source,
         std::unique_ptr<parquet::ParquetFileReader> parquetFileReader,
         const ColumnIndexRowRangesProvider & row_ranges_provider,
-        const DB::FormatSettings & format_settings);
+        const DB::FormatSettings & format_settings,
+        bool concurrent_reads = false);
     std::optional<ColumnChunkPageRead> nextRowGroup(int32_t row_group_index, int32_t column_index, const std::string & column_name) const;
     parquet::ParquetFileReader * fileReader() const { return file_reader_.get(); }
     std::shared_ptr<parquet::FileMetaData> fileMeta() const { return file_reader_->metadata(); }
@@ -180,23 +186,42 @@ class VectorizedParquetRecordReader
     /// columns to read from Parquet file.
     std::vector<VectorizedColumnReader> column_readers_;
 
+    /// Parallel decoding, see readColumnsParallel.
+    const size_t decode_threads_;
+    const size_t decode_memory_budget_;
+    /// Bytes each column decoded to in the last batch, the estimate of its next batch. The first batch is estimated from
+    /// the uncompressed size of the column chunk in the first row group.
+    std::vector<size_t> decoded_bytes_;
+
     static parquet::arrow::SchemaManifest createSchemaManifest(const parquet::FileMetaData & metadata);
 
+    /// Decodes the columns of a batch on LocalThreadPools::parquetDecode(). Columns are independent, and each one loads
+    /// the pages of its next row group as part of its task, so both the I/O and the decoding of a wide row group fan
+    /// out. Chunk loads run in parallel only when the arrow file was opened with concurrent_reads, see initialize. At most
+    /// decode_threads_ columns, estimated to take at most decode_memory_budget_ bytes together, are in flight at once.
+    void readColumnsParallel(int64_t batch_size, std::vector<std::shared_ptr<arrow::ChunkedArray>> & columns);
+
 public:
-    VectorizedParquetRecordReader(const DB::Block & header, const DB::FormatSettings & format_settings);
-    ~VectorizedParquetRecordReader() = default;
+    /// With decode_threads > 1 the columns of a batch are decoded on that many threads.
+    VectorizedParquetRecordReader(
+        const DB::Block & header, const DB::FormatSettings & format_settings, size_t decode_threads = 0, size_t decode_memory_budget = 0);
+    ~VectorizedParquetRecordReader();
 
+    /// concurrent_reads tells that arrow_file serves concurrent ReadAt calls, as it does over a buffer supporting readBigAt.
     bool initialize(
         const std::shared_ptr<arrow::io::RandomAccessFile> & arrow_file,
         const ColumnIndexRowRangesProvider & row_ranges_provider,
-        const std::shared_ptr<parquet::FileMetaData> & metadata = nullptr);
+        const std::shared_ptr<parquet::FileMetaData> & metadata = nullptr,
+        bool concurrent_reads = false);
     DB::Chunk nextBatch();
 
     bool initialized() const { return file_reader_ != nullptr; }
+    bool decodesInParallel() const { return decode_threads_ > 1; }
 
     void reset()
     {
         column_readers_.clear();
+        decoded_bytes_.clear();
         file_reader_.reset();
     }
 
@@ -219,7 +244,9 @@ public:
         DB::ReadBuffer & in_,
         const DB::SharedHeader & header_,
         const ColumnIndexRowRangesProvider & row_ranges_provider,
-        const DB::FormatSettings & format_settings);
+        const DB::FormatSettings & format_settings,
+        size_t decode_threads = 0,
+        size_t decode_memory_budget = 0);
     String getName() const override { return "VectorizedParquetBlockInputFormat"; }
     void resetParser() override;
 
@@ -0,0 +1,58 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "DeletionBitmapCache.h"
+
+#include <fmt/format.h>
+
+namespace local_engine
+{
+
+DeletionBitmapCache & DeletionBitmapCache::instance()
+{
+    static DeletionBitmapCache bitmap_cache;
+    return bitmap_cache;
+}
+
+DeletionBitmapCache::DeletionBitmapCache()
+    : cache([](const DeletionBitmapPtr & bitmap) { return sizeof(DeltaDVRoaringBitmapArray) + bitmap->rb_size_in_bytes(); })
+{
+}
+
+void DeletionBitmapCache::initialize(size_t max_bytes)
+{
+    instance().cache.setMaxWeight(max_bytes);
+}
+
+DeletionBitmapPtr DeletionBitmapCache::getOrLoad(const String & key, const std::function<DeletionBitmapPtr()> & load)
+{
+    return cache.getOrLoad(key, load);
+}
+
+DeletionBitmapPtr
+DeletionBitmapCache::getOrReadDeletionVector(const String & file_path, Int32 offset, Int32 size_in_bytes, const DB::ContextPtr & context)
+{
+    return getOrLoad(
+        fmt::format("dv:{}@{}+{}", file_path, offset, size_in_bytes),
+        [&]
+        {
+            auto bitmap = std::make_shared<DeltaDVRoaringBitmapArray>();
+            bitmap->rb_read(file_path, offset, size_in_bytes, context);
+            return bitmap;
+        });
+}
+
+}
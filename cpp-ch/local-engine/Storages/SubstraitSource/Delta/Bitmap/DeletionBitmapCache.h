@@ -0,0 +1,56 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <Interpreters/Context_fwd.h>
+#include <Storages/SubstraitSource/Delta/Bitmap/DeltaDVRoaringBitmapArray.h>
+#include <Common/WeightedLRUCache.h>
+
+namespace local_engine
+{
+
+using DeletionBitmapPtr = std::shared_ptr<const DeltaDVRoaringBitmapArray>;
+
+/// Process-wide LRU cache of deserialized deletion bitmaps, bounded by their memory.
+///
+/// Delta deletion vectors and Iceberg positional delete files never change once written, and every split of a data file
+/// reads the same ones. Caching them decodes each once per executor instead of once per split.
+class DeletionBitmapCache
+{
+public:
+    static DeletionBitmapCache & instance();
+
+    /// A max_bytes of 0 disables the cache.
+    static void initialize(size_t max_bytes);
+
+    /// Keys are chosen by the callers, so that they identify the file and the part of it the bitmap is built from.
+    DeletionBitmapPtr getOrLoad(const String & key, const std::function<DeletionBitmapPtr()> & load);
+
+    /// Reads the Delta deletion vector stored at `offset` of `file_path`.
+    DeletionBitmapPtr getOrReadDeletionVector(const String & file_path, Int32 offset, Int32 size_in_bytes, const DB::ContextPtr & context);
+
+    size_t maxBytes() const { return cache.maxWeight(); }
+    size_t sizeInBytes() const { return cache.weight(); }
+    size_t count() const { return cache.count(); }
+
+private:
+    DeletionBitmapCache();
+
+    WeightedLRUCache<DeletionBitmapPtr> cache;
+};
+
+}
@@ -98,6 +98,14 @@ UInt64 DeltaDVRoaringBitmapArray::cardinality() const
     return sum;
 }
 
+size_t DeltaDVRoaringBitmapArray::rb_size_in_bytes() const
+{
+    size_t size = roaring_bitmap_array.capacity() * sizeof(roaring::Roaring);
+    for (const auto & r : roaring_bitmap_array)
+        size += r.getSizeInBytes(/* portable */ false);
+    return size;
+}
+
 bool DeltaDVRoaringBitmapArray::rb_contains(Int64 x) const
 {
     auto [high, low] = decompose_high_low_bytes(x);
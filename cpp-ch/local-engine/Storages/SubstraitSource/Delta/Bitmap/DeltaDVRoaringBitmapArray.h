@@ -47,6 +47,8 @@ public:
     ~DeltaDVRoaringBitmapArray() = default;
     bool operator==(const DeltaDVRoaringBitmapArray & other) const;
     UInt64 cardinality() const;
+    /// Memory taken by the bitmaps, as far as CRoaring reports it.
+    size_t rb_size_in_bytes() const;
     void rb_read(const String & file_path, Int32 offset, Int32 data_size, DB::ContextPtr context);
     bool rb_contains(Int64 x) const;
     bool rb_is_empty() const;
@@ -62,10 +62,8 @@ DeltaReader::DeltaReader(
     , bitmap_config(bitmap_config_)
 {
     if (bitmap_config)
-    {
-        bitmap_array = std::make_unique<DeltaDVRoaringBitmapArray>();
-        bitmap_array->rb_read(bitmap_config->path_or_inline_dv, bitmap_config->offset, bitmap_config->size_in_bytes, file->getContext());
-    }
+        bitmap_array = DeletionBitmapCache::instance().getOrReadDeletionVector(
+            bitmap_config->path_or_inline_dv, bitmap_config->offset, bitmap_config->size_in_bytes, file->getContext());
 }
 
 Chunk DeltaReader::doPull()
@@ -17,7 +17,7 @@
 #pragma once
 
 #include <Storages/SubstraitSource/FileReader.h>
-#include <Storages/SubstraitSource/Delta/Bitmap/DeltaDVRoaringBitmapArray.h>
+#include <Storages/SubstraitSource/Delta/Bitmap/DeletionBitmapCache.h>
 #include <Storages/SubstraitSource/Delta/DeltaMeta.h>
 
 namespace local_engine::delta
@@ -26,7 +26,7 @@ namespace local_engine::delta
 class DeltaReader final : public NormalFileReader
 {
     std::shared_ptr<DeltaVirtualMeta::DeltaDVBitmapConfig> bitmap_config;
-    std::unique_ptr<DeltaDVRoaringBitmapArray> bitmap_array;
+    DeletionBitmapPtr bitmap_array;
 
 public:
     static std::unique_ptr<DeltaReader> create(
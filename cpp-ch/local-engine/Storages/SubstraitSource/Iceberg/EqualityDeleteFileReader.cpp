@@ -17,15 +17,15 @@
 
 #include "EqualityDeleteFileReader.h"
 
-#include <Columns/ColumnConst.h>
-#include <Columns/ColumnSet.h>
-#include <DataTypes/DataTypeSet.h>
-#include <Functions/FunctionFactory.h>
+#include <Columns/ColumnsNumber.h>
 #include <Interpreters/Context.h>
-#include <Interpreters/ExpressionActions.h>
 #include <Processors/Formats/Impl/ParquetBlockInputFormat.h>
 #include <Storages/SubstraitSource/Iceberg/SimpleParquetReader.h>
+#include <fmt/format.h>
 #include <Common/BlockTypeUtils.h>
+#include <Common/Stopwatch.h>
+#include <Common/assert_cast.h>
+#include <Common/logger_useful.h>
 using namespace DB;
 
 namespace local_engine
@@ -34,92 +34,52 @@ namespace local_engine
 namespace iceberg
 {
 
-const ActionsDAG::Node & EqualityDeleteActionBuilder::lastMerge()
+EqualityDeleteSetCache & EqualityDeleteSetCache::instance()
 {
-    assert(!andArgs.empty());
-
-    if (andArgs.size() == 1)
-        return actions.addAlias(*andArgs[0], COLUMN_NAME);
-
-    const std::string And_{"and"};
-    auto andBuilder = FunctionFactory::instance().get(And_, context);
-    return actions.addFunction(andBuilder, andArgs, COLUMN_NAME);
+    static EqualityDeleteSetCache set_cache;
+    return set_cache;
 }
 
-const ActionsDAG::Node * EqualityDeleteActionBuilder::Or(const ActionsDAG::NodeRawConstPtrs & orArgs)
+EqualityDeleteSetCache::EqualityDeleteSetCache() : cache([](const SetPtr & set) { return set->getTotalByteCount(); })
 {
-    if (orArgs.size() == 1)
-        return orArgs[0];
-
-    const std::string Or_{"or"};
-    auto OrBuilder = FunctionFactory::instance().get(Or_, context);
-    return &addFunction(OrBuilder, orArgs);
 }
 
-const ActionsDAG::Node &
-EqualityDeleteActionBuilder::addFunction(const FunctionOverloadResolverPtr & function, ActionsDAG::NodeRawConstPtrs args)
+void EqualityDeleteSetCache::initialize(size_t max_bytes)
 {
-    return actions.addFunction(function, std::move(args), getUniqueName(function->getName()));
+    instance().cache.setMaxWeight(max_bytes);
 }
 
-void EqualityDeleteActionBuilder::notIn(Block deleteBlock, const std::string & column_name)
+SetPtr EqualityDeleteSetCache::getOrLoad(const SubstraitIcebergDeleteFile & delete_file, const std::function<SetPtr()> & load)
 {
-    assert(deleteBlock.columns() == 1);
-    const auto & elem_block = deleteBlock.getByPosition(0);
-
-    const std::string notIn{"notIn"};
-
-    ActionsDAG::NodeRawConstPtrs args;
-    const auto & colName = column_name.empty() ? elem_block.name : column_name;
-    args.push_back(&actions.findInOutputs(colName));
-    PreparedSets prepared_sets;
-    FutureSet::Hash emptyKey;
-    auto future_set = prepared_sets.addFromTuple(emptyKey, nullptr, {elem_block}, context->getSettingsRef());
-    auto arg = ColumnSet::create(1, std::move(future_set));
-    args.emplace_back(&actions.addColumn(ColumnWithTypeAndName(std::move(arg), std::make_shared<DataTypeSet>(), "__set")));
-
-    auto function_builder = FunctionFactory::instance().get(notIn, context);
-    andArgs.push_back(&addFunction(function_builder, std::move(args)));
+    return cache.getOrLoad(fmt::format("{}:{}", delete_file.filepath(), delete_file.filesize()), load);
 }
 
-void EqualityDeleteActionBuilder::notEquals(Block deleteBlock, const Names & column_names)
+void EqualityDeleteFilter::addDeleteSet(SetPtr set, Names key_columns)
 {
-    auto numDeleteFields = deleteBlock.columns();
-    assert(deleteBlock.columns() > 1);
+    assert(set->getDataTypes().size() == key_columns.size());
+    delete_sets.push_back({std::move(set), std::move(key_columns)});
+}
 
-    const std::string notEqual{"notEquals"};
-    auto notEqualBuilder = FunctionFactory::instance().get(notEqual, context);
+void EqualityDeleteFilter::execute(Block & block) const
+{
+    const size_t num_rows = block.rows();
+    auto kept = ColumnUInt8::create(num_rows, 1);
+    auto & kept_data = kept->getData();
 
-    auto numDeletedValues = deleteBlock.rows();
-    for (size_t i = 0; i < numDeletedValues; i++)
+    for (const auto & [set, key_columns] : delete_sets)
     {
-        ActionsDAG::NodeRawConstPtrs orArgs = {};
-        for (size_t j = 0; j < numDeleteFields; j++)
-        {
-            ActionsDAG::NodeRawConstPtrs args;
-            const auto & column = deleteBlock.getByPosition(j);
-            auto u_column = column.type->createColumn();
-            u_column->reserve(1);
-            u_column->insertFrom(*column.column, i);
-
-            const auto & colName = column_names.empty() ? column.name : column_names[j];
-            args.push_back(&actions.findInOutputs(colName));
-            args.push_back(
-                &actions.addColumn(ColumnWithTypeAndName(ColumnConst::create(std::move(u_column), 1), column.type, getUniqueName("c"))));
-            orArgs.push_back(&addFunction(notEqualBuilder, std::move(args)));
-        }
-        assert(!orArgs.empty());
-        andArgs.push_back(Or(orArgs));
+        ColumnsWithTypeAndName keys;
+        keys.reserve(key_columns.size());
+        for (const auto & name : key_columns)
+            keys.push_back(block.getByName(name));
+
+        const auto not_deleted = set->execute(keys, /* negative */ true)->convertToFullColumnIfConst();
+        const auto & not_deleted_data = assert_cast<const ColumnUInt8 &>(*not_deleted).getData();
+        for (size_t i = 0; i < num_rows; ++i)
+            kept_data[i] &= not_deleted_data[i];
     }
-}
-
-ExpressionActionsPtr EqualityDeleteActionBuilder::finish()
-{
-    if (andArgs.empty())
-        return nullptr;
 
-    actions.addOrReplaceInOutputs(lastMerge());
-    return std::make_shared<ExpressionActions>(std::move(actions), ExpressionActionsSettings(context, CompileExpressions::no));
+    block.insert({std::move(kept), UINT8(), COLUMN_NAME});
 }
 
 EqualityDeleteFileReader::EqualityDeleteFileReader(
@@ -137,31 +97,37 @@ EqualityDeleteFileReader::EqualityDeleteFileReader(
     }
 }
 
-void EqualityDeleteFileReader::readDeleteValues(EqualityDeleteActionBuilder & expressionInputs) const
+SetPtr EqualityDeleteFileReader::readDeleteSet() const
 {
     assert(data_file_schema_for_delete_.columns() != 0);
+    Stopwatch watch;
     SimpleParquetReader reader{context_, deleteFile_};
 
     Block deleteBlock = reader.next();
     assert(deleteBlock.rows() > 0 && "Iceberg equality delete file should have at least one row.");
-    auto numDeleteFields = deleteBlock.columns();
-    assert(numDeleteFields > 0 && "Iceberg equality delete file should have at least one field.");
-
     assert(deleteBlock.columns() == data_file_schema_for_delete_.columns());
-    Names names{data_file_schema_for_delete_.getNames()};
 
+    /// Iceberg matches null keys to nulls in the delete file, as transform_null_in does.
+    auto set = std::make_shared<Set>(SizeLimits{}, /* max_elements_to_fill */ 0, /* transform_null_in */ true);
+    set->setHeader(deleteBlock.cloneEmpty().getColumnsWithTypeAndName());
     while (deleteBlock.rows() > 0)
     {
-        if (deleteBlock.columns() == 1)
-            expressionInputs.notIn(std::move(deleteBlock), names[0]);
-        else
-            expressionInputs.notEquals(std::move(deleteBlock), names);
-
+        set->insertFromBlock(deleteBlock.getColumnsWithTypeAndName());
         deleteBlock = reader.next();
     }
+    set->finishInsert();
+
+    LOG_DEBUG(
+        getLogger("EqualityDeleteFileReader"),
+        "Built the set of {} keys ({} bytes) of equality delete file {} in {} ms",
+        set->getTotalRowCount(),
+        set->getTotalByteCount(),
+        deleteFile_.filepath(),
+        watch.elapsedMilliseconds());
+    return set;
 }
 
-ExpressionActionsPtr EqualityDeleteFileReader::createDeleteExpr(
+std::unique_ptr<EqualityDeleteFilter> EqualityDeleteFileReader::createDeleteFilter(
     const ContextPtr & context,
     const Block & data_file_header,
     const google::protobuf::RepeatedPtrField<SubstraitIcebergDeleteFile> & delete_files,
@@ -170,7 +136,8 @@ ExpressionActionsPtr EqualityDeleteFileReader::createDeleteExpr(
 {
     assert(!equality_delete_files.empty());
 
-    EqualityDeleteActionBuilder expressionInputs{context, data_file_header.getNamesAndTypesList()};
+    auto filter = std::make_unique<EqualityDeleteFilter>();
+    bool has_deletes = false;
     for (auto deleteIndex : equality_delete_files)
     {
         const auto & delete_file = delete_files[deleteIndex];
@@ -181,12 +148,14 @@ ExpressionActionsPtr EqualityDeleteFileReader::createDeleteExpr(
             for (const auto & col : delete_file_reader.data_file_schema_for_delete_)
                 if (!reader_header.has(col.name))
                     reader_header.insert(col.cloneEmpty());
-            delete_file_reader.readDeleteValues(expressionInputs);
+            auto set = EqualityDeleteSetCache::instance().getOrLoad(delete_file, [&] { return delete_file_reader.readDeleteSet(); });
+            filter->addDeleteSet(std::move(set), delete_file_reader.data_file_schema_for_delete_.getNames());
+            has_deletes = true;
         }
     }
-    return expressionInputs.finish();
+    return has_deletes ? std::move(filter) : nullptr;
 }
 
 }
 
-}
\ No newline at end of file
+}
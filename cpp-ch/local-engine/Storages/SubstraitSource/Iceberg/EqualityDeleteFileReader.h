@@ -17,42 +17,63 @@
 #pragma once
 
 #include <Core/Block.h>
-#include <Functions/FunctionFactory.h>
 #include <Interpreters/Context_fwd.h>
-#include <Interpreters/ExpressionActions.h>
+#include <Interpreters/Set.h>
 #include <Storages/SubstraitSource/substrait_fwd.h>
+#include <Common/WeightedLRUCache.h>
 
 namespace local_engine::iceberg
 {
 
-/// Visible for UT
+/// Process-wide LRU cache of the hash sets built from equality delete files, bounded by their memory.
 ///
-class EqualityDeleteActionBuilder
+/// Delete files are immutable and every split of a snapshot refers to the same ones, so each set is built once instead
+/// of once per data file.
+class EqualityDeleteSetCache
 {
 public:
-    static constexpr auto COLUMN_NAME = "__kept__";
+    static EqualityDeleteSetCache & instance();
 
-private:
-    DB::ActionsDAG actions;
-    const DB::ContextPtr context;
-    DB::ActionsDAG::NodeRawConstPtrs andArgs = {};
-    UInt64 unique_name_counter = 0;
+    /// A max_bytes of 0 disables the cache.
+    static void initialize(size_t max_bytes);
 
-    const DB::ActionsDAG::Node & lastMerge();
-    const DB::ActionsDAG::Node * Or(const DB::ActionsDAG::NodeRawConstPtrs & orArgs);
+    DB::SetPtr getOrLoad(const SubstraitIcebergDeleteFile & delete_file, const std::function<DB::SetPtr()> & load);
 
-    std::string getUniqueName(const String & name = "_") { return name + "_" + std::to_string(unique_name_counter++); }
-    const DB::ActionsDAG::Node & addFunction(const DB::FunctionOverloadResolverPtr & function, DB::ActionsDAG::NodeRawConstPtrs args);
+    size_t maxBytes() const { return cache.maxWeight(); }
+    size_t sizeInBytes() const { return cache.weight(); }
+    size_t count() const { return cache.count(); }
+    size_t hits() const { return cache.hits(); }
+    size_t misses() const { return cache.misses(); }
+
+private:
+    EqualityDeleteSetCache();
 
+    WeightedLRUCache<DB::SetPtr> cache;
+};
+
+/// Applies equality deletes by probing the key columns of each block in the hash set of every delete file.
+///
+/// The sets pack fixed-width keys into a single integer and keep string keys in an arena, and are probed a column at a
+/// time, so the cost per row does not grow with the number of deleted rows. As in Iceberg, a null key matches a null
+/// in the delete file.
+class EqualityDeleteFilter
+{
 public:
-    explicit EqualityDeleteActionBuilder(const DB::ContextPtr & context_, const DB::NamesAndTypesList & inputs_)
-        : actions(inputs_), context(context_)
-    {
-    }
+    static constexpr auto COLUMN_NAME = "__kept__";
+
+    /// `key_columns` are the columns of the data file matching the columns of `set`.
+    void addDeleteSet(DB::SetPtr set, DB::Names key_columns);
 
-    void notIn(DB::Block deleteBlock, const std::string & column_name = "");
-    void notEquals(DB::Block deleteBlock, const DB::Names & column_names = {});
-    DB::ExpressionActionsPtr finish();
+    /// Appends COLUMN_NAME to `block`, 1 for the rows that are kept.
+    void execute(DB::Block & block) const;
+
+private:
+    struct DeleteSet
+    {
+        DB::SetPtr set;
+        DB::Names key_columns;
+    };
+    std::vector<DeleteSet> delete_sets;
 };
 
 class EqualityDeleteFileReader
@@ -62,7 +83,7 @@ class EqualityDeleteFileReader
     DB::Block data_file_schema_for_delete_;
 
 public:
-    static DB::ExpressionActionsPtr createDeleteExpr(
+    static std::unique_ptr<EqualityDeleteFilter> createDeleteFilter(
         const DB::ContextPtr & context,
         const DB::Block & data_file_header,
         const google::protobuf::RepeatedPtrField<SubstraitIcebergDeleteFile> & delete_files,
@@ -72,7 +93,7 @@ public:
     explicit EqualityDeleteFileReader(
         const DB::ContextPtr & context, const DB::Block & read_header, const SubstraitIcebergDeleteFile & deleteFile);
     ~EqualityDeleteFileReader() = default;
-    void readDeleteValues(EqualityDeleteActionBuilder & expressionInputs) const;
+    DB::SetPtr readDeleteSet() const;
 };
 
 }
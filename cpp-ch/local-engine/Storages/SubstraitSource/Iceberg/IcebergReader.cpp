@@ -49,22 +49,28 @@ std::unique_ptr<IcebergReader> IcebergReader::create(
 
     /// Load POSITION_DELETES
     const auto it_pos = partitions.find(IcebergReadOptions::POSITION_DELETES);
-    std::unique_ptr<DeltaDVRoaringBitmapArray> delete_bitmap_array;
+    DeletionBitmapPtr delete_bitmap_array;
     if (it_pos != partitions.end())
         delete_bitmap_array
             = createBitmapExpr(context, file_->getFileSchema(), file_->getFileInfo(), delete_files, it_pos->second, new_header);
 
     /// Load EQUALITY_DELETES
     const auto it_equal = partitions.find(IcebergReadOptions::EQUALITY_DELETES);
-    ExpressionActionsPtr delete_expr = it_equal == partitions.end()
+    std::unique_ptr<EqualityDeleteFilter> delete_filter = it_equal == partitions.end()
         ? nullptr
-        : EqualityDeleteFileReader::createDeleteExpr(context, file_->getFileSchema(), delete_files, it_equal->second, new_header);
+        : EqualityDeleteFileReader::createDeleteFilter(context, file_->getFileSchema(), delete_files, it_equal->second, new_header);
 
     auto input = input_format_callback(new_header);
     if (!input)
         return nullptr;
     return std::make_unique<IcebergReader>(
-        file_, new_header, output_header_, input, delete_expr, std::move(delete_bitmap_array), to_read_header_.columns());
+        file_,
+        new_header,
+        output_header_,
+        input,
+        std::move(delete_filter),
+        std::move(delete_bitmap_array),
+        to_read_header_.columns());
 }
 
 IcebergReader::IcebergReader(
@@ -72,12 +78,12 @@ IcebergReader::IcebergReader(
     const Block & to_read_header_,
     const Block & output_header_,
     const FormatFile::InputFormatPtr & input_format_,
-    const ExpressionActionsPtr & delete_expr_,
-    std::unique_ptr<DeltaDVRoaringBitmapArray> delete_bitmap_array_,
+    std::unique_ptr<EqualityDeleteFilter> delete_filter_,
+    DeletionBitmapPtr delete_bitmap_array_,
     size_t start_remove_index_)
     : NormalFileReader(file_, to_read_header_, output_header_, input_format_)
-    , delete_expr(delete_expr_)
-    , delete_expr_column_name(EqualityDeleteActionBuilder::COLUMN_NAME)
+    , delete_filter(std::move(delete_filter_))
+    , delete_expr_column_name(EqualityDeleteFilter::COLUMN_NAME)
     , delete_bitmap_array(std::move(delete_bitmap_array_))
     , start_remove_index(start_remove_index_)
 {
@@ -89,7 +95,7 @@ IcebergReader::~IcebergReader() = default;
 
 Chunk IcebergReader::doPull()
 {
-    if (!delete_expr && !delete_bitmap_array)
+    if (!delete_filter && !delete_bitmap_array)
         return NormalFileReader::doPull();
 
     while (true)
@@ -99,12 +105,12 @@ Chunk IcebergReader::doPull()
             return chunk;
 
         Block deleted_block;
-        if (delete_expr)
+        if (delete_filter)
             deleted_block = applyEqualityDelete(chunk);
 
         if (delete_bitmap_array)
         {
-            if (!delete_expr)
+            if (!delete_filter)
             {
                 auto delete_mask = ColumnUInt8::create(chunk.getNumRows(), 1);
                 deleted_block = readHeader.cloneWithColumns(chunk.detachColumns());
@@ -132,12 +138,9 @@ Chunk IcebergReader::doPull()
 
 Block IcebergReader::applyEqualityDelete(Chunk & chunk) const
 {
-    assert(delete_expr);
-    assert(!delete_expr_column_name.empty());
-    size_t num_rows_before_filtration = chunk.getNumRows();
-    auto columns = chunk.detachColumns();
-    Block block = readHeader.cloneWithColumns(columns);
-    delete_expr->execute(block, num_rows_before_filtration);
+    assert(delete_filter);
+    Block block = readHeader.cloneWithColumns(chunk.detachColumns());
+    delete_filter->execute(block);
     return block;
 }
 
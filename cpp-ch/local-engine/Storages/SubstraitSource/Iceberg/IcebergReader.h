@@ -18,24 +18,21 @@
 
 #include <Storages/SubstraitSource/FileReader.h>
 
-namespace DB
-{
-class ExpressionActions;
-using ExpressionActionsPtr = std::shared_ptr<ExpressionActions>;
-}
-
 namespace local_engine
 {
 class DeltaDVRoaringBitmapArray;
+using DeletionBitmapPtr = std::shared_ptr<const DeltaDVRoaringBitmapArray>;
 }
 
 namespace local_engine::iceberg
 {
+class EqualityDeleteFilter;
+
 class IcebergReader final : public NormalFileReader
 {
-    DB::ExpressionActionsPtr delete_expr;
+    std::unique_ptr<EqualityDeleteFilter> delete_filter;
     const std::string delete_expr_column_name;
-    std::unique_ptr<DeltaDVRoaringBitmapArray> delete_bitmap_array;
+    DeletionBitmapPtr delete_bitmap_array;
     size_t start_remove_index;
 
 public:
@@ -50,8 +47,8 @@ public:
         const DB::Block & to_read_header_,
         const DB::Block & output_header_,
         const FormatFile::InputFormatPtr & input_format_,
-        const DB::ExpressionActionsPtr & delete_expr_,
-        std::unique_ptr<DeltaDVRoaringBitmapArray> delete_bitmap_array_,
+        std::unique_ptr<EqualityDeleteFilter> delete_filter_,
+        DeletionBitmapPtr delete_bitmap_array_,
         size_t start_remove_index_);
 
     ~IcebergReader() override;
@@ -19,9 +19,10 @@
 
 #include <Functions/FunctionFactory.h>
 #include <Storages/Parquet/ParquetMeta.h>
-#include <Storages/SubstraitSource/Delta/Bitmap/DeltaDVRoaringBitmapArray.h>
+#include <Storages/SubstraitSource/Delta/Bitmap/DeletionBitmapCache.h>
 #include <Storages/SubstraitSource/Iceberg/IcebergMetadataColumn.h>
 #include <Storages/SubstraitSource/Iceberg/SimpleParquetReader.h>
+#include <fmt/format.h>
 #include <Common/BlockTypeUtils.h>
 
 using namespace DB;
@@ -31,7 +32,55 @@ namespace local_engine::iceberg
 
 using namespace google::protobuf;
 
-std::unique_ptr<DeltaDVRoaringBitmapArray> createBitmapExpr(
+namespace
+{
+/// The positions in `delete_file` of the rows deleted from `data_file`.
+DeletionBitmapPtr readDeletePositions(
+    const ContextPtr & context, const SubstraitInputFile & data_file, const SubstraitIcebergDeleteFile & delete_file)
+{
+    ActionsDAG actions_dag{IcebergMetadataColumn::getNamesAndTypesList()};
+    ActionsDAG::NodeRawConstPtrs filter_node;
+    {
+        ActionsDAG & actions = actions_dag;
+        const std::string Equal{"equals"};
+        auto equalBuilder = FunctionFactory::instance().get(Equal, context);
+
+        ActionsDAG::NodeRawConstPtrs args;
+        args.push_back(&actions.findInOutputs(IcebergMetadataColumn::icebergDeleteFilePathColumn()->name));
+        args.push_back(&actions.addColumn(createColumnConst<std::string>(1, data_file.uri_file(), "_")));
+        filter_node.push_back(&actions.addFunction(equalBuilder, std::move(args), "__"));
+    }
+
+    auto filter = ActionsDAG::buildFilterActionsDAG(filter_node);
+
+    // Block header{{{IcebergMetadataColumn::icebergDeletePosColumn()->type, IcebergMetadataColumn::icebergDeletePosColumn()->name}}};
+    Block header{
+        {{IcebergMetadataColumn::icebergDeleteFilePathColumn()->type, IcebergMetadataColumn::icebergDeleteFilePathColumn()->name},
+         {IcebergMetadataColumn::icebergDeletePosColumn()->type, IcebergMetadataColumn::icebergDeletePosColumn()->name}}};
+
+    SimpleParquetReader reader{context, delete_file, std::move(header), filter};
+    Block deleteBlock = reader.next();
+
+    auto result = std::make_shared<DeltaDVRoaringBitmapArray>();
+    while (deleteBlock.rows() > 0)
+    {
+        assert(deleteBlock.columns() == 2);
+        const auto * pos_column = typeid_cast<const ColumnInt64 *>(deleteBlock.getByPosition(1).column.get());
+        if (pos_column == nullptr)
+            throw Exception(ErrorCodes::LOGICAL_ERROR, "Expected ColumnInt64 for position deletes");
+
+        const ColumnInt64::Container & vec = pos_column->getData();
+        const Int64 * pos = vec.data();
+        for (int i = 0; i < deleteBlock.rows(); i++)
+            result->rb_add(pos[i]);
+
+        deleteBlock = reader.next();
+    }
+    return result;
+}
+}
+
+DeletionBitmapPtr createBitmapExpr(
     const ContextPtr & context,
     const Block & /*data_file_header*/,
     const SubstraitInputFile & file_,
@@ -41,8 +90,8 @@ std::unique_ptr<DeltaDVRoaringBitmapArray> createBitmapExpr(
 {
     assert(!position_delete_files.empty());
 
-    std::unique_ptr<DeltaDVRoaringBitmapArray> result = std::make_unique<DeltaDVRoaringBitmapArray>();
-
+    /// A positional delete file may cover many data files, so the positions are cached per data file.
+    std::vector<DeletionBitmapPtr> bitmaps;
     for (auto deleteIndex : position_delete_files)
     {
         const auto & delete_file = delete_files[deleteIndex];
@@ -50,51 +99,30 @@ std::unique_ptr<DeltaDVRoaringBitmapArray> createBitmapExpr(
         if (delete_file.recordcount() == 0)
             continue;
 
-        ActionsDAG actions_dag{IcebergMetadataColumn::getNamesAndTypesList()};
-        ActionsDAG::NodeRawConstPtrs filter_node;
-        {
-            ActionsDAG & actions = actions_dag;
-            const std::string Equal{"equals"};
-            auto equalBuilder = FunctionFactory::instance().get(Equal, context);
-
-            ActionsDAG::NodeRawConstPtrs args;
-            args.push_back(&actions.findInOutputs(IcebergMetadataColumn::icebergDeleteFilePathColumn()->name));
-            args.push_back(&actions.addColumn(createColumnConst<std::string>(1, file_.uri_file(), "_")));
-            filter_node.push_back(&actions.addFunction(equalBuilder, std::move(args), "__"));
-        }
-
-        auto filter = ActionsDAG::buildFilterActionsDAG(filter_node);
-
-        // Block header{{{IcebergMetadataColumn::icebergDeletePosColumn()->type, IcebergMetadataColumn::icebergDeletePosColumn()->name}}};
-        Block header{
-            {{IcebergMetadataColumn::icebergDeleteFilePathColumn()->type, IcebergMetadataColumn::icebergDeleteFilePathColumn()->name},
-             {IcebergMetadataColumn::icebergDeletePosColumn()->type, IcebergMetadataColumn::icebergDeletePosColumn()->name}}};
-
-        SimpleParquetReader reader{context, delete_file, std::move(header), filter};
-        Block deleteBlock = reader.next();
-
-        while (deleteBlock.rows() > 0)
-        {
-            assert(deleteBlock.columns() == 2);
-            const auto * pos_column = typeid_cast<const ColumnInt64 *>(deleteBlock.getByPosition(1).column.get());
-            if (pos_column == nullptr)
-                throw Exception(ErrorCodes::LOGICAL_ERROR, "Expected ColumnInt64 for position deletes");
-
-            const ColumnInt64::Container & vec = pos_column->getData();
-            const Int64 * pos = vec.data();
-            for (int i = 0; i < deleteBlock.rows(); i++)
-                result->rb_add(pos[i]);
-
-            deleteBlock = reader.next();
-        }
+        auto bitmap = DeletionBitmapCache::instance().getOrLoad(
+            fmt::format("iceberg:{}:{}#{}", delete_file.filepath(), delete_file.filesize(), file_.uri_file()),
+            [&] { return readDeletePositions(context, file_, delete_file); });
+        if (!bitmap->rb_is_empty())
+            bitmaps.push_back(std::move(bitmap));
     }
 
-    if (result->rb_is_empty())
+    if (bitmaps.empty())
         return nullptr;
 
+    DeletionBitmapPtr result;
+    if (bitmaps.size() == 1)
+        result = std::move(bitmaps.front());
+    else
+    {
+        auto merged = std::make_shared<DeltaDVRoaringBitmapArray>();
+        for (const auto & bitmap : bitmaps)
+            merged->rb_or(*bitmap);
+        result = std::move(merged);
+    }
+
     if (!ParquetVirtualMeta::hasMetaColumns(reader_header))
         reader_header.insert({BIGINT(), ParquetVirtualMeta::TMP_ROWINDEX});
-    return std::move(result);
+    return result;
 }
 
-}
\ No newline at end of file
+}
@@ -21,6 +21,7 @@
 namespace local_engine
 {
 class DeltaDVRoaringBitmapArray;
+using DeletionBitmapPtr = std::shared_ptr<const DeltaDVRoaringBitmapArray>;
 }
 namespace local_engine::iceberg
 {
@@ -39,10 +40,10 @@ namespace local_engine::iceberg
  * @param delete_files A list of delete files.
  * @param position_delete_files Indices of the delete files that are positional deletes.
  * @param reader_header The block header for the reader, which may be modified if it doesn't contain row index.
- * @return A unique pointer to a DeltaDVRoaringBitmapArray containing the deleted positions,
+ * @return A DeltaDVRoaringBitmapArray containing the deleted positions, shared through the DeletionBitmapCache,
  *         or nullptr if no positions are deleted.
  */
-std::unique_ptr<DeltaDVRoaringBitmapArray> createBitmapExpr(
+DeletionBitmapPtr createBitmapExpr(
     const DB::ContextPtr & context,
     const DB::Block & data_file_header,
     const SubstraitInputFile & file_,
@@ -31,6 +31,7 @@
 #include <Storages/Parquet/VirtualColumnRowIndexReader.h>
 #include <Storages/SubstraitSource/Delta/DeltaMeta.h>
 #include <Common/BlockTypeUtils.h>
+#include <Common/GlutenConfig.h>
 #include <Common/logger_useful.h>
 
 namespace DB
@@ -66,9 +67,21 @@ struct ShouldIncludeRowGroup
 
 namespace
 {
+/// Files without a modification time or size can't be told apart from a rewritten version, so they are not cached.
+std::optional<ParquetFileKey> parquetFileKey(const SubstraitInputFile & file_info)
+{
+    if (!file_info.has_properties() || file_info.properties().modificationtime() <= 0 || file_info.properties().filesize() <= 0)
+        return std::nullopt;
+    return ParquetFileKey{
+        .path = file_info.uri_file(),
+        .modification_time = file_info.properties().modificationtime(),
+        .file_size = static_cast<UInt64>(file_info.properties().filesize())};
+}
+
 ParquetMetaBuilder collectRequiredRowGroups(ReadBuffer & read_buffer, const SubstraitInputFile & file_info)
 {
     ParquetMetaBuilder result;
+    result.fileKey = parquetFileKey(file_info);
     ShouldIncludeRowGroup should_include_row_group{file_info};
     result.build(read_buffer, should_include_row_group);
     return result;
@@ -166,6 +179,8 @@ ParquetFormatFile::createInputFormat(const Block & header, const std::shared_ptr
         .case_insensitive = format_settings.parquet.case_insensitive_column_matching,
         .allow_missing_columns = format_settings.parquet.allow_missing_columns};
 
+    metaBuilder.fileKey = parquetFileKey(file_info);
+
     ShouldIncludeRowGroup should_include_row_group{file_info};
     if (auto * seekable_in = dynamic_cast<SeekableReadBuffer *>(read_buffer_.get()))
     {
@@ -194,7 +209,14 @@ ParquetFormatFile::createInputFormat(const Block & header, const std::shared_ptr
 
     auto createVectorizedFormat = [&]() -> InputFormatPtr
     {
-        auto input = std::make_shared<VectorizedParquetBlockInputFormat>(*read_buffer_, read_header, *provider, format_settings);
+        const auto decode_config = ParquetDecodeConfig::loadFromContext(context);
+        auto input = std::make_shared<VectorizedParquetBlockInputFormat>(
+            *read_buffer_,
+            read_header,
+            *provider,
+            format_settings,
+            decode_config.parquet_decode_threads,
+            decode_config.parquet_decode_memory_budget);
         return std::make_shared<ParquetInputFormat>(std::move(read_buffer_), input, std::move(provider), *read_header, header, max_block_size);
     };
 
@@ -17,7 +17,9 @@
 
 #include "config.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <Core/Settings.h>
 #include <Disks/IO/AsynchronousBoundedReadBuffer.h>
@@ -50,6 +52,7 @@
 #include <Common/CHUtil.h>
 #include <Common/GlutenConfig.h>
 #include <Common/GlutenSettings.h>
+#include <Common/Stopwatch.h>
 #include <Common/logger_useful.h>
 #include <Common/safe_cast.h>
 #include <Common/setThreadName.h>
@@ -194,6 +197,93 @@ static std::pair<size_t, size_t> getAdjustedReadRange(SeekableReadBuffer & buffe
     return result;
 }
 
+/// The whole content of a small remote file, read in one request. It stands in for the remote buffer, so it is seekable
+/// and knows the file size.
+class ReadBufferFromWholeFile : public DB::ReadBufferFromFileBase
+{
+public:
+    ReadBufferFromWholeFile(const String & file_name_, String data_)
+        : DB::ReadBufferFromFileBase(0, nullptr, 0, data_.size()), file_name(file_name_), data(std::move(data_))
+    {
+        BufferBase::set(data.data(), data.size(), 0);
+    }
+
+    std::string getFileName() const override { return file_name; }
+
+    off_t getPosition() override { return pos - internal_buffer.begin(); }
+
+    off_t seek(off_t off, int whence) override
+    {
+        off_t new_pos;
+        if (whence == SEEK_SET)
+            new_pos = off;
+        else if (whence == SEEK_CUR)
+            new_pos = getPosition() + off;
+        else
+            throw DB::Exception(DB::ErrorCodes::CANNOT_SEEK_THROUGH_FILE, "Only SEEK_SET and SEEK_CUR seek modes allowed.");
+
+        if (new_pos < 0 || static_cast<size_t>(new_pos) > data.size())
+            throw DB::Exception(
+                DB::ErrorCodes::CANNOT_SEEK_THROUGH_FILE,
+                "Seek position {} is out of bounds of file {} of size {}",
+                new_pos,
+                file_name,
+                data.size());
+
+        /// Reading up to the end resets the working buffer, restore it.
+        working_buffer = internal_buffer;
+        pos = internal_buffer.begin() + new_pos;
+        return new_pos;
+    }
+
+private:
+    const String file_name;
+    String data;
+};
+
+static std::atomic<size_t> whole_file_reads{0};
+static std::atomic<size_t> whole_file_read_bytes{0};
+
+bool ReadBufferBuilder::shouldReadWholeFile(
+    const substrait::ReadRel::LocalFiles::FileOrFiles & file_info, std::optional<size_t> file_size, size_t small_file_threshold)
+{
+    if (!file_info.has_parquet() && !file_info.has_orc())
+        return false;
+    if (!file_size || *file_size == 0 || *file_size > small_file_threshold)
+        return false;
+    /// A split of part of the file only reads the row groups or stripes starting in it.
+    return file_info.start() == 0 && file_info.length() >= *file_size;
+}
+
+std::unique_ptr<SeekableReadBuffer> ReadBufferBuilder::readWholeFile(
+    std::unique_ptr<SeekableReadBuffer> read_buffer, const substrait::ReadRel::LocalFiles::FileOrFiles & file_info, size_t file_size)
+{
+    Stopwatch watch;
+    String data(file_size, '\0');
+    read_buffer->setReadUntilPosition(file_size);
+    read_buffer->seek(0, SEEK_SET);
+    read_buffer->readStrict(data.data(), file_size);
+    whole_file_reads.fetch_add(1, std::memory_order_relaxed);
+    whole_file_read_bytes.fetch_add(file_size, std::memory_order_relaxed);
+    LOG_DEBUG(
+        getLogger("ReadBufferBuilder"),
+        "Read small file {} of {} bytes in one request in {} ms",
+        file_info.uri_file(),
+        file_size,
+        watch.elapsedMilliseconds());
+    return std::make_unique<ReadBufferFromWholeFile>(file_info.uri_file(), std::move(data));
+}
+
+size_t ReadBufferBuilder::wholeFileReads()
+{
+    return whole_file_reads.load(std::memory_order_relaxed);
+}
+
+size_t ReadBufferBuilder::wholeFileReadBytes()
+{
+    return whole_file_read_bytes.load(std::memory_order_relaxed);
+}
+
 static std::unique_ptr<SeekableReadBuffer>
 adjustReadRangeIfNeeded(std::unique_ptr<SeekableReadBuffer> read_buffer, const substrait::ReadRel::LocalFiles::FileOrFiles & file_info)
 {
@@ -359,6 +449,9 @@ public:
             read_buffer = std::move(cache_hdfs_read);
         }
 
+        if (shouldReadWholeFile(file_info, file_size, FileSourceConfig::loadFromContext(context).small_file_threshold))
+            return readWholeFile(std::move(read_buffer), file_info, *file_size);
+
         return adjustReadRangeIfNeeded(std::move(read_buffer), file_info);
     }
 
@@ -446,6 +539,9 @@ public:
             buffer_size = std::min(object_size, buffer_size);
         auto async_reader = std::make_unique<DB::AsynchronousBoundedReadBuffer>(
             std::move(s3_impl), pool_reader, read_settings, buffer_size, read_settings.remote_read_min_bytes_for_seek);
+        if (shouldReadWholeFile(file_info, object_size, FileSourceConfig::loadFromContext(context).small_file_threshold))
+            return readWholeFile(std::move(async_reader), file_info, object_size);
+
         if (read_settings.remote_fs_prefetch)
             async_reader->prefetch(Priority{});
 
@@ -647,10 +743,13 @@ public:
     }
 
 private:
+    /// SubstraitFileSource may open several files at once.
+    std::mutex client_mutex;
     std::shared_ptr<DB::AzureBlobStorage::ContainerClient> shared_client;
 
     std::shared_ptr<DB::AzureBlobStorage::ContainerClient> getClient()
     {
+        std::lock_guard lock(client_mutex);
         if (shared_client)
             return shared_client;
 
@@ -22,6 +22,7 @@
 #include <IO/CompressionMethod.h>
 #include <IO/ReadBuffer.h>
 #include <IO/ReadBufferFromFileBase.h>
+#include <IO/SeekableReadBuffer.h>
 #include <substrait/plan.pb.h>
 #include <Common/FileCacheConcurrentMap.h>
 
@@ -45,6 +46,20 @@ public:
     /// build a new read buffer, consider compression method
     std::unique_ptr<DB::ReadBuffer> buildWithCompressionWrapper(const substrait::ReadRel::LocalFiles::FileOrFiles & file_info);
 
+    /// Parquet and ORC readers fetch the footer first and then the column chunks, each in its own request. For small
+    /// remote files the round trips cost more than the bytes, so a split covering a whole Parquet or ORC file of at most
+    /// small_file_threshold bytes reads it at once. It fetches the columns that are not read too, so it is off by default.
+    static bool shouldReadWholeFile(
+        const substrait::ReadRel::LocalFiles::FileOrFiles & file_info, std::optional<size_t> file_size, size_t small_file_threshold);
+    static std::unique_ptr<DB::SeekableReadBuffer> readWholeFile(
+        std::unique_ptr<DB::SeekableReadBuffer> read_buffer,
+        const substrait::ReadRel::LocalFiles::FileOrFiles & file_info,
+        size_t file_size);
+
+    /// Files and bytes read by readWholeFile in this process.
+    static size_t wholeFileReads();
+    static size_t wholeFileReadBytes();
+
 protected:
     using ReadBufferCreator = std::function<std::unique_ptr<DB::ReadBufferFromFileBase>(bool restricted_seek, const DB::StoredObject & object)>;
 
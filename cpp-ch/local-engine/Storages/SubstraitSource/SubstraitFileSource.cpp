@@ -21,6 +21,10 @@
 #include <Storages/SubstraitSource/FormatFile.h>
 #include <Poco/URI.h>
 #include <Common/CHUtil.h>
+#include <Common/LocalThreadPools.h>
+#include <Common/Stopwatch.h>
+#include <Common/logger_useful.h>
+#include <Common/setThreadName.h>
 
 namespace local_engine
 {
@@ -54,14 +58,40 @@ static DB::Block initReadHeader(const DB::Block & block, const FormatFiles & fil
 
 SubstraitFileSource::SubstraitFileSource(
     const DB::ContextPtr & context_, const DB::Block & outputHeader_, const substrait::ReadRel::LocalFiles & file_infos)
+    : SubstraitFileSource(context_, outputHeader_, file_infos, FileSourceConfig::loadFromContext(context_))
+{
+}
+
+SubstraitFileSource::SubstraitFileSource(
+    const DB::ContextPtr & context_,
+    const DB::Block & outputHeader_,
+    const substrait::ReadRel::LocalFiles & file_infos,
+    const FileSourceConfig & config_)
     : DB::ISource(toShared(BaseReader::buildRowCountHeader(outputHeader_)), false)
     , files(initializeFiles(file_infos, context_))
     , outputHeader(outputHeader_)
     , readHeader(initReadHeader(outputHeader, files))
+    , config(config_)
 {
+    /// The read buffers of the opened files schedule on the IO thread pool, so the prefetches must not wait on it.
+    if (config.parallel_read_files > 1 && files.size() > 1)
+        prefetch_runner
+            = DB::threadPoolCallbackRunnerUnsafe<PrefetchedFile>(LocalThreadPools::fileSourcePrefetch(), ThreadName::PARALLEL_READ);
 }
 
-SubstraitFileSource::~SubstraitFileSource() = default;
+SubstraitFileSource::~SubstraitFileSource()
+{
+    /// The prefetches refer to this source.
+    for (auto & future : prefetching)
+        future.wait();
+    if (prefetch_stats.files)
+        LOG_DEBUG(
+            getLogger("SubstraitFileSource"),
+            "Opened {} files ahead in {} us, waited {} us for them",
+            prefetch_stats.files,
+            prefetch_stats.open_microseconds,
+            prefetch_stats.wait_microseconds);
+}
 
 void SubstraitFileSource::setKeyCondition(const std::shared_ptr<const DB::ActionsDAG> & filter_actions_dag_, DB::ContextPtr context_)
 {
@@ -81,14 +111,37 @@ DB::Chunk SubstraitFileSource::generate()
         }
 
         DB::Chunk chunk;
-        if (file_reader->pull(chunk))
-            return chunk;
-
-        /// try to read from next file
-        file_reader.reset();
+        if (pending_chunk)
+        {
+            chunk = std::move(*pending_chunk);
+            pending_chunk.reset();
+        }
+        else if (!file_reader->pull(chunk))
+        {
+            /// try to read from next file
+            finishFile();
+            continue;
+        }
+        current_rows += chunk.getNumRows();
+        return chunk;
     }
 }
 
+void SubstraitFileSource::finishFile()
+{
+    file_reader.reset();
+    if (current_file)
+        LOG_DEBUG(
+            getLogger("SubstraitFileSource"),
+            "Read {} rows from {}, open took {} us, waited {} us for it",
+            current_rows,
+            current_file->getURIPath(),
+            current_open_microseconds,
+            current_wait_microseconds);
+    current_file.reset();
+    current_open_microseconds = current_wait_microseconds = current_rows = 0;
+}
+
 bool SubstraitFileSource::tryPrepareReader()
 {
     if (isCancelled())
@@ -97,26 +150,127 @@ bool SubstraitFileSource::tryPrepareReader()
     if (file_reader)
         return true;
 
+    if (prefetch_runner)
+        return tryTakePrefetchedReader();
+
     while (current_file_index < files.size())
     {
-        auto current_file = files[current_file_index];
+        auto next_file = files[current_file_index];
         current_file_index += 1;
         /// For the files do not support split strategy, the task with not 0 offset will generate empty data
-        if (!current_file->supportSplit() && current_file->getStartOffset())
+        if (!next_file->supportSplit() && next_file->getStartOffset())
             continue;
 
-        file_reader = BaseReader::create(current_file, readHeader, outputHeader, filter_actions_dag, column_index_filter);
+        Stopwatch watch;
+        file_reader = BaseReader::create(next_file, readHeader, outputHeader, filter_actions_dag, column_index_filter);
         if (file_reader)
+        {
+            current_file = next_file;
+            current_open_microseconds = current_wait_microseconds = watch.elapsedMicroseconds();
             return true;
+        }
     }
     return false;
 }
 
+void SubstraitFileSource::schedulePrefetches()
+{
+    while (prefetching.size() < config.parallel_read_files && current_file_index < files.size())
+    {
+        auto next_file = files[current_file_index];
+        current_file_index += 1;
+        /// For the files do not support split strategy, the task with not 0 offset will generate empty data
+        if (!next_file->supportSplit() && next_file->getStartOffset())
+            continue;
+        prefetching.emplace_back(prefetch_runner([this, next_file] { return prefetchFile(next_file); }, Priority{}));
+    }
+}
+
+SubstraitFileSource::PrefetchedFile SubstraitFileSource::prefetchFile(const FormatFilePtr & file)
+{
+    PrefetchedFile result{.file = file};
+    if (isCancelled())
+        return result;
+
+    Stopwatch watch;
+    result.reader = BaseReader::create(file, readHeader, outputHeader, filter_actions_dag, column_index_filter);
+    if (result.reader)
+    {
+        {
+            std::lock_guard lock(prefetched_readers_mutex);
+            prefetched_readers.insert(result.reader.get());
+        }
+        /// onCancel may have run before the reader was registered.
+        if (isCancelled())
+            result.reader->cancel();
+
+        DB::Chunk chunk;
+        if (result.reader->pull(chunk))
+            result.first_chunk = std::move(chunk);
+        else
+        {
+            releasePrefetchedReader(result.reader.get());
+            result.reader.reset();
+        }
+    }
+    result.open_microseconds = watch.elapsedMicroseconds();
+    return result;
+}
+
+void SubstraitFileSource::releasePrefetchedReader(BaseReader * reader)
+{
+    std::lock_guard lock(prefetched_readers_mutex);
+    prefetched_readers.erase(reader);
+}
+
+bool SubstraitFileSource::tryTakePrefetchedReader()
+{
+    while (true)
+    {
+        schedulePrefetches();
+        if (prefetching.empty() || isCancelled())
+            return false;
+
+        auto ready = prefetching.begin();
+        if (!config.preserve_file_order)
+        {
+            auto it = std::ranges::find_if(
+                prefetching, [](const auto & future) { return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; });
+            if (it != prefetching.end())
+                ready = it;
+        }
+        auto future = std::move(*ready);
+        prefetching.erase(ready);
+
+        Stopwatch watch;
+        auto prefetched = future.get();
+        const UInt64 wait_microseconds = watch.elapsedMicroseconds();
+        prefetch_stats.files += 1;
+        prefetch_stats.open_microseconds += prefetched.open_microseconds;
+        prefetch_stats.wait_microseconds += wait_microseconds;
+        if (!prefetched.reader)
+            continue;
+
+        releasePrefetchedReader(prefetched.reader.get());
+        file_reader = std::move(prefetched.reader);
+        pending_chunk = std::move(prefetched.first_chunk);
+        current_file = prefetched.file;
+        current_open_microseconds = prefetched.open_microseconds;
+        current_wait_microseconds = wait_microseconds;
+        /// Open the next files while this one is read.
+        schedulePrefetches();
+        return true;
+    }
+}
+
 
 void SubstraitFileSource::onCancel() noexcept
 {
     if (file_reader)
         file_reader->cancel();
+    std::lock_guard lock(prefetched_readers_mutex);
+    for (auto * reader : prefetched_readers)
+        reader->cancel();
 }
 
 }
@@ -16,10 +16,16 @@
  */
 #pragma once
 
+#include <deque>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <unordered_set>
 #include <Interpreters/Context_fwd.h>
 #include <Processors/ISource.h>
 #include <substrait/algebra.pb.h>
+#include <Common/GlutenConfig.h>
+#include <Common/threadPoolCallbackRunner.h>
 
 namespace DB
 {
@@ -35,21 +41,58 @@ class FormatFile;
 using FormatFilePtr = std::shared_ptr<FormatFile>;
 using FormatFiles = std::vector<FormatFilePtr>;
 
+/// Reads the files of a split one after another.
+///
+/// With file_source_parallel_read_files = N > 1, up to N files after the current one are opened, and their first chunk
+/// read, on LocalThreadPools::fileSourcePrefetch() while the current one is read, which hides the open and footer latency
+/// of splits made of many small files. The prefetch pool is not the IO thread pool, which the opened read buffers use
+/// themselves. The files are returned in split order, unless file_source_preserve_file_order is off, in which case the
+/// first one that is ready comes next.
 class SubstraitFileSource : public DB::ISource
 {
 public:
+    /// Counters of the files opened ahead.
+    struct PrefetchStats
+    {
+        size_t files = 0;
+        UInt64 open_microseconds = 0;
+        /// Time generate() waited for a file that was still being opened.
+        UInt64 wait_microseconds = 0;
+    };
+
     SubstraitFileSource(const DB::ContextPtr & context_, const DB::Block & header_, const substrait::ReadRel::LocalFiles & file_infos);
+    SubstraitFileSource(
+        const DB::ContextPtr & context_,
+        const DB::Block & header_,
+        const substrait::ReadRel::LocalFiles & file_infos,
+        const FileSourceConfig & config_);
     ~SubstraitFileSource() override;
 
     String getName() const override { return "SubstraitFileSource"; }
 
     void setKeyCondition(const std::shared_ptr<const DB::ActionsDAG> & filter_actions_dag_, DB::ContextPtr context_);
 
+    const PrefetchStats & getPrefetchStats() const { return prefetch_stats; }
+
 protected:
     DB::Chunk generate() override;
 
 private:
+    /// A file opened ahead, with its first chunk. The reader is null if the file has no data.
+    struct PrefetchedFile
+    {
+        FormatFilePtr file;
+        std::unique_ptr<BaseReader> reader;
+        std::optional<DB::Chunk> first_chunk;
+        UInt64 open_microseconds = 0;
+    };
+
     bool tryPrepareReader();
+    bool tryTakePrefetchedReader();
+    void schedulePrefetches();
+    PrefetchedFile prefetchFile(const FormatFilePtr & file);
+    void releasePrefetchedReader(BaseReader * reader);
+    void finishFile();
     void onCancel() noexcept override;
     FormatFiles files;
 
@@ -61,5 +104,21 @@ private:
     std::unique_ptr<BaseReader> file_reader;
     ColumnIndexFilterPtr column_index_filter;
     std::shared_ptr<const DB::ActionsDAG> filter_actions_dag;
+
+    const FileSourceConfig config;
+    DB::ThreadPoolCallbackRunnerUnsafe<PrefetchedFile> prefetch_runner;
+    std::deque<std::future<PrefetchedFile>> prefetching;
+    std::optional<DB::Chunk> pending_chunk;
+    PrefetchStats prefetch_stats;
+
+    /// Readers opened by prefetches that generate() has not taken yet, cancelled by onCancel.
+    std::mutex prefetched_readers_mutex;
+    std::unordered_set<BaseReader *> prefetched_readers;
+
+    /// Metrics of the file being read, logged when it is finished.
+    FormatFilePtr current_file;
+    UInt64 current_open_microseconds = 0;
+    UInt64 current_wait_microseconds = 0;
+    UInt64 current_rows = 0;
 };
 }
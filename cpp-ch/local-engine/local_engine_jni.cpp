@@ -41,6 +41,7 @@
 #include <Shuffle/SparkExchangeSink.h>
 #include <Shuffle/WriteBufferFromJavaOutputStream.h>
 #include <Storages/Cache/CacheManager.h>
+#include <Storages/IO/PipelinedCompressedReadBuffer.h>
 #include <Storages/MergeTree/MetaDataHelper.h>
 #include <Storages/MergeTree/SparkMergeTreeWriteSettings.h>
 #include <Storages/MergeTree/SparkMergeTreeWriter.h>
@@ -57,6 +58,7 @@
 #include <Common/CHUtil.h>
 #include <Common/ErrorCodes.h>
 #include <Common/ExceptionUtils.h>
+#include <Common/GlutenConfig.h>
 #include <Common/JNIUtils.h>
 #include <Common/QueryContext.h>
 
@@ -711,6 +713,7 @@ JNIEXPORT jlong Java_org_apache_gluten_vectorized_CHShuffleSplitterJniWrapper_na
     std::vector<std::string> local_dirs_list;
     local_dirs_list.insert(local_dirs_list.end(), local_dirs_tokenizer.begin(), local_dirs_tokenizer.end());
 
+    const auto shuffle_config = local_engine::ShuffleConfig::loadFromContext(local_engine::QueryContext::globalContext());
     local_engine::SplitOptions options{
         .split_size = static_cast<size_t>(split_size),
         .io_buffer_size = DB::DBMS_DEFAULT_BUFFER_SIZE,
@@ -724,6 +727,7 @@ JNIEXPORT jlong Java_org_apache_gluten_vectorized_CHShuffleSplitterJniWrapper_na
         .out_exprs = out_exprs,
         .compress_method = jstring2string(env, codec),
         .compress_level = compress_level < 0 ? std::nullopt : std::optional<int>(compress_level),
+        .compress_threads = shuffle_config.shuffle_compress_threads,
         .spill_threshold = static_cast<size_t>(spill_threshold),
         .hash_algorithm = jstring2string(env, hash_algorithm),
         .max_sort_buffer_size = static_cast<size_t>(max_sort_buffer_size),
@@ -769,6 +773,7 @@ JNIEXPORT jlong Java_org_apache_gluten_vectorized_CHShuffleSplitterJniWrapper_na
         out_exprs = std::string{reinterpret_cast<const char *>(out_expr_list_a.elems()), out_expr_list_size};
     }
 
+    const auto shuffle_config = local_engine::ShuffleConfig::loadFromContext(local_engine::QueryContext::globalContext());
     local_engine::SplitOptions options{
         .split_size = static_cast<size_t>(split_size),
         .io_buffer_size = DB::DBMS_DEFAULT_BUFFER_SIZE,
@@ -779,6 +784,7 @@ JNIEXPORT jlong Java_org_apache_gluten_vectorized_CHShuffleSplitterJniWrapper_na
         .out_exprs = out_exprs,
         .compress_method = jstring2string(env, codec),
         .compress_level = compress_level < 0 ? std::nullopt : std::optional<int>(compress_level),
+        .compress_threads = shuffle_config.shuffle_compress_threads,
         .spill_threshold = static_cast<size_t>(spill_threshold),
         .hash_algorithm = jstring2string(env, hash_algorithm),
         .force_memory_sort = static_cast<bool>(force_memory_sort)};
@@ -1141,11 +1147,21 @@ JNIEXPORT jlong Java_org_apache_gluten_vectorized_StorageJoinBuilder_nativeBuild
     std::string struct_string{reinterpret_cast<const char *>(named_struct_a.elems()), struct_size};
     const jsize length = env->GetArrayLength(in);
     local_engine::ReadBufferFromByteArray read_buffer_from_java_array(in, length);
-    DB::CompressedReadBuffer input(read_buffer_from_java_array);
-    local_engine::configureCompressedReadBuffer(input);
+    const auto query_context = local_engine::QueryContext::instance().currentQueryContext();
+    const auto decompress_threads = local_engine::JoinConfig::loadFromContext(query_context).broadcast_build_decompress_threads;
+    std::unique_ptr<DB::ReadBuffer> input;
+    if (decompress_threads)
+        input = std::make_unique<local_engine::PipelinedCompressedReadBuffer>(read_buffer_from_java_array, decompress_threads);
+    else
+    {
+        auto compressed_input = std::make_unique<DB::CompressedReadBuffer>(read_buffer_from_java_array);
+        local_engine::configureCompressedReadBuffer(*compressed_input);
+        input = std::move(compressed_input);
+    }
     const auto * obj = make_wrapper(local_engine::BroadcastJoinBuilder::buildJoin(
+        query_context,
         hash_table_id,
-        input,
+        *input,
         row_count_,
         join_key,
         join_type_,
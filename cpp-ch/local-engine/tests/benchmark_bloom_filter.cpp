@@ -0,0 +1,85 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <random>
+#include <Interpreters/BloomFilter.h>
+#include <benchmark/benchmark.h>
+#include <Common/PODArray.h>
+#include <Common/SplitBlockBloomFilter.h>
+
+using namespace DB;
+
+/// Filters of state.range(0) MiB with about 8 bits per key, probed with keys of which half were added.
+static constexpr size_t PROBE_ROWS = 65536;
+static constexpr size_t BITS_PER_KEY = 8;
+
+static std::vector<UInt64> createKeys(size_t num_keys, UInt64 seed)
+{
+    std::mt19937_64 rng(seed);
+    std::vector<UInt64> keys(num_keys);
+    for (auto & key : keys)
+        key = rng();
+    return keys;
+}
+
+static std::vector<UInt64> createProbeKeys(const std::vector<UInt64> & added)
+{
+    auto probe_keys = createKeys(PROBE_ROWS, 42);
+    for (size_t i = 0; i < PROBE_ROWS; i += 2)
+        probe_keys[i] = added[i % added.size()];
+    return probe_keys;
+}
+
+static void BM_ClassicBloomFilterFind(benchmark::State & state)
+{
+    const size_t filter_bytes = state.range(0) << 20;
+    const auto added = createKeys(filter_bytes * 8 / BITS_PER_KEY, 1);
+    /// Same number of hash functions as bloom_filter_agg would choose, (m / n) * ln(2).
+    BloomFilter filter(BloomFilterParameters(filter_bytes, 6, 0));
+    for (auto key : added)
+        filter.add(reinterpret_cast<const char *>(&key), sizeof(key));
+
+    const auto probe_keys = createProbeKeys(added);
+    PaddedPODArray<UInt8> result(PROBE_ROWS);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < PROBE_ROWS; ++i)
+            result[i] = filter.find(reinterpret_cast<const char *>(&probe_keys[i]), sizeof(UInt64));
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(state.iterations() * PROBE_ROWS);
+}
+
+static void BM_SplitBlockBloomFilterFind(benchmark::State & state)
+{
+    const size_t filter_bytes = state.range(0) << 20;
+    const auto added = createKeys(filter_bytes * 8 / BITS_PER_KEY, 1);
+    local_engine::SplitBlockBloomFilter filter(filter_bytes, 0);
+    for (auto key : added)
+        filter.add(key);
+
+    const auto probe_keys = createProbeKeys(added);
+    PaddedPODArray<UInt8> result(PROBE_ROWS);
+    for (auto _ : state)
+    {
+        filter.findBatch(probe_keys.data(), PROBE_ROWS, result.data());
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(state.iterations() * PROBE_ROWS);
+}
+
+BENCHMARK(BM_ClassicBloomFilterFind)->Arg(1)->Arg(16)->Arg(128)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SplitBlockBloomFilterFind)->Arg(1)->Arg(16)->Arg(128)->Unit(benchmark::kMicrosecond);
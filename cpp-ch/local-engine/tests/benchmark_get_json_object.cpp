@@ -0,0 +1,155 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <random>
+#include <Columns/ColumnString.h>
+#include <Core/Block.h>
+#include <DataTypes/DataTypeString.h>
+#include <Functions/FunctionFactory.h>
+#include <Functions/SparkFunctionGetJsonObject.h>
+#include <IO/WriteBufferFromString.h>
+#include <IO/WriteHelpers.h>
+#include <benchmark/benchmark.h>
+#include <Common/QueryContext.h>
+
+using namespace DB;
+
+/// Blocks of event payloads, of which state.range(0) are distinct, queried for the paths an event table typically
+/// projects together.
+static constexpr size_t ROWS = 8192;
+
+static const std::vector<String> EVENT_PATHS
+    = {"$.event_id",
+       "$.event_type",
+       "$.ts",
+       "$.user.id",
+       "$.user.country",
+       "$.user.tier",
+       "$.device.os",
+       "$.device.model",
+       "$.device.app_version",
+       "$.session.id",
+       "$.session.duration_ms",
+       "$.page.url",
+       "$.page.referrer",
+       "$.props.item_id",
+       "$.props.price",
+       "$.props.tags[0]"};
+
+static String createEvent(std::mt19937_64 & rng)
+{
+    static const char * event_types[] = {"view", "click", "add_to_cart", "purchase", "scroll"};
+    static const char * countries[] = {"US", "DE", "CN", "BR", "IN", "FR"};
+    static const char * oses[] = {"android", "ios", "windows", "macos"};
+    String event;
+    WriteBufferFromString out(event);
+    writeString(R"({"event_id":")", out);
+    writeIntText(rng(), out);
+    writeString(R"(","event_type":")", out);
+    writeString(event_types[rng() % 5], out);
+    writeString(R"(","ts":)", out);
+    writeIntText(1700000000000 + rng() % 100000000, out);
+    writeString(R"(,"user":{"id":)", out);
+    writeIntText(rng() % 1000000, out);
+    writeString(R"(,"country":")", out);
+    writeString(countries[rng() % 6], out);
+    writeString(R"(","tier":"gold","signup_ts":1650000000000},"device":{"os":")", out);
+    writeString(oses[rng() % 4], out);
+    writeString(R"(","model":"model-)", out);
+    writeIntText(rng() % 300, out);
+    writeString(R"(","app_version":"5.)", out);
+    writeIntText(rng() % 20, out);
+    writeString(R"(.0","screen":{"w":1080,"h":2400}},"session":{"id":")", out);
+    writeIntText(rng(), out);
+    writeString(R"(","duration_ms":)", out);
+    writeIntText(rng() % 3600000, out);
+    writeString(R"(},"page":{"url":"https://shop.example.com/item/)", out);
+    writeIntText(rng() % 50000, out);
+    writeString(R"(","referrer":"https://search.example.com/?q=shoes"},"props":{"item_id":)", out);
+    writeIntText(rng() % 50000, out);
+    writeString(R"(,"price":)", out);
+    writeIntText(rng() % 10000, out);
+    writeString(R"(.99,"tags":["sale","new","summer"],"experiment":{"name":"checkout_v2","bucket":)", out);
+    writeIntText(rng() % 4, out);
+    writeString("}}}", out);
+    out.finalize();
+    return event;
+}
+
+static ColumnWithTypeAndName createEvents(size_t distinct)
+{
+    std::mt19937_64 rng(42);
+    std::vector<String> events(distinct);
+    for (auto & event : events)
+        event = createEvent(rng);
+
+    auto column = ColumnString::create();
+    for (size_t i = 0; i < ROWS; ++i)
+        column->insert(events[rng() % distinct]);
+    return ColumnWithTypeAndName(std::move(column), std::make_shared<DataTypeString>(), "json");
+}
+
+static ColumnWithTypeAndName createPath(const String & path)
+{
+    auto type = std::make_shared<DataTypeString>();
+    return ColumnWithTypeAndName(type->createColumnConst(ROWS, path), type, "path");
+}
+
+/// One get_json_object per path, each parsing every document again.
+static void BM_GetJsonObjectPerPath(benchmark::State & state)
+{
+    auto function = FunctionFactory::instance().get("get_json_object", local_engine::QueryContext::globalContext());
+    const auto json = createEvents(state.range(0));
+    std::vector<ColumnsWithTypeAndName> arguments;
+    std::vector<FunctionBasePtr> executables;
+    for (const auto & path : EVENT_PATHS)
+    {
+        arguments.push_back({json, createPath(path)});
+        executables.push_back(function->build(arguments.back()));
+    }
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < executables.size(); ++i)
+        {
+            auto result = executables[i]->execute(arguments[i], executables[i]->getResultType(), ROWS, false);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * ROWS);
+}
+
+/// All paths extracted together, which is what the get_json_object rewrite produces.
+static void BM_FlattenJSONStringOnRequired(benchmark::State & state)
+{
+    auto function = FunctionFactory::instance().get(
+        local_engine::FlattenJSONStringOnRequiredFunction::name, local_engine::QueryContext::globalContext());
+    String paths;
+    for (const auto & path : EVENT_PATHS)
+        paths += (paths.empty() ? "" : "|") + path;
+    ColumnsWithTypeAndName arguments{createEvents(state.range(0)), createPath(paths)};
+    auto executable = function->build(arguments);
+
+    for (auto _ : state)
+    {
+        auto result = executable->execute(arguments, executable->getResultType(), ROWS, false);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * ROWS);
+}
+
+BENCHMARK(BM_GetJsonObjectPerPath)->Arg(64)->Arg(1024)->Arg(ROWS)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FlattenJSONStringOnRequired)->Arg(64)->Arg(1024)->Arg(ROWS)->Unit(benchmark::kMillisecond);
@@ -14,10 +14,15 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <random>
 #include <string>
 #include <vector>
 #include <Core/Block.h>
+#include <DataTypes/DataTypeArray.h>
 #include <DataTypes/DataTypeFactory.h>
+#include <DataTypes/DataTypeMap.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypeTuple.h>
 #include <IO/ReadBufferFromFile.h>
 #include <Interpreters/Context.h>
 #include <Parser/CHColumnToSparkRow.h>
@@ -31,6 +36,11 @@
 #include <Common/BlockTypeUtils.h>
 #include <Common/QueryContext.h>
 
+namespace DB::ErrorCodes
+{
+extern const int LOGICAL_ERROR;
+}
+
 using namespace DB;
 using namespace local_engine;
 
@@ -138,5 +148,117 @@ static void BM_SparkRowToCHColumn_Lineitem(benchmark::State & state)
         auto out_block = SparkRowToCHColumn::convertSparkRowInfoToCHColumn(*spark_row_info, *header);
 }
 
+static Field randomField(const DataTypePtr & type, std::mt19937_64 & rng)
+{
+    if (type->isNullable())
+        return rng() % 10 == 0 ? Field{} : randomField(removeNullable(type), rng);
+
+    const WhichDataType which(type);
+    if (which.isInt32())
+        return Int32(rng());
+    if (which.isInt64())
+        return Int64(rng());
+    if (which.isFloat64())
+        return Float64(rng() % 100000) / 100;
+    if (which.isString())
+        return String(rng() % 32, static_cast<char>('a' + rng() % 26));
+    if (which.isArray())
+    {
+        const auto & nested_type = typeid_cast<const DataTypeArray &>(*type).getNestedType();
+        Array array(rng() % 8);
+        for (auto & elem : array)
+            elem = randomField(nested_type, rng);
+        return array;
+    }
+    if (which.isMap())
+    {
+        const auto & map_type = typeid_cast<const DataTypeMap &>(*type);
+        Map map(rng() % 8);
+        for (auto & pair : map)
+            pair = Tuple{randomField(map_type.getKeyType(), rng), randomField(map_type.getValueType(), rng)};
+        return map;
+    }
+    if (which.isTuple())
+    {
+        Tuple tuple;
+        for (const auto & elem_type : typeid_cast<const DataTypeTuple &>(*type).getElements())
+            tuple.push_back(randomField(elem_type, rng));
+        return tuple;
+    }
+    throw Exception(ErrorCodes::LOGICAL_ERROR, "Unsupported type {} in randomField", type->getName());
+}
+
+static ColumnPtr makeRandomColumn(const DataTypePtr & type, size_t rows)
+{
+    std::mt19937_64 rng(42);
+    auto column = type->createColumn();
+    for (size_t i = 0; i < rows; ++i)
+        column->insert(randomField(type, rng));
+    return column;
+}
+
+static const NameTypes nested_name_types = {
+    {"id", "Int64"},
+    {"tags", "Array(Nullable(String))"},
+    {"scores", "Map(String, Nullable(Float64))"},
+    {"info", "Tuple(Int32, String, Array(Int64))"},
+    {"matrix", "Array(Array(Nullable(Int32)))"},
+};
+
+static void BM_CHColumnToSparkRow_Nested(benchmark::State & state)
+{
+    const size_t rows = state.range(0);
+    auto & factory = DataTypeFactory::instance();
+    ColumnsWithTypeAndName columns;
+    for (const auto & name_type : nested_name_types)
+    {
+        auto type = factory.get(name_type.type);
+        columns.emplace_back(makeRandomColumn(type, rows), type, name_type.name);
+    }
+    const Block block(std::move(columns));
+
+    CHColumnToSparkRow converter;
+    for (auto _ : state)
+    {
+        auto spark_row_info = converter.convertCHColumnToSparkRow(block);
+        converter.freeMem(spark_row_info->getBufferAddress(), spark_row_info->getTotalBytes());
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+
+/// Writes one nested column to Spark Row backing data, either through Fields (the fallback path) or from the column.
+static void BM_NestedColumnToSparkRow(benchmark::State & state, const String & type_name, bool use_fields)
+{
+    const size_t rows = state.range(0);
+    const auto type = DataTypeFactory::instance().get(type_name);
+    const auto column = makeRandomColumn(type, rows);
+    const BackingDataLengthCalculator calculator(type);
+    std::vector<int64_t> offsets(rows);
+    std::vector<int64_t> buffer_cursor(rows);
+    std::vector<char> buffer;
+    for (auto _ : state)
+    {
+        int64_t total_bytes = 0;
+        for (size_t i = 0; i < rows; ++i)
+        {
+            offsets[i] = total_bytes;
+            buffer_cursor[i] = 0;
+            total_bytes += use_fields ? calculator.calculate((*column)[i]) : calculator.calculate(*column, i);
+        }
+        buffer.assign(total_bytes, 0);
+        VariableLengthDataWriter writer(type, buffer.data(), offsets, buffer_cursor);
+        for (size_t i = 0; i < rows; ++i)
+            benchmark::DoNotOptimize(use_fields ? writer.write(i, (*column)[i], 0) : writer.write(i, *column, i, 0));
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+
 BENCHMARK(BM_CHColumnToSparkRow_Lineitem)->Unit(benchmark::kMillisecond)->Iterations(10);
+BENCHMARK(BM_CHColumnToSparkRow_Nested)->Unit(benchmark::kMillisecond)->Arg(65536);
+BENCHMARK_CAPTURE(BM_NestedColumnToSparkRow, array_field, String("Array(Nullable(String))"), true)->Arg(65536);
+BENCHMARK_CAPTURE(BM_NestedColumnToSparkRow, array_column, String("Array(Nullable(String))"), false)->Arg(65536);
+BENCHMARK_CAPTURE(BM_NestedColumnToSparkRow, map_field, String("Map(String, Nullable(Float64))"), true)->Arg(65536);
+BENCHMARK_CAPTURE(BM_NestedColumnToSparkRow, map_column, String("Map(String, Nullable(Float64))"), false)->Arg(65536);
+BENCHMARK_CAPTURE(BM_NestedColumnToSparkRow, struct_field, String("Tuple(Int32, String, Array(Int64))"), true)->Arg(65536);
+BENCHMARK_CAPTURE(BM_NestedColumnToSparkRow, struct_column, String("Tuple(Int32, String, Array(Int64))"), false)->Arg(65536);
 BENCHMARK(BM_SparkRowToCHColumn_Lineitem)->Unit(benchmark::kMillisecond)->Iterations(10);
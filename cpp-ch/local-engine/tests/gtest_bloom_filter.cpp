@@ -0,0 +1,71 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AggregateFunctions/AggregateFunctionGroupBloomFilter.h>
+#include <IO/ReadBufferFromString.h>
+#include <IO/WriteBufferFromString.h>
+#include <gtest/gtest.h>
+
+using namespace local_engine;
+using namespace DB;
+
+TEST(SplitBlockBloomFilter, NoFalseNegatives)
+{
+    SplitBlockBloomFilter filter(4096, 0);
+    std::vector<UInt64> keys;
+    for (UInt64 i = 0; i < 4096; ++i)
+        keys.push_back(i * 0x9E3779B97F4A7C15ULL);
+    for (auto key : keys)
+        filter.add(key);
+
+    PaddedPODArray<UInt8> result(keys.size());
+    filter.findBatch(keys.data(), keys.size(), result.data());
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        ASSERT_TRUE(filter.find(keys[i]));
+        ASSERT_TRUE(result[i]);
+    }
+
+    /// 8 bits per key, the false positive rate of a split block filter is about 3%.
+    size_t false_positives = 0;
+    for (UInt64 i = 0; i < 100000; ++i)
+        false_positives += filter.find(i * 0x9E3779B97F4A7C15ULL + 1);
+    EXPECT_LT(false_positives, 5000);
+}
+
+TEST(SplitBlockBloomFilter, SerializeAndMerge)
+{
+    for (bool split_block : {false, true})
+    {
+        AggregateFunctionGroupBloomFilterData left;
+        AggregateFunctionGroupBloomFilterData right;
+        left.init(1024, 3, 0, split_block);
+        right.init(1024, 3, 0, split_block);
+        for (Int64 i = 0; i < 500; ++i)
+            (i % 2 ? left : right).add(i);
+
+        WriteBufferFromOwnString out;
+        right.write(out);
+        ReadBufferFromString in(out.str());
+        AggregateFunctionGroupBloomFilterData deserialized;
+        deserialized.read(in);
+        ASSERT_EQ(deserialized.split_block, split_block);
+
+        left.merge(deserialized);
+        for (Int64 i = 0; i < 500; ++i)
+            ASSERT_TRUE(left.find(i)) << "split_block: " << split_block;
+    }
+}
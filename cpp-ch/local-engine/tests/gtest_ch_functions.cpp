@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 #include <Columns/ColumnSet.h>
+#include <Columns/ColumnTuple.h>
 #include <DataTypes/DataTypeFactory.h>
 #include <DataTypes/DataTypeSet.h>
 #include <Functions/FunctionFactory.h>
@@ -232,3 +233,34 @@ TEST(TestFunction, NotIn2)
     debug::headColumn(result2);
     ASSERT_EQ(result2->getUInt(3), 1);
 }
+
+TEST(TestFunction, FlattenJSONStringOnRequiredRepeatedDocuments)
+{
+    using namespace DB;
+    auto & factory = FunctionFactory::instance();
+    auto function = factory.get("flattenJSONStringOnRequired", local_engine::QueryContext::globalContext());
+    auto type = DataTypeFactory::instance().get("String");
+    auto json = type->createColumn();
+    const std::vector<String> documents = {R"({"a":1,"b":{"c":"x"}})", R"({"a":2,"b":{"c":"y"}})", "not json"};
+    for (size_t i = 0; i < 12; ++i)
+        json->insert(documents[i % 3]);
+
+    ColumnsWithTypeAndName columns
+        = {ColumnWithTypeAndName(std::move(json), type, "json"),
+           ColumnWithTypeAndName(type->createColumnConst(12, "$.a|$.b.c"), type, "paths")};
+    auto executable = function->build(columns);
+    auto result = executable->execute(columns, executable->getResultType(), 12, false);
+    const auto & tuple = assert_cast<const ColumnTuple &>(*result);
+    ASSERT_EQ(tuple.size(), 12);
+    for (size_t i = 0; i < 12; ++i)
+    {
+        if (i % 3 == 2)
+        {
+            ASSERT_TRUE(tuple.getColumn(0).isNullAt(i));
+            ASSERT_TRUE(tuple.getColumn(1).isNullAt(i));
+            continue;
+        }
+        ASSERT_EQ(tuple.getColumn(0)[i].safeGet<String>(), i % 3 ? "2" : "1");
+        ASSERT_EQ(tuple.getColumn(1)[i].safeGet<String>(), i % 3 ? "y" : "x");
+    }
+}
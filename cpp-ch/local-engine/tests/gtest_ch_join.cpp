@@ -20,6 +20,9 @@
 #include <Interpreters/Context.h>
 #include <Interpreters/HashJoin/HashJoin.h>
 #include <Interpreters/TableJoin.h>
+#include <IO/ReadBufferFromString.h>
+#include <IO/WriteBufferFromString.h>
+#include <Join/BroadcastJoinBuilder.h>
 #include <Parsers/ASTIdentifier.h>
 #include <Processors/Executors/PipelineExecutor.h>
 #include <Processors/Executors/PullingPipelineExecutor.h>
@@ -30,6 +33,8 @@
 #include <Processors/QueryPlan/ReadFromPreparedSource.h>
 #include <Processors/Sources/SourceFromSingleChunk.h>
 #include <QueryPipeline/QueryPipelineBuilder.h>
+#include <Storages/IO/NativeReader.h>
+#include <Storages/IO/NativeWriter.h>
 #include <Storages/MergeTree/SparkMergeTreeMeta.h>
 #include <Storages/SubstraitSource/SubstraitFileSource.h>
 #include <gtest/gtest.h>
@@ -40,6 +45,43 @@
 using namespace DB;
 using namespace local_engine;
 
+TEST(TestJoin, CollectBroadcastBuildBlocks)
+{
+    /// The build side is shuffled in 100 blocks of 10 non-nullable rows.
+    String data;
+    WriteBufferFromString out(data);
+    NativeWriter writer(out, Block{{BIGINT(), "k"}});
+    for (Int64 block = 0; block < 100; ++block)
+    {
+        std::vector<Int64> keys;
+        for (Int64 row = 0; row < 10; ++row)
+            keys.push_back(block * 10 + row);
+        writer.write(Block{createColumn<Int64>(keys, "k")});
+    }
+    out.finalize();
+
+    /// Read the blocks one by one, as the default max_block_size would merge them already.
+    ReadBufferFromString in(data);
+    NativeReader reader(in, 10);
+    Block header{{wrapNullableType(BIGINT()), "right_k"}};
+    Blocks result;
+    BroadcastJoinBuilder::collectBlocksForJoinRel(reader, header, result, 64);
+
+    /// Squashed into 14 blocks of 70 rows and the 20 rows left.
+    ASSERT_EQ(result.size(), 15u);
+    Int64 expected_key = 0;
+    for (size_t i = 0; i < result.size(); ++i)
+    {
+        ASSERT_EQ(result[i].rows(), i + 1 < result.size() ? 70u : 20u);
+        const auto & column = result[i].getByPosition(0);
+        EXPECT_EQ(column.name, "right_k");
+        EXPECT_TRUE(column.type->equals(*header.getByPosition(0).type));
+        for (size_t row = 0; row < column.column->size(); ++row)
+            EXPECT_EQ(column.column->getInt(row), expected_key++);
+    }
+    EXPECT_EQ(expected_key, 1000);
+}
+
 TEST(TestJoin, simple)
 {
     auto global_context = local_engine::QueryContext::globalContext();
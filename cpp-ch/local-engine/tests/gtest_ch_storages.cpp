@@ -14,18 +14,24 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <filesystem>
 #include <Functions/FunctionFactory.h>
+#include <IO/ReadBufferFromFile.h>
+#include <IO/ReadHelpers.h>
 #include <Parser/ParserContext.h>
 #include <Parser/RelParsers/MergeTreeRelParser.h>
 #include <Processors/Executors/PipelineExecutor.h>
 #include <Processors/Executors/PullingPipelineExecutor.h>
 #include <QueryPipeline/QueryPipelineBuilder.h>
 #include <Storages/MergeTree/SparkMergeTreeMeta.h>
+#include <Storages/SubstraitSource/ReadBufferBuilder.h>
 #include <Storages/SubstraitSource/SubstraitFileSource.h>
 #include <google/protobuf/util/json_util.h>
 #include <google/protobuf/wrappers.pb.h>
 #include <gtest/gtest.h>
 #include <substrait/plan.pb.h>
+#include <tests/utils/gluten_test_util.h>
+#include <Common/BlockTypeUtils.h>
 #include <Common/DebugUtils.h>
 #include <Common/QueryContext.h>
 
@@ -230,6 +236,104 @@ TEST(TestBatchParquetFileSource, local_file)
     ASSERT_TRUE(total_rows == 59986052);
 }
 
+TEST(TestBatchParquetFileSource, prefetch)
+{
+    constexpr size_t num_files = 5;
+    substrait::ReadRel::LocalFiles files;
+    for (size_t i = 0; i < num_files; ++i)
+    {
+        substrait::ReadRel::LocalFiles::FileOrFiles * file = files.add_items();
+        file->set_uri_file(test::gtest_uri("sample.parquet"));
+        file->set_start(0);
+        file->set_length(std::filesystem::file_size(test::gtest_data("sample.parquet")));
+        file->mutable_parquet()->CopyFrom(substrait::ReadRel::LocalFiles::FileOrFiles::ParquetReadOptions{});
+    }
+    const Block header({{DOUBLE(), "b"}, {BIGINT(), "a"}});
+
+    auto read_all = [&](const FileSourceConfig & config, SubstraitFileSource::PrefetchStats & stats)
+    {
+        auto source = std::make_shared<SubstraitFileSource>(QueryContext::globalContext(), header, files, config);
+        QueryPipeline pipeline(source);
+        PullingPipelineExecutor executor(pipeline);
+        std::vector<Int64> values;
+        Block block;
+        while (executor.pull(block))
+            for (size_t row = 0; row < block.rows(); ++row)
+                values.push_back(block.getByName("a").column->getInt(row));
+        stats = source->getPrefetchStats();
+        return values;
+    };
+
+    SubstraitFileSource::PrefetchStats stats;
+    const auto expected = read_all(FileSourceConfig{}, stats);
+    ASSERT_FALSE(expected.empty());
+    EXPECT_EQ(stats.files, 0u);
+
+    FileSourceConfig prefetch_config;
+    prefetch_config.parallel_read_files = 2;
+    EXPECT_EQ(read_all(prefetch_config, stats), expected);
+    EXPECT_EQ(stats.files, num_files);
+
+    /// Unordered reads return the same rows, a file at a time.
+    prefetch_config.preserve_file_order = false;
+    auto unordered = read_all(prefetch_config, stats);
+    EXPECT_EQ(stats.files, num_files);
+    auto sorted_expected = expected;
+    std::ranges::sort(sorted_expected);
+    std::ranges::sort(unordered);
+    EXPECT_EQ(unordered, sorted_expected);
+
+    /// Cancelling after the first chunk stops the files opened ahead and returns nothing more.
+    auto source = std::make_shared<SubstraitFileSource>(QueryContext::globalContext(), header, files, prefetch_config);
+    QueryPipeline pipeline(source);
+    PullingPipelineExecutor executor(pipeline);
+    Block block;
+    ASSERT_TRUE(executor.pull(block));
+    executor.cancel();
+    EXPECT_FALSE(executor.pull(block));
+}
+
+TEST(TestBatchParquetFileSource, read_whole_file)
+{
+    const std::string path = test::gtest_data("sample.parquet");
+    const size_t file_size = std::filesystem::file_size(path);
+    substrait::ReadRel::LocalFiles::FileOrFiles file_info;
+    file_info.set_uri_file(test::gtest_uri("sample.parquet"));
+    file_info.set_start(0);
+    file_info.set_length(file_size);
+    file_info.mutable_parquet();
+
+    EXPECT_FALSE(ReadBufferBuilder::shouldReadWholeFile(file_info, file_size, FileSourceConfig{}.small_file_threshold));
+    EXPECT_TRUE(ReadBufferBuilder::shouldReadWholeFile(file_info, file_size, file_size));
+    EXPECT_FALSE(ReadBufferBuilder::shouldReadWholeFile(file_info, file_size, file_size - 1));
+    EXPECT_FALSE(ReadBufferBuilder::shouldReadWholeFile(file_info, std::nullopt, file_size));
+    auto partial = file_info;
+    partial.set_length(file_size / 2);
+    EXPECT_FALSE(ReadBufferBuilder::shouldReadWholeFile(partial, file_size, file_size));
+    auto text = file_info;
+    text.mutable_text();
+    EXPECT_FALSE(ReadBufferBuilder::shouldReadWholeFile(text, file_size, file_size));
+
+    const size_t reads = ReadBufferBuilder::wholeFileReads();
+    const size_t read_bytes = ReadBufferBuilder::wholeFileReadBytes();
+    auto whole = ReadBufferBuilder::readWholeFile(std::make_unique<ReadBufferFromFile>(path), file_info, file_size);
+    EXPECT_EQ(ReadBufferBuilder::wholeFileReads(), reads + 1);
+    EXPECT_EQ(ReadBufferBuilder::wholeFileReadBytes(), read_bytes + file_size);
+
+    String expected;
+    ReadBufferFromFile in(path);
+    readStringUntilEOF(expected, in);
+    String actual;
+    readStringUntilEOF(actual, *whole);
+    EXPECT_EQ(actual, expected);
+
+    /// Readers seek back to the footer after reaching the end.
+    whole->seek(file_size - 4, SEEK_SET);
+    String magic(4, '\0');
+    whole->readStrict(magic.data(), magic.size());
+    EXPECT_EQ(magic, "PAR1");
+}
+
 TEST(TestPrewhere, OptimizePrewhereCondition)
 {
     String filter(R"({"scalarFunction":{"outputType":{"bool":{"nullability":"NULLABILITY_REQUIRED"}},"arguments":[{"value":{"scalarFunction":{"outputType":{"bool":{"nullability":"NULLABILITY_REQUIRED"}},"arguments":[{"value":{"scalarFunction":{"outputType":{"bool":{"nullability":"NULLABILITY_REQUIRED"}},"arguments":[{"value":{"scalarFunction":{"outputType":{"bool":{"nullability":"NULLABILITY_REQUIRED"}},   "arguments":[{"value":{"scalarFunction":{"functionReference":1,"outputType":{"bool":{"nullability":"NULLABILITY_REQUIRED"}},"arguments":[{"value":{"selection":{"directReference":{"structField":{"field":2}}}}},    {"value":{"literal":{"date":8766}}}]}}},{"value":{"scalarFunction":{"functionReference":2,"outputType":{"bool":{"nullability":"NULLABILITY_REQUIRED"}},    "arguments":[{"value":{"selection":{"directReference":{"structField":{"field":2}}}}},{"value":{"literal":{"date":9131}}}]}}}]}}},     {"value":{"scalarFunction":{"functionReference":3,"outputType":{"bool":{"nullability":"NULLABILITY_REQUIRED"}},"arguments":[{"value":{"selection":     {"directReference":{"structField":{}}}}},{"value":{"literal":{"decimal":{"value":"YAkAAAAAAAAAAAAAAAAAAA==","precision":15,"scale":2}}}}]}}}]}}},     {"value":{"scalarFunction":{"functionReference":4,"outputType":{"bool":{"nullability":"NULLABILITY_REQUIRED"}},"arguments":[{"value":{"selection":     {"directReference":{"structField":{"field":1}}}}},{"value":{"literal":{"decimal":{"value":"BQAAAAAAAAAAAAAAAAAAAA==","precision":15,"scale":2}}}}]}}}]}}},{"value":     {"scalarFunction":{"functionReference":5,"outputType":{"bool":{"nullability":"NULLABILITY_REQUIRED"}},"arguments":[{"value":{"selection":{"directReference":{"structField":     {"field":1}}}}},{"value":{"literal":{"decimal":{"value":"BwAAAAAAAAAAAAAAAAAAAA==","precision":15,"scale":2}}}}]}}}]}})");
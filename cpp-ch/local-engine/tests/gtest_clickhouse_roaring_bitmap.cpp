@@ -20,8 +20,11 @@
 #include <IO/ReadHelpers.h>
 #include <Interpreters/Context.h>
 #include <Parser/SerializedPlanParser.h>
+#include <Storages/SubstraitSource/Delta/Bitmap/DeletionBitmapCache.h>
 #include <Storages/SubstraitSource/Delta/Bitmap/DeltaDVRoaringBitmapArray.h>
 #include <Storages/SubstraitSource/ReadBufferBuilder.h>
+#include <base/scope_guard.h>
+#include <base/unit.h>
 #include <gtest/gtest.h>
 #include <tests/utils/gluten_test_util.h>
 #include <roaring.hh>
@@ -238,4 +241,43 @@ TEST(Delta_DV, Base85Codec)
     EXPECT_EQ("RpnINLjqk5Qhu9/!Y{vn", encoded);
     auto decodeUUID = Base85Codec::decodeUUID(encoded);
     EXPECT_EQ(uuid_str, toString(decodeUUID));
-}
\ No newline at end of file
+}
+
+TEST(Delta_DV, DeletionBitmapCache)
+{
+    auto & cache = DeletionBitmapCache::instance();
+    /// Restore the configured capacity for the tests that follow.
+    const size_t max_bytes = cache.maxBytes();
+    SCOPE_EXIT({ DeletionBitmapCache::initialize(max_bytes); });
+    size_t loads = 0;
+    auto load = [&]
+    {
+        ++loads;
+        auto bitmap = std::make_shared<DeltaDVRoaringBitmapArray>();
+        for (Int64 i = 0; i < 1000; i += 3)
+            bitmap->rb_add(i);
+        return bitmap;
+    };
+
+    DeletionBitmapCache::initialize(64_MiB);
+    auto first = cache.getOrLoad("a", load);
+    auto second = cache.getOrLoad("a", load);
+    EXPECT_EQ(loads, 1);
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_TRUE(second->rb_contains(999));
+    EXPECT_EQ(cache.count(), 1);
+
+    /// Room for one bitmap only, the least recently used one is evicted.
+    DeletionBitmapCache::initialize(cache.sizeInBytes() + first->rb_size_in_bytes() / 2);
+    cache.getOrLoad("a", load);
+    cache.getOrLoad("b", load);
+    EXPECT_EQ(cache.count(), 1);
+    cache.getOrLoad("a", load);
+    EXPECT_EQ(loads, 4);
+
+    DeletionBitmapCache::initialize(0);
+    cache.getOrLoad("a", load);
+    cache.getOrLoad("a", load);
+    EXPECT_EQ(loads, 6);
+    EXPECT_EQ(cache.count(), 0);
+}
@@ -86,3 +86,74 @@ TEST(HyperLogLogPlusPlusDataTest, SerializeAndDeserialize) {
 
     EXPECT_EQ(hll2.query(), 821);
 }
+
+TEST(HyperLogLogPlusPlusDataTest, SparseToDense)
+{
+    HyperLogLogPlusPlusData hll;
+    initSmallHLL(hll);
+    EXPECT_TRUE(hll.isSparse());
+
+    initLargeHLL(hll);
+    EXPECT_FALSE(hll.isSparse());
+    EXPECT_EQ(hll.query(), 821);
+}
+
+TEST(HyperLogLogPlusPlusDataTest, SparseSerializesAsDense)
+{
+    HyperLogLogPlusPlusData sparse;
+    initSmallHLL(sparse);
+    HyperLogLogPlusPlusData dense;
+    initLargeHLL(dense);
+
+    /// Merging either way round gives the same registers as adding all values to one state.
+    HyperLogLogPlusPlusData expected;
+    initLargeHLL(expected);
+    initSmallHLL(expected);
+    WriteBufferFromOwnString expected_buffer;
+    expected.serialize(expected_buffer);
+
+    HyperLogLogPlusPlusData sparse_then_dense;
+    initSmallHLL(sparse_then_dense);
+    sparse_then_dense.merge(dense);
+    WriteBufferFromOwnString sparse_then_dense_buffer;
+    sparse_then_dense.serialize(sparse_then_dense_buffer);
+    EXPECT_EQ(sparse_then_dense_buffer.str(), expected_buffer.str());
+
+    dense.merge(sparse);
+    WriteBufferFromOwnString dense_then_sparse_buffer;
+    dense.serialize(dense_then_sparse_buffer);
+    EXPECT_EQ(dense_then_sparse_buffer.str(), expected_buffer.str());
+
+    /// A sparse state is written as the dense words and comes back sparse.
+    WriteBufferFromOwnString sparse_buffer;
+    sparse.serialize(sparse_buffer);
+    EXPECT_EQ(sparse_buffer.str().size(), expected_buffer.str().size());
+    ReadBufferFromString read_buffer(sparse_buffer.str());
+    HyperLogLogPlusPlusData deserialized;
+    deserialized.deserialize(read_buffer);
+    EXPECT_TRUE(deserialized.isSparse());
+    EXPECT_EQ(deserialized.query(), 10);
+}
+
+TEST(HyperLogLogPlusPlusDataTest, SparseStateMemory)
+{
+    HyperLogLogPlusPlusData dense;
+    initLargeHLL(dense);
+    ASSERT_FALSE(dense.isSparse());
+    const size_t dense_bytes = dense.allocatedBytes();
+
+    /// A group that saw a few values only holds room for a few entries.
+    HyperLogLogPlusPlusData hll;
+    EXPECT_EQ(hll.allocatedBytes(), 0u);
+    initSmallHLL(hll);
+    ASSERT_TRUE(hll.isSparse());
+    EXPECT_EQ(hll.allocatedBytes(), 64u);
+
+    /// The sparse entries stay smaller than the dense words until they switch to them.
+    for (UInt64 i = 0; hll.isSparse(); ++i)
+    {
+        EXPECT_LT(hll.allocatedBytes(), dense_bytes) << "values: " << i;
+        hll.add(intHash64(i));
+    }
+    EXPECT_EQ(hll.allocatedBytes(), dense_bytes);
+}
@@ -19,6 +19,7 @@
 
 #include <Core/Block.h>
 #include <Core/Settings.h>
+#include <DataTypes/DataTypeNullable.h>
 #include <Formats/FormatFactory.h>
 
 #include <Interpreters/executeQuery.h>
@@ -29,6 +30,7 @@
 #include <Storages/SubstraitSource/Iceberg/IcebergMetadataColumn.h>
 #include <Storages/SubstraitSource/ReadBufferBuilder.h>
 #include <Storages/SubstraitSource/SubstraitFileSource.h>
+#include <base/scope_guard.h>
 #include <gtest/gtest.h>
 #include <tests/utils/QueryAssertions.h>
 #include <tests/utils/ReaderTestBase.h>
@@ -1013,23 +1015,129 @@ TEST_F(IcebergTest, basic_utils_test)
     }
 }
 
-TEST_F(IcebergTest, EqualityDeleteActionBuilder)
+namespace
 {
-    std::vector<DB::Block> dataBlock {makeVectors(1, rowCount, 3)};
-    DB::Block & resultBlock = dataBlock[0];
-
-    iceberg::EqualityDeleteActionBuilder actions{context_, resultBlock.getNamesAndTypesList()};
-    actions.notIn(DB::Block{createColumn<int64_t>({0, 1}, "c0")});
-    actions.notIn(DB::Block{createColumn<int64_t>({4, 5}, "c0")});
-    actions.notEquals(DB::Block{
-        createColumn<int64_t>({0, 1}, "c0"),
-        createColumn<int64_t>({0, 0}, "c1"),
-        createColumn<int64_t>({0, 0}, "c2")
-        });
-    auto x = actions.finish();
-    LOG_INFO(test_logger, "\n{}", debug::dumpActionsDAG(x->getActionsDAG()));
-    x->execute(resultBlock);
-    headBlock(resultBlock, 20 ,100);
+DB::SetPtr makeDeleteSet(const DB::ColumnsWithTypeAndName & keys)
+{
+    auto set = std::make_shared<DB::Set>(DB::SizeLimits{}, 0, true);
+    set->setHeader(DB::Block(keys).cloneEmpty().getColumnsWithTypeAndName());
+    set->insertFromBlock(keys);
+    set->finishInsert();
+    return set;
+}
+
+DB::ColumnWithTypeAndName createNullableColumn(const std::vector<std::optional<int64_t>> & data, const std::string & name)
+{
+    auto type = DB::makeNullable(CppToDataType<int64_t>::create());
+    auto column = type->createColumn();
+    for (const auto & value : data)
+        column->insert(value ? DB::Field(*value) : DB::Field());
+    return {std::move(column), type, name};
+}
+
+std::vector<UInt8> keptRows(const DB::Block & block)
+{
+    const auto & kept = block.getByName(iceberg::EqualityDeleteFilter::COLUMN_NAME).column;
+    std::vector<UInt8> result;
+    for (size_t i = 0; i < kept->size(); ++i)
+        result.push_back(kept->getUInt(i));
+    return result;
+}
+}
+
+TEST_F(IcebergTest, EqualityDeleteFilterOnVectors)
+{
+    DB::Block block = makeVectors(1, rowCount, 3)[0];
+
+    iceberg::EqualityDeleteFilter filter;
+    filter.addDeleteSet(makeDeleteSet({createColumn<int64_t>({0, 1}, "d0")}), {"c0"});
+    filter.addDeleteSet(makeDeleteSet({createColumn<int64_t>({4, 5}, "d0")}), {"c0"});
+    filter.addDeleteSet(
+        makeDeleteSet({createColumn<int64_t>({0, 1}, "d0"), createColumn<int64_t>({0, 0}, "d1"), createColumn<int64_t>({0, 0}, "d2")}),
+        {"c0", "c1", "c2"});
+    filter.execute(block);
+
+    const auto kept = keptRows(block);
+    ASSERT_EQ(kept.size(), static_cast<size_t>(rowCount));
+    for (size_t i = 0; i < kept.size(); ++i)
+        EXPECT_EQ(kept[i], i == 0 || i == 1 || i == 4 || i == 5 ? 0 : 1) << "row " << i;
+}
+
+TEST_F(IcebergTest, EqualityDeleteFilter)
+{
+    iceberg::EqualityDeleteFilter filter;
+    /// Deletes (c0, c1) in {(0, 0), (1, 0)} and c2 in {4}
+    filter.addDeleteSet(makeDeleteSet({createColumn<int64_t>({0, 1}, "d0"), createColumn<int64_t>({0, 0}, "d1")}), {"c0", "c1"});
+    filter.addDeleteSet(makeDeleteSet({createColumn<int64_t>({4}, "d0")}), {"c2"});
+
+    DB::Block block{
+        createColumn<int64_t>({0, 1, 1, 2, 3}, "c0"),
+        createColumn<int64_t>({0, 0, 1, 0, 0}, "c1"),
+        createColumn<int64_t>({0, 0, 0, 0, 4}, "c2")};
+    filter.execute(block);
+    EXPECT_EQ(keptRows(block), (std::vector<UInt8>{0, 0, 1, 1, 0}));
+}
+
+TEST_F(IcebergTest, EqualityDeleteFilterNullKeys)
+{
+    /// As in Iceberg, a null key is deleted by a null in the delete file, and only by it.
+    iceberg::EqualityDeleteFilter filter;
+    filter.addDeleteSet(makeDeleteSet({createNullableColumn({std::nullopt, 2}, "d0")}), {"c0"});
+    DB::Block block{createNullableColumn({std::nullopt, 1, 2, 3}, "c0")};
+    filter.execute(block);
+    EXPECT_EQ(keptRows(block), (std::vector<UInt8>{0, 1, 0, 1}));
+
+    /// Deletes (c0, c1) in {(null, 0), (1, null)}
+    iceberg::EqualityDeleteFilter multi_column_filter;
+    multi_column_filter.addDeleteSet(
+        makeDeleteSet({createNullableColumn({std::nullopt, 1}, "d0"), createNullableColumn({0, std::nullopt}, "d1")}), {"c0", "c1"});
+    DB::Block multi_column_block{
+        createNullableColumn({std::nullopt, std::nullopt, 1, 1, std::nullopt}, "c0"),
+        createNullableColumn({0, 1, std::nullopt, 0, std::nullopt}, "c1")};
+    multi_column_filter.execute(multi_column_block);
+    EXPECT_EQ(keptRows(multi_column_block), (std::vector<UInt8>{0, 1, 0, 1, 1}));
+}
+
+TEST_F(IcebergTest, EqualityDeleteSetCache)
+{
+    auto & cache = iceberg::EqualityDeleteSetCache::instance();
+    const size_t max_bytes = cache.maxBytes();
+    SCOPE_EXIT({ iceberg::EqualityDeleteSetCache::initialize(max_bytes); });
+    iceberg::EqualityDeleteSetCache::initialize(64_MiB);
+
+    size_t loads = 0;
+    auto load = [&]
+    {
+        ++loads;
+        return makeDeleteSet({createColumn<int64_t>({1, 2, 3}, "d0")});
+    };
+    SubstraitIcebergDeleteFile delete_file;
+    delete_file.set_filepath("file:///tmp/equality_delete_set_cache.parquet");
+    delete_file.set_filesize(1024);
+
+    const size_t hits = cache.hits();
+    const size_t misses = cache.misses();
+    const auto first = cache.getOrLoad(delete_file, load);
+    const auto second = cache.getOrLoad(delete_file, load);
+    EXPECT_EQ(loads, 1u);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(cache.hits(), hits + 1);
+    EXPECT_EQ(cache.misses(), misses + 1);
+    EXPECT_EQ(cache.count(), 1u);
+    EXPECT_EQ(cache.sizeInBytes(), first->getTotalByteCount());
+
+    /// A rewritten file of another size is another entry.
+    delete_file.set_filesize(2048);
+    EXPECT_NE(cache.getOrLoad(delete_file, load), first);
+    EXPECT_EQ(loads, 2u);
+    EXPECT_EQ(cache.count(), 2u);
+
+    /// A disabled cache builds the set every time.
+    iceberg::EqualityDeleteSetCache::initialize(0);
+    cache.getOrLoad(delete_file, load);
+    cache.getOrLoad(delete_file, load);
+    EXPECT_EQ(loads, 4u);
+    EXPECT_EQ(cache.count(), 0u);
 }
 
 // Delete values from a single column file
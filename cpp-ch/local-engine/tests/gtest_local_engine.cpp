@@ -14,12 +14,22 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <thread>
 #include <incbin.h>
 
 #include <Disks/DiskLocal.h>
 #include <Formats/FormatFactory.h>
+#include <Columns/ColumnAggregateFunction.h>
+#include <Columns/ColumnsNumber.h>
+#include <Compression/CompressedReadBuffer.h>
+#include <DataTypes/DataTypeAggregateFunction.h>
+#include <DataTypes/DataTypeFactory.h>
+#include <IO/ReadBufferFromString.h>
+#include <IO/WriteBufferFromString.h>
+#include <IO/copyData.h>
 #include <Interpreters/Context.h>
 #include <Interpreters/registerInterpreters.h>
 #include <Parser/CHColumnToSparkRow.h>
@@ -28,6 +38,11 @@
 #include <Processors/Executors/PipelineExecutor.h>
 #include <Processors/QueryPlan/Optimizations/QueryPlanOptimizationSettings.h>
 #include <Storages/MergeTree/MergeTreeData.h>
+#include <Storages/IO/AggregateSerializationUtils.h>
+#include <Storages/IO/CompressedWriteBuffer.h>
+#include <Storages/IO/NativeReader.h>
+#include <Storages/IO/NativeWriter.h>
+#include <Storages/IO/PipelinedCompressedReadBuffer.h>
 #include <Storages/MergeTree/SparkStorageMergeTree.h>
 #include <TableFunctions/TableFunctionFactory.h>
 #include <TableFunctions/registerTableFunctions.h>
@@ -36,6 +51,7 @@
 #include <config.pb.h>
 #include <Common/CHUtil.h>
 #include <Common/GlutenConfig.h>
+#include <Common/WeightedLRUCache.h>
 
 using namespace local_engine;
 using namespace DB;
@@ -59,6 +75,34 @@ TEST(TESTUtil, TestByteToLong)
     ASSERT_EQ(expected, result);
 }
 
+TEST(WeightedLRUCache, DisabledCacheLoadsConcurrently)
+{
+    WeightedLRUCache<int> cache([](const int &) { return 1; });
+    cache.setMaxWeight(0);
+
+    /// Each load waits until both are running, so it only returns true if the loads are not serialized.
+    std::atomic<size_t> running_loads = 0;
+    auto load = [&]
+    {
+        ++running_loads;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (running_loads < 2 && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::yield();
+        return running_loads >= 2 ? 1 : 0;
+    };
+
+    int first = 0;
+    int second = 0;
+    std::thread first_thread([&] { first = cache.getOrLoad("key", load); });
+    std::thread second_thread([&] { second = cache.getOrLoad("key", load); });
+    first_thread.join();
+    second_thread.join();
+    EXPECT_EQ(first, 1);
+    EXPECT_EQ(second, 1);
+    EXPECT_EQ(cache.count(), 0u);
+    EXPECT_EQ(cache.hits() + cache.misses(), 0u);
+}
+
 TEST(ReadBufferFromFile, seekBackwards)
 {
     static constexpr size_t N = 256;
@@ -89,6 +133,136 @@ TEST(ReadBufferFromFile, seekBackwards)
     ASSERT_EQ(x, 8);
 }
 
+TEST(CompressedWriteBuffer, pipelinedCompression)
+{
+    static constexpr size_t BUF_SIZE = 4096;
+
+    auto write = [](size_t compress_threads, std::vector<size_t> & sync_offsets)
+    {
+        auto codec = CompressionCodecFactory::instance().get("ZSTD", 1);
+        WriteBufferFromOwnString out;
+        CompressedWriteBuffer compressed(out, codec, BUF_SIZE, true, compress_threads);
+        for (size_t i = 0; i < 100000; ++i)
+        {
+            writeIntBinary(i % 977, compressed);
+            if (i % 20000 == 19999)
+            {
+                /// Offsets taken after sync() must cover all the data written so far.
+                compressed.sync();
+                sync_offsets.push_back(out.count());
+            }
+        }
+        compressed.finalize();
+        return out.str();
+    };
+
+    std::vector<size_t> expected_offsets;
+    const auto expected = write(0, expected_offsets);
+    for (size_t compress_threads : {1, 2, 4})
+    {
+        std::vector<size_t> offsets;
+        ASSERT_EQ(write(compress_threads, offsets), expected) << "compress_threads: " << compress_threads;
+        ASSERT_EQ(offsets, expected_offsets);
+    }
+}
+
+TEST(PipelinedCompressedReadBuffer, readBack)
+{
+    auto codec = CompressionCodecFactory::instance().get("ZSTD", 1);
+    WriteBufferFromOwnString out;
+    {
+        CompressedWriteBuffer compressed(out, codec, 4096, true, 0);
+        for (size_t i = 0; i < 100000; ++i)
+            writeIntBinary(i % 977, compressed);
+        compressed.finalize();
+    }
+    const auto & data = out.str();
+
+    auto read_all = [](ReadBuffer & in)
+    {
+        String result;
+        WriteBufferFromString result_out(result);
+        copyData(in, result_out);
+        result_out.finalize();
+        return result;
+    };
+
+    ReadBufferFromString expected_in(data);
+    CompressedReadBuffer expected_compressed(expected_in);
+    const auto expected = read_all(expected_compressed);
+    ASSERT_EQ(expected.size(), 100000 * sizeof(size_t));
+    for (size_t decompress_threads : {1, 2, 4})
+    {
+        ReadBufferFromString in(data);
+        PipelinedCompressedReadBuffer pipelined(in, decompress_threads);
+        ASSERT_EQ(read_all(pipelined), expected) << "decompress_threads: " << decompress_threads;
+    }
+}
+
+TEST(PipelinedCompressedReadBuffer, corruptedHeader)
+{
+    auto codec = CompressionCodecFactory::instance().get("ZSTD", 1);
+    WriteBufferFromOwnString out;
+    {
+        CompressedWriteBuffer compressed(out, codec, 4096, true, 0);
+        for (size_t i = 0; i < 1000; ++i)
+            writeIntBinary(i, compressed);
+        compressed.finalize();
+    }
+
+    /// The block header follows the 16 bytes checksum: the method, then the compressed and the decompressed sizes.
+    auto read_corrupted = [&](size_t offset)
+    {
+        String data = out.str();
+        const UInt32 size = std::numeric_limits<UInt32>::max();
+        memcpy(data.data() + 16 + offset, &size, sizeof(size));
+        ReadBufferFromString in(data);
+        PipelinedCompressedReadBuffer pipelined(in, 2);
+        String result;
+        WriteBufferFromString result_out(result);
+        copyData(pipelined, result_out);
+        result_out.finalize();
+    };
+    EXPECT_THROW(read_corrupted(1), DB::Exception);
+    EXPECT_THROW(read_corrupted(5), DB::Exception);
+}
+
+TEST(NativeWriter, FixedSizeAggregateStates)
+{
+    auto type = DataTypeFactory::instance().get("AggregateFunction(avg, Int64)");
+    const auto & function = typeid_cast<const DataTypeAggregateFunction &>(*type).getFunction();
+    auto values = ColumnInt64::create();
+    for (Int64 i = 0; i < 1000; ++i)
+        values->insertValue(i);
+    const IColumn * arguments[] = {values.get()};
+
+    auto states = type->createColumn();
+    auto & state_column = typeid_cast<ColumnAggregateFunction &>(*states);
+    char * places = appendFixedSizeAggregateStates(state_column, 100);
+    for (size_t i = 0; i < values->size(); ++i)
+        function->add(places + (i % 100) * function->sizeOfData(), arguments, i, &state_column.createOrGetArena());
+    Block block({ColumnWithTypeAndName(std::move(states), type, "state")});
+
+    /// Both the states written from the arena and the ones converted to FixedString by the shuffle.
+    String data;
+    WriteBufferFromString out(data);
+    NativeWriter writer(out, block.cloneEmpty());
+    writer.write(block);
+    writer.write(convertAggregateStateInBlock(block));
+    out.finalize();
+
+    ReadBufferFromString in(data);
+    NativeReader reader(in);
+    auto result = reader.read();
+    ASSERT_EQ(result.rows(), 200);
+    const auto & result_column = typeid_cast<const ColumnAggregateFunction &>(*result.getByPosition(0).column);
+    auto averages = ColumnFloat64::create();
+    for (const auto * place : result_column.getData())
+        function->insertResultInto(const_cast<char *>(place), *averages, nullptr);
+    for (size_t row = 0; row < 200; ++row)
+        EXPECT_EQ(averages->getData()[row], static_cast<Float64>(row % 100 + 450)) << "row: " << row;
+}
+
 INCBIN(_config_json, SOURCE_DIR "/utils/extern-local-engine/tests/json/gtest_local_engine_config.json");
 
 namespace DB
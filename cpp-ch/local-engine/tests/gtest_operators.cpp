@@ -0,0 +1,413 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <map>
+#include <AggregateFunctions/AggregateFunctionFactory.h>
+#include <Columns/ColumnAggregateFunction.h>
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <Operator/ExpandTransform.h>
+#include <Operator/GraceAggregatingTransform.h>
+#include <Operator/HashWindowGroupLimitStep.h>
+#include <Operator/StreamingAggregatingStep.h>
+#include <Processors/Executors/PullingPipelineExecutor.h>
+#include <Processors/ISource.h>
+#include <Processors/QueryPlan/BuildQueryPipelineSettings.h>
+#include <QueryPipeline/Pipe.h>
+#include <QueryPipeline/QueryPipeline.h>
+#include <QueryPipeline/QueryPipelineBuilder.h>
+#include <base/demangle.h>
+#include <gtest/gtest.h>
+#include <Common/AggregateUtil.h>
+#include <Common/BlockTypeUtils.h>
+#include <Common/QueryContext.h>
+
+using namespace DB;
+using namespace local_engine;
+
+namespace
+{
+class OperatorTest : public testing::Test
+{
+protected:
+    ContextMutablePtr context;
+
+    void SetUp() override
+    {
+        query_id = QueryContext::instance().initializeQuery(demangle(typeid(*this).name()));
+        context = QueryContext::instance().currentQueryContext();
+    }
+
+    void TearDown() override
+    {
+        context = nullptr;
+        QueryContext::instance().finalizeQuery(query_id);
+    }
+
+    /// Pulls all blocks of `pipe`.
+    static Blocks pullAll(Pipe pipe)
+    {
+        QueryPipeline pipeline(std::move(pipe));
+        PullingPipelineExecutor executor(pipeline);
+        Blocks blocks;
+        Block block;
+        while (executor.pull(block))
+            if (block.rows())
+                blocks.push_back(std::move(block));
+        return blocks;
+    }
+
+private:
+    int64_t query_id = 0;
+};
+
+/// Emits chunks of (k, v) rows with v = k, cycling through 4 * keys_per_chunk keys. With a spill target, it asks it to
+/// spill before each chunk, as MemorySpillScheduler does under memory pressure.
+class KeyValueSource : public ISource
+{
+public:
+    KeyValueSource(SharedHeader header_, size_t chunks_, size_t keys_per_chunk_, ProcessorPtr spill_target_ = nullptr)
+        : ISource(std::move(header_)), chunks(chunks_), keys_per_chunk(keys_per_chunk_), spill_target(std::move(spill_target_))
+    {
+    }
+
+    String getName() const override { return "KeyValueSource"; }
+
+    static Int64 keyAt(size_t chunk, size_t row, size_t keys_per_chunk) { return (chunk * keys_per_chunk + row) % (4 * keys_per_chunk); }
+
+protected:
+    Chunk generate() override
+    {
+        if (generated == chunks)
+            return {};
+        if (spill_target)
+            spill_target->spillOnSize(1);
+        auto keys = ColumnInt64::create();
+        for (size_t row = 0; row < keys_per_chunk; ++row)
+            keys->insertValue(keyAt(generated, row, keys_per_chunk));
+        ColumnPtr values = keys->clone();
+        ++generated;
+        return Chunk(Columns{std::move(keys), std::move(values)}, keys_per_chunk);
+    }
+
+private:
+    const size_t chunks;
+    const size_t keys_per_chunk;
+    const ProcessorPtr spill_target;
+    size_t generated = 0;
+};
+
+SharedHeader keyValueHeader()
+{
+    return std::make_shared<const Block>(Block{{BIGINT(), "k"}, {BIGINT(), "v"}});
+}
+
+/// Emits the given chunks one by one.
+class ChunksSource : public ISource
+{
+public:
+    ChunksSource(SharedHeader header_, Chunks chunks_) : ISource(std::move(header_)), chunks(std::move(chunks_)) { }
+
+    String getName() const override { return "ChunksSource"; }
+
+protected:
+    Chunk generate() override
+    {
+        if (next_chunk == chunks.size())
+            return {};
+        return std::move(chunks[next_chunk++]);
+    }
+
+private:
+    Chunks chunks;
+    size_t next_chunk = 0;
+};
+}
+
+TEST_F(OperatorTest, GraceAggregatingParallelMergeWithSpill)
+{
+    constexpr size_t chunks = 16;
+    constexpr size_t keys_per_chunk = 1000;
+    const auto header = keyValueHeader();
+
+    std::map<Int64, Int64> expected;
+    for (size_t chunk = 0; chunk < chunks; ++chunk)
+        for (size_t row = 0; row < keys_per_chunk; ++row)
+        {
+            const auto key = KeyValueSource::keyAt(chunk, row, keys_per_chunk);
+            expected[key] += key;
+        }
+
+    auto aggregate = [&](const GraceMergingAggregateConfig & config)
+    {
+        AggregateDescription sum;
+        AggregateFunctionProperties properties;
+        sum.function = AggregateFunctionFactory::instance().get("sum", NullsAction::EMPTY, {BIGINT()}, {}, properties);
+        sum.argument_names = {"v"};
+        sum.column_name = "sum_v";
+        auto params = AggregatorParamsHelper::buildParams(context, {"k"}, {sum}, AggregatorParamsHelper::Mode::INIT_TO_COMPLETED);
+        auto transform_params = std::make_shared<AggregatingTransformParams>(header, params, true);
+        auto transform = std::make_shared<GraceAggregatingTransform>(header, transform_params, context, true, true, config);
+
+        Pipe pipe(std::make_shared<KeyValueSource>(header, chunks, keys_per_chunk, transform));
+        pipe.addTransform(transform);
+        std::map<Int64, Int64> result;
+        for (const auto & block : pullAll(std::move(pipe)))
+        {
+            const auto & keys = block.getByName("k").column;
+            const auto & sums = block.getByName("sum_v").column;
+            for (size_t row = 0; row < block.rows(); ++row)
+            {
+                const bool inserted = result.emplace(keys->getInt(row), sums->getInt(row)).second;
+                EXPECT_TRUE(inserted) << "key " << keys->getInt(row) << " is output twice";
+            }
+        }
+        return result;
+    };
+
+    /// Spill every block and extend the buckets on every chunk, up to 8 buckets, so the blocks spilled with 2 and 4
+    /// buckets have their rows forwarded while the buckets are merged.
+    GraceMergingAggregateConfig config;
+    config.max_grace_aggregate_merging_buckets = 8;
+    config.aggregated_keys_before_extend_grace_aggregate_merging_buckets = 16;
+    config.enable_spill_test = true;
+    EXPECT_EQ(aggregate(config), expected);
+
+    config.parallel_merging_threads = 4;
+    EXPECT_EQ(aggregate(config), expected);
+
+    config.parallel_merging_ordered_output = false;
+    EXPECT_EQ(aggregate(config), expected);
+
+    /// Every bucket is over the budget, so the buckets after 0 are merged one by one.
+    config.parallel_merging_memory_budget = 1;
+    EXPECT_EQ(aggregate(config), expected);
+}
+
+TEST_F(OperatorTest, HashWindowGroupLimit)
+{
+    constexpr size_t chunks_num = 20;
+    constexpr size_t rows_per_chunk = 1000;
+    constexpr size_t partitions_num = 500;
+    constexpr size_t limit = 3;
+    const auto header = keyValueHeader();
+
+    /// Partition k gets the order values (3 * j + k) % 17 for its j-th row, so every value has 2 or 3 peers.
+    Chunks chunks;
+    std::map<Int64, std::vector<Int64>> partitions;
+    for (size_t chunk = 0; chunk < chunks_num; ++chunk)
+    {
+        std::vector<Int64> keys;
+        std::vector<Int64> values;
+        for (size_t row = 0; row < rows_per_chunk; ++row)
+        {
+            const size_t i = chunk * rows_per_chunk + row;
+            keys.push_back(i % partitions_num);
+            values.push_back((i / partitions_num * 13 + i) % 17);
+            partitions[keys.back()].push_back(values.back());
+        }
+        chunks.emplace_back(Columns{createColumn<Int64>(keys), createColumn<Int64>(values)}, rows_per_chunk);
+    }
+    auto clone_chunks = [&]
+    {
+        Chunks cloned;
+        for (const auto & chunk : chunks)
+            cloned.push_back(chunk.clone());
+        return cloned;
+    };
+
+    auto expected_rows = [&](const String & function_name)
+    {
+        std::map<Int64, std::vector<Int64>> expected;
+        for (auto [key, values] : partitions)
+        {
+            std::sort(values.begin(), values.end());
+            size_t rank = 0;
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                if (function_name == "row_number")
+                    rank = i + 1;
+                else if (i == 0 || values[i - 1] != values[i])
+                    rank = function_name == "rank" ? i + 1 : rank + 1;
+                if (rank > limit)
+                    break;
+                expected[key].push_back(values[i]);
+            }
+        }
+        return expected;
+    };
+
+    auto window_group_limit = [&](const String & function_name, const WindowConfig & config)
+    {
+        SortDescription sort_description{SortColumnDescription("v", 1, 1)};
+        HashWindowGroupLimitStep step(context, header, function_name, {0}, sort_description, limit, config);
+        QueryPipelineBuilder builder;
+        builder.init(Pipe(std::make_shared<ChunksSource>(header, clone_chunks())));
+        step.transformPipeline(builder, BuildQueryPipelineSettings{context});
+        QueryPlanResourceHolder resources;
+
+        /// Every partition is output at once, with its rows sorted.
+        std::map<Int64, std::vector<Int64>> result;
+        std::optional<Int64> last_key;
+        for (const auto & block : pullAll(QueryPipelineBuilder::getPipe(std::move(builder), resources)))
+        {
+            const auto & keys = block.getByName("k").column;
+            const auto & values = block.getByName("v").column;
+            for (size_t row = 0; row < block.rows(); ++row)
+            {
+                const auto key = keys->getInt(row);
+                if (key != last_key)
+                    EXPECT_FALSE(result.contains(key)) << "partition " << key << " is not output at once";
+                last_key = key;
+                result[key].push_back(values->getInt(row));
+            }
+        }
+        return result;
+    };
+
+    WindowConfig config;
+    WindowConfig spill_config;
+    /// Spill on every chunk, so every level scatters its rows and flushes bucket 0, up to the last level.
+    spill_config.hash_topk_max_bytes_in_memory = 1;
+    spill_config.hash_topk_spill_buckets = 4;
+    for (const String function_name : {"row_number", "rank", "dense_rank"})
+    {
+        const auto expected = expected_rows(function_name);
+        EXPECT_EQ(window_group_limit(function_name, config), expected) << function_name;
+        EXPECT_EQ(window_group_limit(function_name, spill_config), expected) << function_name << " with spill";
+    }
+}
+
+TEST_F(OperatorTest, ExpandMultipleProjections)
+{
+    constexpr size_t chunks = 2;
+    constexpr size_t keys_per_chunk = 5;
+    const auto header = keyValueHeader();
+
+    /// Like the grouping sets (k, v), (k) and (), with the grouping id last.
+    const auto nullable_bigint = makeNullable(BIGINT());
+    const ExpandField expand_field(
+        {"k", "v", "gid"},
+        {nullable_bigint, nullable_bigint, BIGINT()},
+        {{EXPAND_FIELD_KIND_SELECTION, EXPAND_FIELD_KIND_SELECTION, EXPAND_FIELD_KIND_LITERAL},
+         {EXPAND_FIELD_KIND_SELECTION, EXPAND_FIELD_KIND_LITERAL, EXPAND_FIELD_KIND_LITERAL},
+         {EXPAND_FIELD_KIND_LITERAL, EXPAND_FIELD_KIND_LITERAL, EXPAND_FIELD_KIND_LITERAL}},
+        {{Field(Int32(0)), Field(Int32(1)), Field(Int64(0))},
+         {Field(Int32(0)), Field(), Field(Int64(1))},
+         {Field(), Field(), Field(Int64(3))}});
+    const auto output_header
+        = std::make_shared<const Block>(Block{{nullable_bigint, "k"}, {nullable_bigint, "v"}, {BIGINT(), "gid"}});
+
+    std::vector<std::vector<Field>> expected;
+    for (size_t chunk = 0; chunk < chunks; ++chunk)
+    {
+        for (Int64 gid : {0, 1, 3})
+        {
+            for (size_t row = 0; row < keys_per_chunk; ++row)
+            {
+                const Field key = KeyValueSource::keyAt(chunk, row, keys_per_chunk);
+                expected.push_back({gid < 3 ? key : Field(), gid < 1 ? key : Field(), gid});
+            }
+        }
+    }
+
+    Pipe pipe(std::make_shared<KeyValueSource>(header, chunks, keys_per_chunk));
+    pipe.addTransform(std::make_shared<ExpandTransform>(header, output_header, expand_field));
+    std::vector<std::vector<Field>> result;
+    for (const auto & block : pullAll(std::move(pipe)))
+    {
+        ASSERT_TRUE(blocksHaveEqualStructure(block, *output_header));
+        const auto & columns = block.getColumns();
+        for (size_t row = 0; row < block.rows(); ++row)
+            result.push_back({(*columns[0])[row], (*columns[1])[row], (*columns[2])[row]});
+    }
+    EXPECT_EQ(result, expected);
+
+    /// The projections share the column cast from the same input column and the columns of the same literal.
+    ExpandColumnsBuilder builder(header, expand_field);
+    builder.setInput(Chunk(Columns{createColumn<Int64>({1, 2}), createColumn<Int64>({3, 4})}, 2));
+    const auto grouping_set_k_v = builder.build(0);
+    const auto grouping_set_k = builder.build(1);
+    const auto grouping_set_empty = builder.build(2);
+    EXPECT_EQ(grouping_set_k_v[0].get(), grouping_set_k[0].get());
+    EXPECT_EQ(grouping_set_k[1].get(), grouping_set_empty[1].get());
+    EXPECT_NE(grouping_set_k[2].get(), grouping_set_empty[2].get());
+}
+
+TEST_F(OperatorTest, StreamingAggregatingBypass)
+{
+    constexpr size_t chunks_num = 10;
+    constexpr size_t rows_per_chunk = 1000;
+    const auto header = keyValueHeader();
+
+    /// Every key is unique inside the first half of the chunks and shows up once more in the second half.
+    Chunks chunks;
+    std::map<Int64, Int64> expected;
+    for (size_t chunk = 0; chunk < chunks_num; ++chunk)
+    {
+        std::vector<Int64> keys;
+        for (size_t row = 0; row < rows_per_chunk; ++row)
+        {
+            keys.push_back((chunk % (chunks_num / 2)) * rows_per_chunk + row);
+            expected[keys.back()] += keys.back();
+        }
+        chunks.emplace_back(Columns{createColumn<Int64>(keys), createColumn<Int64>(keys)}, rows_per_chunk);
+    }
+
+    /// Merges the intermediate states of each key, as the final aggregation does.
+    auto aggregate = [&](const StreamingAggregateConfig & config, size_t & bypassed_rows)
+    {
+        AggregateDescription sum;
+        AggregateFunctionProperties properties;
+        sum.function = AggregateFunctionFactory::instance().get("sum", NullsAction::EMPTY, {BIGINT()}, {}, properties);
+        sum.argument_names = {"v"};
+        sum.column_name = "sum_v";
+        auto params = AggregatorParamsHelper::buildParams(context, {"k"}, {sum}, AggregatorParamsHelper::Mode::INIT_TO_PARTIAL);
+        auto transform_params = std::make_shared<AggregatingTransformParams>(header, params, false);
+        auto transform = std::make_shared<StreamingAggregatingTransform>(context, header, transform_params, config);
+
+        Chunks input;
+        for (const auto & chunk : chunks)
+            input.push_back(chunk.clone());
+        Pipe pipe(std::make_shared<ChunksSource>(header, std::move(input)));
+        pipe.addTransform(transform);
+        std::map<Int64, Int64> result;
+        for (const auto & block : pullAll(std::move(pipe)))
+        {
+            const auto & keys = block.getByName("k").column;
+            const auto & states = typeid_cast<const ColumnAggregateFunction &>(*block.getByName("sum_v").column);
+            auto sums = ColumnInt64::create();
+            for (const auto * place : states.getData())
+                sum.function->insertResultInto(const_cast<char *>(place), *sums, nullptr);
+            for (size_t row = 0; row < block.rows(); ++row)
+                result[keys->getInt(row)] += sums->getInt(row);
+        }
+        bypassed_rows = transform->getBypassedRows();
+        return result;
+    };
+
+    /// The first window of 1000 unique keys switches to bypassing the next 2000 rows, then aggregation is tried again.
+    StreamingAggregateConfig config;
+    config.streaming_aggregating_bypass_window_rows = rows_per_chunk;
+    config.streaming_aggregating_bypass_rows = 2 * rows_per_chunk;
+    size_t bypassed_rows = 0;
+    EXPECT_EQ(aggregate(config, bypassed_rows), expected);
+    EXPECT_GT(bypassed_rows, 0u);
+
+    config.enable_streaming_aggregating_bypass = false;
+    EXPECT_EQ(aggregate(config, bypassed_rows), expected);
+    EXPECT_EQ(bypassed_rows, 0u);
+}
@@ -22,9 +22,11 @@
 #include <string>
 #include <Columns/ColumnString.h>
 #include <IO/ReadBufferFromFile.h>
+#include <IO/WriteBufferFromFile.h>
 #include <Interpreters/ActionsVisitor.h>
 #include <Interpreters/Context.h>
 #include <Parsers/ExpressionListParsers.h>
+#include <Processors/Formats/Impl/ParquetBlockOutputFormat.h>
 #include <Storages/Parquet/ArrowUtils.h>
 #include <Storages/Parquet/ColumnIndexFilter.h>
 #include <Storages/Parquet/ParquetConverter.h>
@@ -38,7 +40,10 @@
 #include <parquet/statistics.h>
 #include <tests/utils/gluten_test_util.h>
 #include <Common/BlockTypeUtils.h>
+#include <Common/FieldVisitorToString.h>
+#include <Common/ProfileEvents.h>
 #include <Common/QueryContext.h>
+#include <Common/filesystemHelpers.h>
 
 #define ASSERT_DURATION_LE(secs, stmt) \
     { \
@@ -62,6 +67,11 @@ namespace DB::ErrorCodes
 extern const int LOGICAL_ERROR;
 }
 
+namespace ProfileEvents
+{
+extern const Event ParquetPrunedRowGroups;
+}
+
 namespace parquet
 {
 using ColumnIndexPtr = std::unique_ptr<ColumnIndex>;
@@ -505,6 +515,144 @@ TEST(ColumnIndex, Filtering)
     testCondition("column1 >= 7 and column1 < 11 and column2 > 'Romeo' and column2 <= 'Tango'", {7, 11, 12, 13});
 }
 
+TEST(ColumnIndex, MayMatchBloomFilters)
+{
+    using namespace test_utils;
+    static const local_engine::RowType name_and_types = buildTestRowType();
+
+    /// The bloom filter of column1 holds 1 and 7, and that of column2 'Alfa'. The other columns have none.
+    const auto probe = [](const std::string & column_name, const DB::Field & value) -> std::optional<bool>
+    {
+        const auto str = DB::applyVisitor(DB::FieldVisitorToString(), value);
+        if (column_name == "column1")
+            return str == "1" || str == "7";
+        if (column_name == "column2")
+            return str == "'Alfa'";
+        return std::nullopt;
+    };
+    const auto may_match = [&](const std::string & exp)
+    {
+        const local_engine::ColumnIndexFilter filter(
+            local_engine::test::parseFilter(exp, name_and_types).value(), local_engine::QueryContext::globalContext());
+        return filter.mayMatchBloomFilters(probe);
+    };
+
+    ASSERT_TRUE(may_match("column1 = 7"));
+    ASSERT_FALSE(may_match("column1 = 8"));
+    ASSERT_TRUE(may_match("column1 in (3, 7)"));
+    ASSERT_FALSE(may_match("column1 in (3, 8)"));
+    ASSERT_FALSE(may_match("column1 = 7 and column2 = 'Zulu'"));
+    ASSERT_TRUE(may_match("column1 = 8 or column2 = 'Alfa'"));
+    ASSERT_FALSE(may_match("column1 = 8 or column2 in ('Bravo', 'Zulu')"));
+    ASSERT_TRUE(may_match("column1 = 8 or column3 = 2.03"));
+    ASSERT_TRUE(may_match("column1 != 8"));
+    ASSERT_TRUE(may_match("column1 > 8"));
+    ASSERT_FALSE(may_match("column1 > 8 and column1 = 8"));
+}
+
+TEST(ColumnIndex, BloomFilterSkipRowGroups)
+{
+    using namespace local_engine;
+
+    /// Row group r holds the values v < 400 with v % 4 == r, so every row group spans nearly the same min/max and only
+    /// the bloom filters tell them apart.
+    constexpr size_t row_groups = 4;
+    constexpr size_t rows_per_group = 100;
+    const auto file = createTemporaryFile("/tmp/");
+    {
+        FormatSettings write_settings;
+        write_settings.parquet.row_group_rows = rows_per_group;
+        write_settings.parquet.parallel_encoding = false;
+        write_settings.parquet.write_page_index = true;
+        write_settings.parquet.write_bloom_filter = true;
+        /// Keep false positives out of the expected row groups.
+        write_settings.parquet.bloom_filter_bits_per_value = 64;
+
+        const Block header{{INT(), "i32"}, {BIGINT(), "i64"}, {STRING(), "str"}};
+        WriteBufferFromFile out(file->path());
+        ParquetBlockOutputFormat output_format(out, toShared(header), write_settings, nullptr);
+        for (size_t r = 0; r < row_groups; ++r)
+        {
+            const auto value_at = [&](size_t row) { return static_cast<Int64>(row * row_groups + r); };
+            const auto i32_at = [&](size_t row) { return static_cast<Int32>(value_at(row)); };
+            const auto str_at = [&](size_t row) { return "v" + std::to_string(value_at(row)); };
+            output_format.write(Block{
+                {createColumn<Int32>(rows_per_group, i32_at), INT(), "i32"},
+                {createColumn<Int64>(rows_per_group, value_at), BIGINT(), "i64"},
+                {createColumn<std::string>(rows_per_group, str_at), STRING(), "str"}});
+        }
+        output_format.finalize();
+        out.finalize();
+    }
+
+    const Block read_header{{INT(), "i32"}, {BIGINT(), "i64"}, {STRING(), "str"}};
+    const RowType name_and_types{{"i32", INT()}, {"i64", BIGINT()}, {"str", STRING()}};
+    const auto read_values = [&](const ColumnIndexFilter * filter, std::unordered_set<Int32> & skipped)
+    {
+        ReadBufferFromFilePRead in(file->path());
+        ParquetMetaBuilder metaBuilder{.collectPageIndex = true};
+        metaBuilder.format_settings.parquet.bloom_filter_push_down = true;
+        metaBuilder.build(in, read_header, filter);
+        skipped = metaBuilder.bloomFilterSkippedRowGroups;
+        ColumnIndexRowRangesProvider provider{metaBuilder};
+
+        const FormatSettings format_settings{};
+        VectorizedParquetRecordReader recordReader(read_header, format_settings);
+        std::vector<Int64> values;
+        if (!recordReader.initialize(test::asArrowFileForParquet(in, format_settings), provider))
+            return values;
+        for (auto chunk = recordReader.nextBatch(); chunk.getNumRows() > 0; chunk = recordReader.nextBatch())
+        {
+            const auto & columns = chunk.getColumns();
+            for (size_t row = 0; row < chunk.getNumRows(); ++row)
+            {
+                const Int64 value = columns[1]->getInt(row);
+                EXPECT_EQ(columns[0]->getInt(row), value);
+                EXPECT_EQ(columns[2]->getDataAt(row).toView(), "v" + std::to_string(value));
+                values.push_back(value);
+            }
+        }
+        return values;
+    };
+
+    std::unordered_set<Int32> skipped;
+    const auto all_values = read_values(nullptr, skipped);
+    ASSERT_EQ(all_values.size(), row_groups * rows_per_group);
+    ASSERT_TRUE(skipped.empty());
+
+    const auto test_condition
+        = [&](const std::string & exp, const std::unordered_set<Int64> & matches, const std::unordered_set<Int32> & expected_skipped)
+    {
+        SCOPED_TRACE(exp);
+        const ColumnIndexFilter filter(test::parseFilter(exp, name_and_types).value(), QueryContext::globalContext());
+        const auto pruned_before = ProfileEvents::global_counters[ProfileEvents::ParquetPrunedRowGroups].load(std::memory_order_relaxed);
+        const auto values = read_values(&filter, skipped);
+        const auto pruned_after = ProfileEvents::global_counters[ProfileEvents::ParquetPrunedRowGroups].load(std::memory_order_relaxed);
+
+        EXPECT_EQ(skipped, expected_skipped);
+        EXPECT_EQ(pruned_after - pruned_before, expected_skipped.size());
+        EXPECT_LT(values.size(), all_values.size());
+        for (const Int64 value : values)
+            EXPECT_FALSE(expected_skipped.contains(static_cast<Int32>(value % row_groups)));
+
+        /// Skipped row groups drop no rows that match.
+        std::unordered_set<Int64> all_matching;
+        std::unordered_set<Int64> matching;
+        for (const Int64 value : all_values)
+            if (matches.contains(value))
+                all_matching.insert(value);
+        for (const Int64 value : values)
+            if (matches.contains(value))
+                matching.insert(value);
+        EXPECT_EQ(matching, all_matching);
+        EXPECT_EQ(matching, matches);
+    };
+
+    test_condition("i64 = 201", {201}, {0, 2, 3});
+    test_condition("i32 in (2, 7)", {2, 7}, {0, 1});
+    test_condition("str = 'v203'", {203}, {0, 1, 2});
+    test_condition("str in ('v100', 'v399') and i64 > 0", {100, 399}, {1, 2});
+}
 
 TEST(RowIndex, VirtualColumnRowIndexReader)
 {
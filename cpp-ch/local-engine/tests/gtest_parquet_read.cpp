@@ -37,8 +37,11 @@
 #include <Processors/Formats/Impl/ParquetBlockInputFormat.h>
 #include <QueryPipeline/QueryPipeline.h>
 #include <Storages/Parquet/ArrowUtils.h>
+#include <Storages/Parquet/ParquetMeta.h>
+#include <Storages/Parquet/ParquetMetaCache.h>
 #include <Storages/Parquet/VectorizedParquetRecordReader.h>
 #include <Storages/SubstraitSource/ParquetFormatFile.h>
+#include <base/scope_guard.h>
 #include <gtest/gtest.h>
 #include <parquet/arrow/reader.h>
 #include <parquet/level_conversion.h>
@@ -456,6 +459,52 @@ TEST(ParquetRead, VectorizedColumnReader)
         EXPECT_EQ(col_b.getFloat64(i), i + 1);
 }
 
+TEST(ParquetRead, VectorizedParallelDecode)
+{
+    const std::string sample(test::gtest_data("sample.parquet"));
+    const FormatSettings format_settings{};
+    Block blockHeader({{DOUBLE(), "b"}, {BIGINT(), "a"}});
+
+    /// ReadBufferFromFile seeks and reads, so the decode threads take turns loading their column chunks, while
+    /// ReadBufferFromFilePRead serves them at once through readBigAt.
+    auto read_all = [&](size_t decode_threads, size_t decode_memory_budget, bool pread)
+    {
+        std::unique_ptr<ReadBufferFromFile> in
+            = pread ? std::make_unique<ReadBufferFromFilePRead>(sample) : std::make_unique<ReadBufferFromFile>(sample);
+        EXPECT_EQ(in->supportsReadAt(), pread);
+        ParquetMetaBuilder metaBuilder{.collectPageIndex = true};
+        metaBuilder.build(*in, blockHeader);
+        ColumnIndexRowRangesProvider provider{metaBuilder};
+        VectorizedParquetRecordReader recordReader(blockHeader, format_settings, decode_threads, decode_memory_budget);
+        recordReader.initialize(test::asArrowFileForParquet(*in, format_settings), provider, nullptr, in->supportsReadAt());
+
+        std::vector<Chunk> chunks;
+        for (auto chunk = recordReader.nextBatch(); chunk.getNumRows() > 0; chunk = recordReader.nextBatch())
+            chunks.emplace_back(std::move(chunk));
+        return chunks;
+    };
+
+    const auto expected = read_all(0, 0, false);
+    ASSERT_FALSE(expected.empty());
+    /// A budget of one byte decodes a column at a time, since every column is estimated from its column chunk size.
+    for (const bool pread : {false, true})
+    {
+        for (const auto & [threads, budget] : std::vector<std::pair<size_t, size_t>>{{2, 128_MiB}, {4, 1}})
+        {
+            const auto actual = read_all(threads, budget, pread);
+            ASSERT_EQ(actual.size(), expected.size());
+            for (size_t i = 0; i < expected.size(); ++i)
+            {
+                ASSERT_EQ(actual[i].getNumRows(), expected[i].getNumRows());
+                ASSERT_EQ(actual[i].getNumColumns(), expected[i].getNumColumns());
+                for (size_t col = 0; col < expected[i].getNumColumns(); ++col)
+                    for (size_t row = 0; row < expected[i].getNumRows(); ++row)
+                        EXPECT_EQ(actual[i].getColumns()[col]->compareAt(row, row, *expected[i].getColumns()[col], 1), 0);
+            }
+        }
+    }
+}
+
 INCBIN(_upper_col_parquet_, SOURCE_DIR "/utils/extern-local-engine/tests/json/upper_col_parquet.json");
 TEST(ParquetRead, UpperColRead)
 {
@@ -468,4 +517,58 @@ TEST(ParquetRead, UpperColRead)
 
     debug::headBlock(block);
 }
+
+TEST(ParquetRead, MetaCache)
+{
+    const String path = test::gtest_data("alltypes/alltypes_notnull.parquet");
+    const ParquetFileKey key{.path = path, .modification_time = 1, .file_size = 1};
+    auto build = [&]
+    {
+        ReadBufferFromFile in(path);
+        ParquetMetaBuilder builder{.collectSchema = true};
+        builder.fileKey = key;
+        builder.build(in);
+        return builder.fileMetaData;
+    };
+
+    size_t loads = 0;
+    auto load_first = [&](const std::shared_ptr<parquet::FileMetaData> & metadata)
+    {
+        return [&loads, metadata]
+        {
+            ++loads;
+            return metadata;
+        };
+    };
+
+    auto & cache = ParquetMetaCache::instance();
+    /// Restore the configured capacity for the tests that follow.
+    const size_t max_bytes = cache.maxBytes();
+    SCOPE_EXIT({ ParquetMetaCache::initialize(max_bytes); });
+    ParquetMetaCache::initialize(64_MiB);
+    const size_t hits = cache.hits();
+    const size_t misses = cache.misses();
+    const auto first = build();
+    ASSERT_EQ(cache.count(), 1);
+    /// The second build reuses the parsed footer.
+    EXPECT_EQ(build(), first);
+    EXPECT_EQ(cache.hits(), hits + 1);
+    EXPECT_EQ(cache.misses(), misses + 1);
+
+    /// Another version of the file misses.
+    cache.getOrLoadFileMetaData(ParquetFileKey{.path = path, .modification_time = 2, .file_size = 1}, load_first(first));
+    EXPECT_EQ(loads, 1);
+
+    /// With room for a single footer, adding another one evicts the least recently used.
+    ParquetMetaCache::initialize(cache.sizeInBytes() / 2);
+    build();
+    cache.getOrLoadFileMetaData(ParquetFileKey{.path = path, .modification_time = 3, .file_size = 1}, load_first(first));
+    EXPECT_EQ(cache.count(), 1);
+    cache.getOrLoadFileMetaData(key, load_first(first));
+    EXPECT_EQ(loads, 3);
+
+    ParquetMetaCache::initialize(0);
+    EXPECT_NE(build(), first);
+    EXPECT_EQ(cache.count(), 0);
+}
 #endif
@@ -14,6 +14,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <Columns/ColumnConst.h>
 #include <Core/Block_fwd.h>
 #include <DataTypes/DataTypeArray.h>
 #include <DataTypes/DataTypeDate.h>
@@ -461,3 +462,65 @@ TEST(SparkRow, NullableComplexTypes)
     assertReadConsistentWithWritten(*spark_row_info, *block, type_and_fields);
     EXPECT_TRUE(spark_row_info->getTotalBytes() == 8 + 3 * 8);
 }
+
+TEST(SparkRow, ComplexTypesFromColumns)
+{
+    /// Nested values are read from child columns directly. Results must be the same as going through Fields.
+    const auto decimal_type = std::make_shared<DataTypeDecimal128>(38, 2);
+    const auto array_type = std::make_shared<DataTypeArray>(std::make_shared<DataTypeNullable>(std::make_shared<DataTypeString>()));
+    const auto map_type = std::make_shared<DataTypeMap>(std::make_shared<DataTypeString>(), std::make_shared<DataTypeNullable>(decimal_type));
+    const auto tuple_type = std::make_shared<DataTypeTuple>(DataTypes{
+        std::make_shared<DataTypeNullable>(std::make_shared<DataTypeInt32>()),
+        std::make_shared<DataTypeArray>(std::make_shared<DataTypeDecimal32>(9, 2)),
+        std::make_shared<DataTypeString>()});
+    const auto nested_array_type = std::make_shared<DataTypeArray>(
+        std::make_shared<DataTypeArray>(std::make_shared<DataTypeNullable>(std::make_shared<DataTypeInt64>())));
+
+    const std::vector<std::pair<DataTypePtr, std::vector<Field>>> type_and_rows = {
+        {array_type, {Array{}, Array{String("a"), Null{}, String("a string longer than eight bytes")}, Array{Null{}}}},
+        {map_type,
+         {Map{},
+          Map{Tuple{String("k1"), DecimalField<Decimal128>(Decimal128(12345), 2)}, Tuple{String("k2"), Null{}}},
+          Map{Tuple{String(""), DecimalField<Decimal128>(Decimal128(-1), 2)}}}},
+        {tuple_type,
+         {Tuple{Int32(1), Array{DecimalField<Decimal32>(Decimal32(100), 2)}, String("x")},
+          Tuple{Null{}, Array{}, String("")},
+          Tuple{
+              Int32(-3),
+              Array{DecimalField<Decimal32>(Decimal32(-5), 2), DecimalField<Decimal32>(Decimal32(7), 2)},
+              String("yz")}}},
+        {nested_array_type, {Array{Array{Int64(1), Null{}, Int64(3)}, Array{}}, Array{}, Array{Array{Int64(4)}}}},
+    };
+
+    for (const auto & [type, rows] : type_and_rows)
+    {
+        auto mutable_column = type->createColumn();
+        for (const auto & row : rows)
+            mutable_column->insert(row);
+        ColumnPtr column = std::move(mutable_column);
+        ASSERT_TRUE(BackingDataLengthCalculator::isColumnSupportDirectAccess(type, *column)) << type->getName();
+        EXPECT_FALSE(BackingDataLengthCalculator::isColumnSupportDirectAccess(type, *ColumnConst::create(column->cut(0, 1), 3)));
+
+        const BackingDataLengthCalculator calculator(type);
+        std::vector<int64_t> offsets(rows.size());
+        int64_t total_bytes = 0;
+        for (size_t i = 0; i < rows.size(); ++i)
+        {
+            const auto length = calculator.calculate(*column, i);
+            EXPECT_EQ(length, calculator.calculate(rows[i])) << type->getName() << " row " << i;
+            offsets[i] = total_bytes;
+            total_bytes += length;
+        }
+
+        String field_buffer(total_bytes, 0);
+        String column_buffer(total_bytes, 0);
+        std::vector<int64_t> field_cursor(rows.size(), 0);
+        std::vector<int64_t> column_cursor(rows.size(), 0);
+        VariableLengthDataWriter field_writer(type, field_buffer.data(), offsets, field_cursor);
+        VariableLengthDataWriter column_writer(type, column_buffer.data(), offsets, column_cursor);
+        for (size_t i = 0; i < rows.size(); ++i)
+            EXPECT_EQ(field_writer.write(i, rows[i], 0), column_writer.write(i, *column, i, 0)) << type->getName() << " row " << i;
+        EXPECT_EQ(field_cursor, column_cursor);
+        EXPECT_EQ(field_buffer, column_buffer) << type->getName();
+    }
+}
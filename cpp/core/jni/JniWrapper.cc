@@ -73,6 +73,29 @@ jbyteArray toJByteArray(JNIEnv* env, const std::vector<uint8_t>& bytes, const st
   return out;
 }
 
+std::vector<bool> toBoolVector(JNIEnv* env, jbooleanArray array) {
+  const jsize length = env->GetArrayLength(array);
+  std::vector<jboolean> values(length);
+  env->GetBooleanArrayRegion(array, 0, length, values.data());
+  return std::vector<bool>(values.begin(), values.end());
+}
+
+/// Attaches the sampled bounds of a range partitioning, so the shuffle writer computes the partition ids from the
+/// leading sort key columns. No-op when `rangeBoundsHandle` is invalid.
+void setRangeBounds(
+    JNIEnv* env,
+    ShuffleWriterOptions& options,
+    jlong rangeBoundsHandle,
+    jbooleanArray rangeAscending,
+    jbooleanArray rangeNullsFirst) {
+  if (rangeBoundsHandle == kInvalidObjectHandle) {
+    return;
+  }
+  options.rangeBounds = ObjectStore::retrieve<ColumnarBatch>(rangeBoundsHandle);
+  options.rangeAscending = toBoolVector(env, rangeAscending);
+  options.rangeNullsFirst = toBoolVector(env, rangeNullsFirst);
+}
+
 /// Internal backend consists of empty implementations of Runtime API and MemoryManager API.
 /// The backend is used for saving contextual objects only.
 ///
@@ -181,7 +204,7 @@ jint JNI_OnLoad(JavaVM* vm, void* reserved) {
   jniUnsafeByteBufferSize = env->GetMethodID(jniUnsafeByteBufferClass, "size", "()J");
 
   splitResultClass = createGlobalClassReferenceOrError(env, "Lorg/apache/gluten/vectorized/GlutenSplitResult;");
-  splitResultConstructor = getMethodIdOrError(env, splitResultClass, "<init>", "(JJJJJJJJJJDJ[J[J[J)V");
+  splitResultConstructor = getMethodIdOrError(env, splitResultClass, "<init>", "(JJJJJJJJJJDJ[J[J[JJJJ)V");
 
   metricsBuilderClass = createGlobalClassReferenceOrError(env, "Lorg/apache/gluten/metrics/Metrics;");
 
@@ -878,7 +901,10 @@ JNIEXPORT jlong JNICALL Java_org_apache_gluten_vectorized_ShuffleWriterJniWrappe
     jdouble splitBufferReallocThreshold,
     jint partitionBufferEvictThreshold,
     jlong partitionWriterHandle,
-    jboolean rowBasedChecksumEnabled) {
+    jboolean rowBasedChecksumEnabled,
+    jlong rangeBoundsHandle,
+    jbooleanArray rangeAscending,
+    jbooleanArray rangeNullsFirst) {
   JNI_METHOD_START
   const auto ctx = getRuntime(env, wrapper);
 
@@ -895,6 +921,7 @@ JNIEXPORT jlong JNICALL Java_org_apache_gluten_vectorized_ShuffleWriterJniWrappe
       splitBufferReallocThreshold,
       partitionBufferEvictThreshold);
   shuffleWriterOptions->rowBasedChecksumEnabled = rowBasedChecksumEnabled;
+  setRangeBounds(env, *shuffleWriterOptions, rangeBoundsHandle, rangeAscending, rangeNullsFirst);
 
   return ctx->saveObject(ctx->createShuffleWriter(numPartitions, partitionWriter, shuffleWriterOptions));
   JNI_METHOD_END(kInvalidObjectHandle)
@@ -909,7 +936,10 @@ JNIEXPORT jlong JNICALL Java_org_apache_gluten_vectorized_ShuffleWriterJniWrappe
     jint diskWriteBufferSize,
     jint initialSortBufferSize,
     jboolean useRadixSort,
-    jlong partitionWriterHandle) {
+    jlong partitionWriterHandle,
+    jlong rangeBoundsHandle,
+    jbooleanArray rangeAscending,
+    jbooleanArray rangeNullsFirst) {
   JNI_METHOD_START
   const auto ctx = getRuntime(env, wrapper);
 
@@ -925,6 +955,7 @@ JNIEXPORT jlong JNICALL Java_org_apache_gluten_vectorized_ShuffleWriterJniWrappe
       initialSortBufferSize,
       diskWriteBufferSize,
       static_cast<bool>(useRadixSort));
+  setRangeBounds(env, *shuffleWriterOptions, rangeBoundsHandle, rangeAscending, rangeNullsFirst);
 
   return ctx->saveObject(ctx->createShuffleWriter(numPartitions, partitionWriter, shuffleWriterOptions));
   JNI_METHOD_END(kInvalidObjectHandle)
@@ -939,7 +970,10 @@ JNIEXPORT jlong JNICALL Java_org_apache_gluten_vectorized_ShuffleWriterJniWrappe
     jint splitBufferSize,
     jlong sortBufferMaxSize,
     jstring codecJstr,
-    jlong partitionWriterHandle) {
+    jlong partitionWriterHandle,
+    jlong rangeBoundsHandle,
+    jbooleanArray rangeAscending,
+    jbooleanArray rangeNullsFirst) {
   JNI_METHOD_START
   const auto ctx = getRuntime(env, wrapper);
 
@@ -955,6 +989,7 @@ JNIEXPORT jlong JNICALL Java_org_apache_gluten_vectorized_ShuffleWriterJniWrappe
       splitBufferSize,
       sortBufferMaxSize,
       getCompressionType(env, codecJstr));
+  setRangeBounds(env, *shuffleWriterOptions, rangeBoundsHandle, rangeAscending, rangeNullsFirst);
 
   return ctx->saveObject(ctx->createShuffleWriter(numPartitions, partitionWriter, shuffleWriterOptions));
   JNI_METHOD_END(kInvalidObjectHandle)
@@ -1045,7 +1080,10 @@ JNIEXPORT jobject JNICALL Java_org_apache_gluten_vectorized_ShuffleWriterJniWrap
       shuffleWriter->dictionarySize(),
       partitionLengthArr,
       rawPartitionLengthArr,
-      rowBasedChecksumArr);
+      rowBasedChecksumArr,
+      shuffleWriter->partitionBufferReuseHits(),
+      shuffleWriter->partitionBufferReuseMisses(),
+      shuffleWriter->partitionBufferRecyclerIdleBytes());
 
   return splitResult;
   JNI_METHOD_END(nullptr)
@@ -33,6 +33,11 @@ class ArrowMemoryPool final : public arrow::MemoryPool {
   explicit ArrowMemoryPool(AllocationListener* listener)
       : allocator_(std::make_unique<ListenableMemoryAllocator>(defaultMemoryAllocator().get(), listener)) {}
 
+  // Serves allocations from `delegated` rather than the default allocator. Usage is still reported to `listener`.
+  ArrowMemoryPool(AllocationListener* listener, std::shared_ptr<MemoryAllocator> delegated)
+      : delegated_(std::move(delegated)),
+        allocator_(std::make_unique<ListenableMemoryAllocator>(delegated_.get(), listener)) {}
+
   ~ArrowMemoryPool() override = default;
 
   ArrowMemoryPool(const ArrowMemoryPool&) = delete;
@@ -62,6 +67,7 @@ class ArrowMemoryPool final : public arrow::MemoryPool {
   MemoryAllocator* allocator() const;
 
  private:
+  std::shared_ptr<MemoryAllocator> delegated_ = nullptr;
   std::unique_ptr<MemoryAllocator> allocator_ = nullptr;
 };
 
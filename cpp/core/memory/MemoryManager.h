@@ -20,6 +20,7 @@
 #include "arrow/memory_pool.h"
 #include "memory.pb.h"
 #include "memory/AllocationListener.h"
+#include "memory/MemoryAllocator.h"
 
 namespace gluten {
 
@@ -47,6 +48,15 @@ class MemoryManager {
   // If the memory pool with the given name does not exist, it will create a new one and return it.
   virtual std::shared_ptr<arrow::MemoryPool> getOrCreateArrowMemoryPool(const std::string& name) = 0;
 
+  // Create a new Arrow memory pool with the given name that serves allocations through `allocator`. Memory usage is
+  // still accounted to this memory manager. If a live pool already has the name, the new one is registered under a
+  // unique variant of it. The default implementation ignores `allocator`.
+  virtual std::shared_ptr<arrow::MemoryPool> createArrowMemoryPool(
+      const std::string& name,
+      std::shared_ptr<MemoryAllocator> allocator) {
+    return getOrCreateArrowMemoryPool(name);
+  }
+
   virtual const MemoryUsageStats collectMemoryUsageStats() const = 0;
 
   virtual const int64_t shrink(int64_t size) = 0;
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "memory/ColumnarBatch.h"
 #include "shuffle/Partitioning.h"
 #include "utils/Compression.h"
 #include "utils/Macros.h"
@@ -24,11 +25,15 @@
 #include <arrow/ipc/options.h>
 #include <arrow/util/compression.h>
 #include <thread>
+#include <vector>
 
 namespace gluten {
 
 static constexpr int16_t kDefaultBatchSize = 4096;
 static constexpr int32_t kDefaultPartitionBufferEvictThreshold = -1;
+static constexpr int64_t kDefaultPartitionBufferRecyclerCapacity = 0;
+static constexpr bool kDefaultAdaptivePartitionBufferSize = false;
+static constexpr double kDefaultPartitionRowRateEmaAlpha = 0.3;
 static constexpr int32_t kDefaultShuffleWriterBufferSize = 4096;
 static constexpr int64_t kDefaultSortBufferThreshold = 64 << 20;
 static constexpr int64_t kDefaultPushMemoryThreshold = 4096;
@@ -81,6 +86,14 @@ struct ShuffleWriterOptions {
   int32_t startPartitionId = 0;
   bool rowBasedChecksumEnabled = false;
 
+  // Sorted bounds of a range partitioning, one row per bound and one column per sort key. When set, input batches
+  // start with the sort key columns and partition ids are computed natively, instead of being read from a leading
+  // partition id column.
+  std::shared_ptr<ColumnarBatch> rangeBounds{nullptr};
+  // Sort direction and null ordering of each range partitioning key.
+  std::vector<bool> rangeAscending{};
+  std::vector<bool> rangeNullsFirst{};
+
   ShuffleWriterOptions(ShuffleWriterType shuffleWriterType) : shuffleWriterType(shuffleWriterType) {}
 
   ShuffleWriterOptions(ShuffleWriterType shuffleWriterType, Partitioning partitioning, int32_t startPartitionId)
@@ -93,6 +106,14 @@ struct HashShuffleWriterOptions : ShuffleWriterOptions {
   int32_t splitBufferSize = kDefaultShuffleWriterBufferSize;
   double splitBufferReallocThreshold = kDefaultSplitBufferReallocThreshold;
   int32_t partitionBufferEvictThreshold = kDefaultPartitionBufferEvictThreshold;
+  // Max bytes of freed partition buffers kept in the executor-wide PartitionBufferRecycler for reuse by subsequent
+  // writers. 0 disables recycling.
+  int64_t partitionBufferRecyclerCapacity = kDefaultPartitionBufferRecyclerCapacity;
+  // Size each partition buffer from the moving average of rows the partition receives per input batch, instead of
+  // giving every partition the same size. Helps skewed keys.
+  bool adaptivePartitionBufferSize = kDefaultAdaptivePartitionBufferSize;
+  // Smoothing factor of the per-partition row rate, in (0, 1]. Larger values react faster to distribution changes.
+  double partitionRowRateEmaAlpha = kDefaultPartitionRowRateEmaAlpha;
 
   HashShuffleWriterOptions() : ShuffleWriterOptions(ShuffleWriterType::kHashShuffle) {}
 
@@ -222,5 +243,10 @@ struct ShuffleWriterMetrics {
   std::vector<int64_t> partitionLengths{};
   std::vector<int64_t> rawPartitionLengths{}; // Uncompressed size.
   std::vector<int64_t> rowBasedChecksums{}; // Per-partition row-based checksums.
+  int64_t partitionBufferReuseHits{0}; // Partition buffer allocations served by the recycler.
+  int64_t partitionBufferReuseMisses{0}; // Recyclable partition buffer allocations that missed the recycler.
+  int64_t partitionBufferRecyclerIdleBytes{0}; // Idle bytes held by the executor-wide recycler after the write.
+  std::vector<int64_t> partitionBufferResizes{}; // Per-partition count of partition buffer resizes.
+  std::vector<int64_t> partitionBufferEvictedBytes{}; // Per-partition raw bytes evicted from partition buffers.
 };
 } // namespace gluten
@@ -0,0 +1,237 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shuffle/PartitionBufferRecycler.h"
+#include "utils/Exception.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace gluten {
+
+std::shared_ptr<PartitionBufferRecycler> PartitionBufferRecycler::instance() {
+  // defaultMemoryAllocator() is initialized before the recycler, so it outlives the cached blocks at exit.
+  static auto recycler = std::make_shared<PartitionBufferRecycler>(defaultMemoryAllocator().get());
+  return recycler;
+}
+
+PartitionBufferRecycler::~PartitionBufferRecycler() {
+  capacity_ = 0;
+  trim(std::numeric_limits<int64_t>::max());
+}
+
+int32_t PartitionBufferRecycler::sizeClassOf(int64_t size) {
+  if (size < kMinClassSize || size > kMaxClassSize) {
+    return -1;
+  }
+  // ceil(log2(size)) - log2(kMinClassSize)
+  const int32_t log2Ceil = 64 - __builtin_clzll(static_cast<uint64_t>(size - 1));
+  return std::max(0, log2Ceil - 12);
+}
+
+uint32_t PartitionBufferRecycler::currentNumaNode() {
+#if defined(__linux__) && defined(SYS_getcpu)
+  unsigned cpu = 0;
+  unsigned node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return node % kMaxNumaNodes;
+  }
+#endif
+  return 0;
+}
+
+void PartitionBufferRecycler::setCapacity(int64_t capacity) {
+  capacity_ = capacity;
+  const auto overflow = cachedBytes_ - capacity;
+  if (overflow > 0) {
+    trim(overflow);
+  }
+}
+
+void* PartitionBufferRecycler::acquire(int32_t sizeClass) {
+  GLUTEN_DCHECK(sizeClass >= 0 && sizeClass < kNumClasses, "Invalid size class: " + std::to_string(sizeClass));
+  auto& node = nodes_[currentNumaNode()];
+  std::lock_guard<std::mutex> l(node.mutex);
+  auto& freeList = node.freeLists[sizeClass];
+  if (freeList.empty()) {
+    return nullptr;
+  }
+  auto* p = freeList.back();
+  freeList.pop_back();
+  cachedBytes_ -= classSize(sizeClass);
+  return p;
+}
+
+bool PartitionBufferRecycler::release(void* p, int32_t sizeClass) {
+  GLUTEN_DCHECK(sizeClass >= 0 && sizeClass < kNumClasses, "Invalid size class: " + std::to_string(sizeClass));
+  const auto size = classSize(sizeClass);
+  if (cachedBytes_.fetch_add(size) + size > capacity_) {
+    cachedBytes_ -= size;
+    return false;
+  }
+  auto& node = nodes_[currentNumaNode()];
+  std::lock_guard<std::mutex> l(node.mutex);
+  node.freeLists[sizeClass].push_back(p);
+  return true;
+}
+
+int64_t PartitionBufferRecycler::trim(int64_t size) {
+  int64_t released = 0;
+  for (int32_t sizeClass = kNumClasses - 1; sizeClass >= 0 && released < size; --sizeClass) {
+    const auto blockSize = classSize(sizeClass);
+    for (auto& node : nodes_) {
+      std::lock_guard<std::mutex> l(node.mutex);
+      auto& freeList = node.freeLists[sizeClass];
+      while (!freeList.empty() && released < size) {
+        delegated_->free(freeList.back(), blockSize);
+        freeList.pop_back();
+        cachedBytes_ -= blockSize;
+        released += blockSize;
+      }
+    }
+  }
+  return released;
+}
+
+bool RecyclingMemoryAllocator::allocate(int64_t size, void** out) {
+  return allocateAligned(PartitionBufferRecycler::kAlignment, size, out);
+}
+
+bool RecyclingMemoryAllocator::allocateZeroFilled(int64_t nmemb, int64_t size, void** out) {
+  GLUTEN_CHECK(size == 0 || nmemb <= std::numeric_limits<int64_t>::max() / size, "nmemb * size overflows int64_t");
+  if (!allocateAligned(PartitionBufferRecycler::kAlignment, nmemb * size, out)) {
+    return false;
+  }
+  std::memset(*out, 0, nmemb * size);
+  return true;
+}
+
+bool RecyclingMemoryAllocator::allocateAligned(uint64_t alignment, int64_t size, void** out) {
+  const auto sizeClass = PartitionBufferRecycler::sizeClassOf(size);
+  if (sizeClass < 0) {
+    if (!recycler_->delegated()->allocateAligned(alignment, size, out)) {
+      return false;
+    }
+    updateBytes(size);
+    return true;
+  }
+
+  const auto blockSize = PartitionBufferRecycler::classSize(sizeClass);
+  // Reported before allocating, like ListenableMemoryAllocator does, so that a failed reservation allocates nothing.
+  updateRoundingBytes(blockSize - size);
+  if (alignment <= PartitionBufferRecycler::kAlignment) {
+    if (auto* p = recycler_->acquire(sizeClass)) {
+      *out = p;
+      ++reuseHits_;
+      updateBytes(blockSize);
+      return true;
+    }
+  }
+  ++reuseMisses_;
+  if (!recycler_->delegated()->allocateAligned(
+          std::max(alignment, PartitionBufferRecycler::kAlignment), blockSize, out)) {
+    updateRoundingBytes(size - blockSize);
+    return false;
+  }
+  updateBytes(blockSize);
+  return true;
+}
+
+bool RecyclingMemoryAllocator::reallocate(void* p, int64_t size, int64_t newSize, void** out) {
+  return reallocateAligned(p, PartitionBufferRecycler::kAlignment, size, newSize, out);
+}
+
+bool RecyclingMemoryAllocator::reallocateAligned(
+    void* p,
+    uint64_t alignment,
+    int64_t size,
+    int64_t newSize,
+    void** out) {
+  GLUTEN_CHECK(p != nullptr, "reallocate with nullptr");
+  if (newSize <= 0) {
+    return false;
+  }
+  const auto sizeClass = PartitionBufferRecycler::sizeClassOf(size);
+  const auto newSizeClass = PartitionBufferRecycler::sizeClassOf(newSize);
+  if (sizeClass >= 0 && sizeClass == newSizeClass) {
+    // The block already has room for newSize.
+    updateRoundingBytes(size - newSize);
+    *out = p;
+    return true;
+  }
+  if (sizeClass < 0 && newSizeClass < 0) {
+    if (!recycler_->delegated()->reallocateAligned(p, alignment, size, newSize, out)) {
+      return false;
+    }
+    updateBytes(newSize - size);
+    return true;
+  }
+  void* reallocated = nullptr;
+  if (!allocateAligned(alignment, newSize, &reallocated)) {
+    return false;
+  }
+  std::memcpy(reallocated, p, std::min(size, newSize));
+  free(p, size);
+  *out = reallocated;
+  return true;
+}
+
+bool RecyclingMemoryAllocator::free(void* p, int64_t size) {
+  GLUTEN_CHECK(p != nullptr, "free with nullptr");
+  const auto sizeClass = PartitionBufferRecycler::sizeClassOf(size);
+  if (sizeClass < 0) {
+    recycler_->delegated()->free(p, size);
+    updateBytes(-size);
+    return true;
+  }
+  const auto blockSize = PartitionBufferRecycler::classSize(sizeClass);
+  if (!recycler_->release(p, sizeClass)) {
+    recycler_->delegated()->free(p, blockSize);
+  }
+  updateBytes(-blockSize);
+  updateRoundingBytes(size - blockSize);
+  return true;
+}
+
+int64_t RecyclingMemoryAllocator::getBytes() const {
+  return bytes_;
+}
+
+int64_t RecyclingMemoryAllocator::peakBytes() const {
+  return peakBytes_;
+}
+
+void RecyclingMemoryAllocator::updateRoundingBytes(int64_t diff) {
+  if (listener_ != nullptr && diff != 0) {
+    listener_->allocationChanged(diff);
+  }
+}
+
+void RecyclingMemoryAllocator::updateBytes(int64_t diff) {
+  const auto bytes = bytes_ += diff;
+  auto peak = peakBytes_.load();
+  while (bytes > peak && !peakBytes_.compare_exchange_weak(peak, bytes)) {
+  }
+}
+
+} // namespace gluten
@@ -0,0 +1,158 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "memory/AllocationListener.h"
+#include "memory/MemoryAllocator.h"
+
+namespace gluten {
+
+/// Executor-wide cache of freed partition buffers, shared by all hash shuffle writers in the process.
+///
+/// Blocks are kept in power-of-two size classes and bucketed by the NUMA node of the thread that released them, so a
+/// writer that starts after another one finished picks up memory that is already faulted in and local to its node.
+/// Idle blocks are not accounted to any task. The total idle size is bounded by `capacity`, and blocks can be dropped
+/// at any time via `trim`.
+class PartitionBufferRecycler {
+ public:
+  // Requests smaller than this are served by malloc directly. They are cheap to allocate and not worth caching.
+  static constexpr int64_t kMinClassSize = 4L << 10;
+  // Requests larger than this are not cached to avoid holding huge idle blocks.
+  static constexpr int64_t kMaxClassSize = 64L << 20;
+  static constexpr uint32_t kNumClasses = 15; // 4KiB .. 64MiB
+  static constexpr uint32_t kMaxNumaNodes = 8;
+  static constexpr uint64_t kAlignment = 64;
+
+  static std::shared_ptr<PartitionBufferRecycler> instance();
+
+  explicit PartitionBufferRecycler(MemoryAllocator* delegated) : delegated_(delegated) {}
+
+  ~PartitionBufferRecycler();
+
+  // Returns the size class index for `size`, or -1 if the size is not recyclable.
+  static int32_t sizeClassOf(int64_t size);
+
+  static int64_t classSize(int32_t sizeClass) {
+    return kMinClassSize << sizeClass;
+  }
+
+  // Sets the max bytes of idle blocks. Blocks beyond the new capacity are freed.
+  void setCapacity(int64_t capacity);
+
+  int64_t capacity() const {
+    return capacity_;
+  }
+
+  // Pops an idle block of the given class that was released on the current NUMA node. Returns nullptr on miss.
+  void* acquire(int32_t sizeClass);
+
+  // Gives the block back to the cache. Returns false if the cache is full, in which case the caller owns the block.
+  bool release(void* p, int32_t sizeClass);
+
+  // Frees idle blocks, largest classes first, until at least `size` bytes are released or the cache is empty.
+  // Returns the released bytes.
+  int64_t trim(int64_t size);
+
+  int64_t cachedBytes() const {
+    return cachedBytes_;
+  }
+
+  MemoryAllocator* delegated() const {
+    return delegated_;
+  }
+
+ private:
+  struct NodeCache {
+    std::mutex mutex;
+    std::array<std::vector<void*>, kNumClasses> freeLists;
+  };
+
+  static uint32_t currentNumaNode();
+
+  MemoryAllocator* const delegated_;
+  std::array<NodeCache, kMaxNumaNodes> nodes_;
+  std::atomic_int64_t capacity_{0};
+  std::atomic_int64_t cachedBytes_{0};
+};
+
+/// Per-writer allocator that serves partition buffers from the process-wide PartitionBufferRecycler.
+///
+/// Sits below ListenableMemoryAllocator, so every live buffer is still accounted to the owning task through the memory
+/// manager. Only the backing blocks outlive the task. Reallocations that stay within the current size class are done
+/// in place.
+///
+/// ListenableMemoryAllocator reports the requested sizes. The difference to the size class a block is rounded up to is
+/// reported to `listener`, so the task is charged for the whole block.
+class RecyclingMemoryAllocator final : public MemoryAllocator {
+ public:
+  explicit RecyclingMemoryAllocator(
+      std::shared_ptr<PartitionBufferRecycler> recycler,
+      AllocationListener* listener = nullptr)
+      : recycler_(std::move(recycler)), listener_(listener) {}
+
+  bool allocate(int64_t size, void** out) override;
+
+  bool allocateZeroFilled(int64_t nmemb, int64_t size, void** out) override;
+
+  bool allocateAligned(uint64_t alignment, int64_t size, void** out) override;
+
+  bool reallocate(void* p, int64_t size, int64_t newSize, void** out) override;
+
+  bool reallocateAligned(void* p, uint64_t alignment, int64_t size, int64_t newSize, void** out) override;
+
+  bool free(void* p, int64_t size) override;
+
+  int64_t getBytes() const override;
+
+  int64_t peakBytes() const override;
+
+  const std::shared_ptr<PartitionBufferRecycler>& recycler() const {
+    return recycler_;
+  }
+
+  // Number of block allocations served from the recycler.
+  int64_t reuseHits() const {
+    return reuseHits_;
+  }
+
+  // Number of recyclable block allocations that fell back to the delegated allocator.
+  int64_t reuseMisses() const {
+    return reuseMisses_;
+  }
+
+ private:
+  void updateBytes(int64_t diff);
+
+  // Reports the change of the rounding overhead, i.e. block size minus requested size.
+  void updateRoundingBytes(int64_t diff);
+
+  std::shared_ptr<PartitionBufferRecycler> recycler_;
+  AllocationListener* const listener_;
+  std::atomic_int64_t bytes_{0};
+  std::atomic_int64_t peakBytes_{0};
+  std::atomic_int64_t reuseHits_{0};
+  std::atomic_int64_t reuseMisses_{0};
+};
+
+} // namespace gluten
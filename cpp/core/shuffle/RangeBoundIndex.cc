@@ -0,0 +1,139 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shuffle/RangeBoundIndex.h"
+#include "utils/Exception.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace gluten {
+
+namespace {
+
+// Number of searches run in lock-step.
+constexpr int64_t kBatch = 8;
+
+inline bool lessThan(const uint64_t* a, const uint64_t* b, int32_t keyWords) {
+  for (auto i = 0; i < keyWords; ++i) {
+    if (a[i] != b[i]) {
+      return a[i] < b[i];
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+RangeBoundIndex::RangeBoundIndex(const std::vector<uint64_t>& bounds, int32_t keyWords)
+    : keyWords_(keyWords), numBounds_(keyWords > 0 ? bounds.size() / keyWords : 0) {
+  GLUTEN_CHECK(keyWords > 0, "Range partitioning key must have at least one word");
+  GLUTEN_CHECK(bounds.size() % keyWords == 0, "Range bounds size is not a multiple of the key width");
+  for (auto i = 1; i < numBounds_; ++i) {
+    GLUTEN_CHECK(
+        !lessThan(&bounds[i * keyWords], &bounds[(i - 1) * keyWords], keyWords), "Range bounds are not sorted");
+  }
+
+  while ((1L << depth_) <= numBounds_) {
+    ++depth_;
+  }
+  const auto numNodes = 1UL << depth_;
+  // Padding nodes hold the max key so the search never goes right of them.
+  tree_.assign(numNodes * keyWords_, std::numeric_limits<uint64_t>::max());
+  rank_.assign(numNodes, numBounds_);
+  int32_t next = 0;
+  build(bounds, 1, next);
+}
+
+void RangeBoundIndex::build(const std::vector<uint64_t>& bounds, uint64_t node, int32_t& next) {
+  if (node >= rank_.size()) {
+    return;
+  }
+  build(bounds, 2 * node, next);
+  if (next < numBounds_) {
+    std::copy_n(&bounds[next * keyWords_], keyWords_, &tree_[node * keyWords_]);
+    rank_[node] = next;
+  }
+  ++next;
+  build(bounds, 2 * node + 1, next);
+}
+
+int32_t RangeBoundIndex::toPartitionId(uint64_t node) const {
+  // Undo the right turns taken after the last left turn. The result is the first node not less than the key, or 0 if
+  // all nodes are less than the key.
+  node >>= __builtin_ffsll(~node);
+  return node == 0 ? numBounds_ : rank_[node];
+}
+
+template <int32_t kKeyWords>
+void RangeBoundIndex::searchFixedWidth(const uint64_t* keys, int64_t numKeys, int32_t* out) const {
+  const auto* tree = tree_.data();
+  int64_t row = 0;
+  for (; row + kBatch <= numKeys; row += kBatch) {
+    uint64_t nodes[kBatch];
+    std::fill_n(nodes, kBatch, 1);
+    for (auto level = 0; level < depth_; ++level) {
+      for (auto i = 0; i < kBatch; ++i) {
+        const auto* key = keys + (row + i) * kKeyWords;
+        const auto* bound = tree + nodes[i] * kKeyWords;
+        bool less;
+        if constexpr (kKeyWords == 1) {
+          less = bound[0] < key[0];
+        } else {
+          less = bound[0] < key[0] || (bound[0] == key[0] && bound[1] < key[1]);
+        }
+        nodes[i] = 2 * nodes[i] + less;
+        // Children of the next level are 2 * node and 2 * node + 1, usually on the same cache line.
+        __builtin_prefetch(tree + 2 * nodes[i] * kKeyWords);
+      }
+    }
+    for (auto i = 0; i < kBatch; ++i) {
+      out[row + i] = toPartitionId(nodes[i]);
+    }
+  }
+  search(keys + row * kKeyWords, numKeys - row, out + row);
+}
+
+void RangeBoundIndex::search(const uint64_t* keys, int64_t numKeys, int32_t* out) const {
+  for (int64_t row = 0; row < numKeys; ++row) {
+    const auto* key = keys + row * keyWords_;
+    uint64_t node = 1;
+    for (auto level = 0; level < depth_; ++level) {
+      node = 2 * node + lessThan(&tree_[node * keyWords_], key, keyWords_);
+    }
+    out[row] = toPartitionId(node);
+  }
+}
+
+void RangeBoundIndex::partitionIds(const uint64_t* keys, int64_t numKeys, int32_t* out) const {
+  if (numBounds_ == 0) {
+    std::fill_n(out, numKeys, 0);
+    return;
+  }
+  switch (keyWords_) {
+    case 1:
+      searchFixedWidth<1>(keys, numKeys, out);
+      break;
+    case 2:
+      searchFixedWidth<2>(keys, numKeys, out);
+      break;
+    default:
+      search(keys, numKeys, out);
+  }
+}
+
+} // namespace gluten
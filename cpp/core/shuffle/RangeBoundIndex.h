@@ -0,0 +1,70 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace gluten {
+
+/// Search index over the bounds of a range partitioning.
+///
+/// Bounds and keys are normalized sort keys: fixed-width sequences of `keyWords` uint64 words that compare
+/// lexicographically in the sort order of the partitioning. The partition id of a key is the number of bounds less
+/// than the key, the same as Spark's RangePartitioner.
+///
+/// The bounds are stored in Eytzinger (BFS) order and padded to a complete tree, so the top levels of the search share
+/// cache lines and every search runs the same number of steps without data-dependent branches. Searches for a group
+/// of keys are interleaved to overlap their cache misses.
+class RangeBoundIndex {
+ public:
+  // `bounds` holds `numBounds * keyWords` words, sorted ascending.
+  RangeBoundIndex(const std::vector<uint64_t>& bounds, int32_t keyWords);
+
+  int32_t numBounds() const {
+    return numBounds_;
+  }
+
+  int32_t keyWords() const {
+    return keyWords_;
+  }
+
+  // Writes the partition ids of `numKeys` keys laid out contiguously in `keys`.
+  void partitionIds(const uint64_t* keys, int64_t numKeys, int32_t* out) const;
+
+ private:
+  template <int32_t kKeyWords>
+  void searchFixedWidth(const uint64_t* keys, int64_t numKeys, int32_t* out) const;
+
+  void search(const uint64_t* keys, int64_t numKeys, int32_t* out) const;
+
+  void build(const std::vector<uint64_t>& bounds, uint64_t node, int32_t& next);
+
+  int32_t toPartitionId(uint64_t node) const;
+
+  const int32_t keyWords_;
+  const int32_t numBounds_;
+  // Depth of the complete tree. Every search takes this many steps.
+  int32_t depth_{0};
+  // 1-based Eytzinger layout of the bounds, `keyWords_` words per node. Node 0 is unused.
+  std::vector<uint64_t> tree_;
+  // Sorted index of each node. Padding nodes rank after all bounds.
+  std::vector<int32_t> rank_;
+};
+
+} // namespace gluten
@@ -107,6 +107,26 @@ const std::vector<int64_t>& ShuffleWriter::rowBasedChecksums() const {
   return metrics_.rowBasedChecksums;
 }
 
+int64_t ShuffleWriter::partitionBufferReuseHits() const {
+  return metrics_.partitionBufferReuseHits;
+}
+
+int64_t ShuffleWriter::partitionBufferReuseMisses() const {
+  return metrics_.partitionBufferReuseMisses;
+}
+
+int64_t ShuffleWriter::partitionBufferRecyclerIdleBytes() const {
+  return metrics_.partitionBufferRecyclerIdleBytes;
+}
+
+const std::vector<int64_t>& ShuffleWriter::partitionBufferResizes() const {
+  return metrics_.partitionBufferResizes;
+}
+
+const std::vector<int64_t>& ShuffleWriter::partitionBufferEvictedBytes() const {
+  return metrics_.partitionBufferEvictedBytes;
+}
+
 ShuffleWriter::ShuffleWriter(int32_t numPartitions, Partitioning partitioning)
     : numPartitions_(numPartitions), partitioning_(partitioning) {}
 } // namespace gluten
@@ -69,6 +69,16 @@ class ShuffleWriter : public Reclaimable {
 
   const std::vector<int64_t>& rowBasedChecksums() const;
 
+  int64_t partitionBufferReuseHits() const;
+
+  int64_t partitionBufferReuseMisses() const;
+
+  int64_t partitionBufferRecyclerIdleBytes() const;
+
+  const std::vector<int64_t>& partitionBufferResizes() const;
+
+  const std::vector<int64_t>& partitionBufferEvictedBytes() const;
+
  protected:
   ShuffleWriter(int32_t numPartitions, Partitioning partitioning);
 
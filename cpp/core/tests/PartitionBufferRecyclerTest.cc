@@ -0,0 +1,155 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shuffle/PartitionBufferRecycler.h"
+#include <gtest/gtest.h>
+
+using namespace gluten;
+
+namespace {
+class CountingListener final : public AllocationListener {
+ public:
+  void allocationChanged(int64_t diff) override {
+    bytes_ += diff;
+  }
+
+  int64_t currentBytes() override {
+    return bytes_;
+  }
+
+ private:
+  int64_t bytes_{0};
+};
+} // namespace
+
+TEST(PartitionBufferRecycler, sizeClass) {
+  ASSERT_EQ(PartitionBufferRecycler::sizeClassOf(0), -1);
+  ASSERT_EQ(PartitionBufferRecycler::sizeClassOf(PartitionBufferRecycler::kMinClassSize - 1), -1);
+  ASSERT_EQ(PartitionBufferRecycler::sizeClassOf(PartitionBufferRecycler::kMinClassSize), 0);
+  ASSERT_EQ(PartitionBufferRecycler::sizeClassOf(PartitionBufferRecycler::kMinClassSize + 1), 1);
+  ASSERT_EQ(PartitionBufferRecycler::sizeClassOf(PartitionBufferRecycler::kMaxClassSize), 14);
+  ASSERT_EQ(PartitionBufferRecycler::sizeClassOf(PartitionBufferRecycler::kMaxClassSize + 1), -1);
+  ASSERT_EQ(PartitionBufferRecycler::classSize(14), PartitionBufferRecycler::kMaxClassSize);
+}
+
+TEST(PartitionBufferRecycler, reuseAcrossAllocators) {
+  StdMemoryAllocator backing;
+  auto recycler = std::make_shared<PartitionBufferRecycler>(&backing);
+  recycler->setCapacity(1L << 20);
+
+  void* first = nullptr;
+  {
+    RecyclingMemoryAllocator allocator(recycler);
+    ASSERT_TRUE(allocator.allocateAligned(64, 10000, &first));
+    ASSERT_EQ(allocator.getBytes(), 16384);
+    ASSERT_EQ(allocator.reuseMisses(), 1);
+    ASSERT_TRUE(allocator.free(first, 10000));
+    ASSERT_EQ(allocator.getBytes(), 0);
+  }
+  ASSERT_EQ(recycler->cachedBytes(), 16384);
+  ASSERT_EQ(backing.getBytes(), 16384);
+
+  // A new allocator, e.g. from the next task, gets the same block back.
+  RecyclingMemoryAllocator allocator(recycler);
+  void* second = nullptr;
+  ASSERT_TRUE(allocator.allocateAligned(64, 12000, &second));
+  ASSERT_EQ(second, first);
+  ASSERT_EQ(allocator.reuseHits(), 1);
+  ASSERT_EQ(recycler->cachedBytes(), 0);
+
+  // Growing within the size class is done in place.
+  void* grown = nullptr;
+  ASSERT_TRUE(allocator.reallocateAligned(second, 64, 12000, 16384, &grown));
+  ASSERT_EQ(grown, second);
+
+  // Growing beyond the size class moves to a larger block and keeps the data.
+  static_cast<char*>(grown)[100] = 'x';
+  void* moved = nullptr;
+  ASSERT_TRUE(allocator.reallocateAligned(grown, 64, 16384, 20000, &moved));
+  ASSERT_EQ(static_cast<char*>(moved)[100], 'x');
+  ASSERT_EQ(allocator.getBytes(), 32768);
+  ASSERT_EQ(recycler->cachedBytes(), 16384);
+
+  ASSERT_TRUE(allocator.free(moved, 20000));
+  ASSERT_EQ(recycler->cachedBytes(), 16384 + 32768);
+}
+
+TEST(PartitionBufferRecycler, capacityAndTrim) {
+  StdMemoryAllocator backing;
+  auto recycler = std::make_shared<PartitionBufferRecycler>(&backing);
+  recycler->setCapacity(16384);
+  RecyclingMemoryAllocator allocator(recycler);
+
+  void* a = nullptr;
+  void* b = nullptr;
+  ASSERT_TRUE(allocator.allocate(16384, &a));
+  ASSERT_TRUE(allocator.allocate(16384, &b));
+  ASSERT_TRUE(allocator.free(a, 16384));
+  // Cache is full, the second block goes back to the backing allocator.
+  ASSERT_TRUE(allocator.free(b, 16384));
+  ASSERT_EQ(recycler->cachedBytes(), 16384);
+  ASSERT_EQ(backing.getBytes(), 16384);
+
+  ASSERT_EQ(recycler->trim(1), 16384);
+  ASSERT_EQ(recycler->cachedBytes(), 0);
+  ASSERT_EQ(backing.getBytes(), 0);
+}
+
+TEST(PartitionBufferRecycler, smallAndHugeBlocksBypassCache) {
+  StdMemoryAllocator backing;
+  auto recycler = std::make_shared<PartitionBufferRecycler>(&backing);
+  recycler->setCapacity(1L << 30);
+  RecyclingMemoryAllocator allocator(recycler);
+
+  void* small = nullptr;
+  ASSERT_TRUE(allocator.allocate(128, &small));
+  ASSERT_TRUE(allocator.free(small, 128));
+  ASSERT_EQ(recycler->cachedBytes(), 0);
+  ASSERT_EQ(allocator.reuseHits() + allocator.reuseMisses(), 0);
+  ASSERT_EQ(backing.getBytes(), 0);
+}
+
+TEST(PartitionBufferRecycler, reportsRoundingToListener) {
+  StdMemoryAllocator backing;
+  auto recycler = std::make_shared<PartitionBufferRecycler>(&backing);
+  recycler->setCapacity(1L << 20);
+  CountingListener listener;
+  RecyclingMemoryAllocator allocator(recycler, &listener);
+
+  // The requested size is reported by ListenableMemoryAllocator, only the rest of the block is reported here.
+  void* p = nullptr;
+  ASSERT_TRUE(allocator.allocate(10000, &p));
+  ASSERT_EQ(listener.currentBytes(), 16384 - 10000);
+
+  void* grown = nullptr;
+  ASSERT_TRUE(allocator.reallocate(p, 10000, 16000, &grown));
+  ASSERT_EQ(listener.currentBytes(), 16384 - 16000);
+
+  void* moved = nullptr;
+  ASSERT_TRUE(allocator.reallocate(grown, 16000, 20000, &moved));
+  ASSERT_EQ(listener.currentBytes(), 32768 - 20000);
+
+  // Blocks below the smallest class are not rounded.
+  void* small = nullptr;
+  ASSERT_TRUE(allocator.allocate(100, &small));
+  ASSERT_EQ(listener.currentBytes(), 32768 - 20000);
+
+  ASSERT_TRUE(allocator.free(small, 100));
+  ASSERT_TRUE(allocator.free(moved, 20000));
+  ASSERT_EQ(listener.currentBytes(), 0);
+  ASSERT_EQ(recycler->cachedBytes(), 16384 + 32768);
+}
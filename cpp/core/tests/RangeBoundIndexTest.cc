@@ -0,0 +1,98 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shuffle/RangeBoundIndex.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+using namespace gluten;
+
+namespace {
+
+// Reference: number of bounds less than the key.
+std::vector<int32_t>
+expectedPartitionIds(const std::vector<uint64_t>& bounds, const std::vector<uint64_t>& keys, int32_t keyWords) {
+  const int32_t numBounds = bounds.size() / keyWords;
+  std::vector<int32_t> pids;
+  for (size_t row = 0; row < keys.size() / keyWords; ++row) {
+    int32_t pid = 0;
+    while (pid < numBounds &&
+           std::lexicographical_compare(
+               bounds.begin() + pid * keyWords,
+               bounds.begin() + (pid + 1) * keyWords,
+               keys.begin() + row * keyWords,
+               keys.begin() + (row + 1) * keyWords)) {
+      ++pid;
+    }
+    pids.push_back(pid);
+  }
+  return pids;
+}
+
+void verify(int32_t numBounds, int32_t keyWords, uint64_t maxValue) {
+  std::mt19937_64 rng(numBounds * 31 + keyWords);
+  std::uniform_int_distribution<uint64_t> dist(0, maxValue);
+
+  std::vector<std::vector<uint64_t>> rows(numBounds, std::vector<uint64_t>(keyWords));
+  for (auto& row : rows) {
+    std::generate(row.begin(), row.end(), [&]() { return dist(rng); });
+  }
+  std::sort(rows.begin(), rows.end());
+  std::vector<uint64_t> bounds;
+  for (const auto& row : rows) {
+    bounds.insert(bounds.end(), row.begin(), row.end());
+  }
+
+  std::vector<uint64_t> keys(1000 * keyWords);
+  std::generate(keys.begin(), keys.end(), [&]() { return dist(rng); });
+  // Keys equal to the bounds and to the max value.
+  keys.insert(keys.end(), bounds.begin(), bounds.end());
+  keys.insert(keys.end(), keyWords, std::numeric_limits<uint64_t>::max());
+
+  RangeBoundIndex index(bounds, keyWords);
+  ASSERT_EQ(index.numBounds(), numBounds);
+  std::vector<int32_t> pids(keys.size() / keyWords);
+  index.partitionIds(keys.data(), pids.size(), pids.data());
+  ASSERT_EQ(pids, expectedPartitionIds(bounds, keys, keyWords))
+      << "numBounds: " << numBounds << ", keyWords: " << keyWords;
+}
+
+} // namespace
+
+TEST(RangeBoundIndex, singleWord) {
+  for (auto numBounds : {0, 1, 2, 3, 7, 8, 199, 1023, 1024}) {
+    verify(numBounds, 1, std::numeric_limits<uint64_t>::max());
+    // Many duplicate bounds.
+    verify(numBounds, 1, 16);
+  }
+}
+
+TEST(RangeBoundIndex, multiWord) {
+  for (auto keyWords : {2, 3}) {
+    for (auto numBounds : {1, 5, 64, 999}) {
+      verify(numBounds, keyWords, 8);
+    }
+  }
+}
+
+TEST(RangeBoundIndex, unsortedBounds) {
+  ASSERT_ANY_THROW(RangeBoundIndex({3, 1}, 1));
+}
@@ -0,0 +1,600 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Shuffle writer and reader microbenchmarks on synthetic data.
+//
+// Every combination of --shuffle_writers, --compressions, --partitionings, --schemas, --partition_counts and --skews is
+// registered as a ShuffleWrite/... and a ShuffleRead/... benchmark. No input files are needed. Example:
+//
+//   ./shuffle_benchmark --shuffle_writers=hash,sort --compressions=lz4 --partitionings=hash --schemas=strings \
+//       --partition_counts=200,1000 --skews=0,0.9 --memory_limit=268435456
+
+#include <filesystem>
+#include <numeric>
+#include <random>
+#include <sstream>
+
+#include <unistd.h>
+
+#include <arrow/c/bridge.h>
+#include <arrow/io/file.h>
+#include <benchmark/benchmark.h>
+#include <gflags/gflags.h>
+
+#include "benchmarks/common/BenchmarkUtils.h"
+#include "compute/VeloxBackend.h"
+#include "compute/VeloxRuntime.h"
+#include "shuffle/LocalPartitionWriter.h"
+#include "shuffle/Utils.h"
+#include "shuffle/VeloxShuffleWriter.h"
+#include "shuffle/rss/RssPartitionWriter.h"
+#include "tests/utils/LocalRssClient.h"
+#include "tests/utils/TestAllocationListener.h"
+#include "tests/utils/TestStreamReader.h"
+#include "threads/ThreadInitializer.h"
+#include "utils/Compression.h"
+#include "utils/Exception.h"
+#include "utils/VeloxArrowUtils.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/FlatVector.h"
+
+using namespace facebook::velox;
+using namespace gluten;
+
+namespace {
+
+DEFINE_string(shuffle_writers, "hash,sort,rss_sort", "Comma-separated shuffle writer types: hash, sort, rss_sort.");
+DEFINE_string(compressions, "none,lz4,zstd", "Comma-separated compression codecs: none, lz4, zstd.");
+DEFINE_string(partitionings, "hash,rr", "Comma-separated partitionings: hash, rr, single.");
+DEFINE_string(schemas, "fixed,strings,nested,dictionary", "Comma-separated schemas: fixed, strings, nested, dictionary.");
+DEFINE_string(partition_counts, "200", "Comma-separated numbers of shuffle partitions.");
+DEFINE_string(
+    skews,
+    "0,0.8",
+    "Comma-separated fractions of rows sent to partition 0. The other rows are spread uniformly. Only applies to hash "
+    "partitioning.");
+DEFINE_int32(num_batches, 64, "Number of input batches. Each batch has --batch_size rows.");
+DEFINE_int32(string_length, 32, "Average length of generated strings.");
+DEFINE_int64(memory_limit, std::numeric_limits<int64_t>::max(), "Memory limit used to trigger spill.");
+DEFINE_bool(shuffle_dictionary, false, "Whether to enable dictionary encoding for shuffle write.");
+DEFINE_string(
+    row_based_checksums,
+    "false",
+    "Comma-separated row-based checksum settings: false, true. Only the hash shuffle writer computes the checksums.");
+
+enum class SchemaKind { kFixed, kStrings, kNested, kDictionary };
+
+SchemaKind toSchemaKind(const std::string& name) {
+  if (name == "fixed") {
+    return SchemaKind::kFixed;
+  }
+  if (name == "strings") {
+    return SchemaKind::kStrings;
+  }
+  if (name == "nested") {
+    return SchemaKind::kNested;
+  }
+  if (name == "dictionary") {
+    return SchemaKind::kDictionary;
+  }
+  throw GlutenException("Unrecognized schema: " + name);
+}
+
+struct ShuffleBenchmarkCase {
+  ShuffleWriterType writerType;
+  std::string compression;
+  Partitioning partitioning;
+  SchemaKind schema;
+  int32_t numPartitions;
+  double skew;
+  bool rowBasedChecksum;
+};
+
+std::vector<std::string> splitList(const std::string& list) {
+  std::vector<std::string> items;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+// Synthetic input generator. The generated data is deterministic for a given case.
+class ShuffleDataGenerator {
+ public:
+  ShuffleDataGenerator(memory::MemoryPool* pool, const ShuffleBenchmarkCase& benchmarkCase)
+      : pool_(pool), case_(benchmarkCase), rng_(42) {}
+
+  // Returns the batches to feed the shuffle writer. For hash partitioning the first column is the partition id, as
+  // produced by the pre-projection in Spark.
+  std::vector<RowVectorPtr> generate(int32_t numBatches, int32_t rowsPerBatch) {
+    std::vector<RowVectorPtr> batches;
+    batches.reserve(numBatches);
+    for (auto i = 0; i < numBatches; ++i) {
+      auto data = makeData(rowsPerBatch);
+      if (case_.partitioning == Partitioning::kHash) {
+        auto children = data->children();
+        children.insert(children.begin(), makePartitionIds(rowsPerBatch));
+        auto names = asRowType(data->type())->names();
+        names.insert(names.begin(), "pid");
+        auto types = asRowType(data->type())->children();
+        types.insert(types.begin(), INTEGER());
+        data = std::make_shared<RowVector>(
+            pool_, ROW(std::move(names), std::move(types)), nullptr, rowsPerBatch, std::move(children));
+      }
+      batches.push_back(std::move(data));
+    }
+    return batches;
+  }
+
+ private:
+  RowVectorPtr makeData(int32_t rows) {
+    switch (case_.schema) {
+      case SchemaKind::kFixed:
+        return makeRow(
+            {"c_int", "c_bigint", "c_double", "c_bool"},
+            {makeIntegers(rows), makeBigints(rows, true), makeDoubles(rows), makeBooleans(rows)},
+            rows);
+      case SchemaKind::kStrings:
+        return makeRow(
+            {"c_bigint", "c_short_string", "c_string"},
+            {makeBigints(rows, false), makeStrings(rows, 4, false), makeStrings(rows, FLAGS_string_length, true)},
+            rows);
+      case SchemaKind::kNested:
+        return makeRow(
+            {"c_bigint", "c_array", "c_map", "c_struct"},
+            {makeBigints(rows, false), makeArrays(rows), makeMaps(rows), makeStructs(rows)},
+            rows);
+      case SchemaKind::kDictionary:
+        return makeRow(
+            {"c_bigint", "c_dict_string", "c_dict_bigint"},
+            {makeBigints(rows, false),
+             makeDictionary(makeStrings(16, FLAGS_string_length, false), rows),
+             makeDictionary(makeBigints(64, false), rows)},
+            rows);
+    }
+    GLUTEN_UNREACHABLE();
+  }
+
+  RowVectorPtr makeRow(std::vector<std::string> names, std::vector<VectorPtr> children, int32_t rows) {
+    std::vector<TypePtr> types;
+    types.reserve(children.size());
+    for (const auto& child : children) {
+      types.push_back(child->type());
+    }
+    return std::make_shared<RowVector>(
+        pool_, ROW(std::move(names), std::move(types)), nullptr, rows, std::move(children));
+  }
+
+  VectorPtr makePartitionIds(int32_t rows) {
+    auto pids = BaseVector::create<FlatVector<int32_t>>(INTEGER(), rows, pool_);
+    std::uniform_real_distribution<double> hot(0, 1);
+    std::uniform_int_distribution<int32_t> uniform(0, case_.numPartitions - 1);
+    for (auto row = 0; row < rows; ++row) {
+      pids->set(row, hot(rng_) < case_.skew ? 0 : uniform(rng_));
+    }
+    return pids;
+  }
+
+  VectorPtr makeIntegers(int32_t rows) {
+    auto vector = BaseVector::create<FlatVector<int32_t>>(INTEGER(), rows, pool_);
+    for (auto row = 0; row < rows; ++row) {
+      vector->set(row, static_cast<int32_t>(rng_()));
+    }
+    return vector;
+  }
+
+  VectorPtr makeBigints(int32_t rows, bool nullable) {
+    auto vector = BaseVector::create<FlatVector<int64_t>>(BIGINT(), rows, pool_);
+    for (auto row = 0; row < rows; ++row) {
+      if (nullable && row % 11 == 0) {
+        vector->setNull(row, true);
+      } else {
+        vector->set(row, static_cast<int64_t>(rng_()));
+      }
+    }
+    return vector;
+  }
+
+  VectorPtr makeDoubles(int32_t rows) {
+    auto vector = BaseVector::create<FlatVector<double>>(DOUBLE(), rows, pool_);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    for (auto row = 0; row < rows; ++row) {
+      vector->set(row, dist(rng_));
+    }
+    return vector;
+  }
+
+  VectorPtr makeBooleans(int32_t rows) {
+    auto vector = BaseVector::create<FlatVector<bool>>(BOOLEAN(), rows, pool_);
+    for (auto row = 0; row < rows; ++row) {
+      vector->set(row, rng_() & 1);
+    }
+    return vector;
+  }
+
+  VectorPtr makeStrings(int32_t rows, int32_t averageLength, bool nullable) {
+    auto vector = BaseVector::create<FlatVector<StringView>>(VARCHAR(), rows, pool_);
+    std::uniform_int_distribution<int32_t> length(0, averageLength * 2);
+    std::string value;
+    for (auto row = 0; row < rows; ++row) {
+      if (nullable && row % 13 == 0) {
+        vector->setNull(row, true);
+        continue;
+      }
+      value.resize(length(rng_));
+      for (auto& c : value) {
+        c = 'a' + rng_() % 26;
+      }
+      vector->set(row, StringView(value));
+    }
+    return vector;
+  }
+
+  // Returns offsets and sizes for `rows` collections of 0 to 7 elements, and the total number of elements.
+  std::tuple<BufferPtr, BufferPtr, vector_size_t> makeCollectionLayout(int32_t rows) {
+    auto offsets = allocateOffsets(rows, pool_);
+    auto sizes = allocateSizes(rows, pool_);
+    auto* rawOffsets = offsets->asMutable<vector_size_t>();
+    auto* rawSizes = sizes->asMutable<vector_size_t>();
+    vector_size_t numElements = 0;
+    for (auto row = 0; row < rows; ++row) {
+      rawOffsets[row] = numElements;
+      rawSizes[row] = rng_() % 8;
+      numElements += rawSizes[row];
+    }
+    return {offsets, sizes, numElements};
+  }
+
+  VectorPtr makeArrays(int32_t rows) {
+    auto [offsets, sizes, numElements] = makeCollectionLayout(rows);
+    auto elements = makeBigints(numElements, true);
+    return std::make_shared<ArrayVector>(pool_, ARRAY(BIGINT()), nullptr, rows, offsets, sizes, elements);
+  }
+
+  VectorPtr makeMaps(int32_t rows) {
+    auto [offsets, sizes, numElements] = makeCollectionLayout(rows);
+    auto keys = makeIntegers(numElements);
+    auto values = makeStrings(numElements, 8, true);
+    return std::make_shared<MapVector>(pool_, MAP(INTEGER(), VARCHAR()), nullptr, rows, offsets, sizes, keys, values);
+  }
+
+  VectorPtr makeStructs(int32_t rows) {
+    return makeRow({"f_int", "f_string"}, {makeIntegers(rows), makeStrings(rows, 8, false)}, rows);
+  }
+
+  VectorPtr makeDictionary(VectorPtr base, int32_t rows) {
+    auto indices = allocateIndices(rows, pool_);
+    auto* rawIndices = indices->asMutable<vector_size_t>();
+    for (auto row = 0; row < rows; ++row) {
+      rawIndices[row] = rng_() % base->size();
+    }
+    return BaseVector::wrapInDictionary(nullptr, indices, rows, std::move(base));
+  }
+
+  memory::MemoryPool* pool_;
+  const ShuffleBenchmarkCase case_;
+  std::mt19937 rng_;
+};
+
+std::unique_ptr<arrow::util::Codec> createCodec(const std::string& compression) {
+  if (compression == "none") {
+    return nullptr;
+  }
+  if (compression == "lz4") {
+    return createCompressionCodec(arrow::Compression::LZ4_FRAME, CodecBackend::NONE);
+  }
+  if (compression == "zstd") {
+    return createCompressionCodec(arrow::Compression::ZSTD, CodecBackend::NONE);
+  }
+  throw GlutenException("Unrecognized compression type: " + compression);
+}
+
+arrow::Compression::type toCompressionType(const std::string& compression) {
+  if (compression == "lz4") {
+    return arrow::Compression::LZ4_FRAME;
+  }
+  if (compression == "zstd") {
+    return arrow::Compression::ZSTD;
+  }
+  return arrow::Compression::UNCOMPRESSED;
+}
+
+class ShuffleBenchmarkContext {
+ public:
+  ShuffleBenchmarkContext(const ShuffleBenchmarkCase& benchmarkCase, const std::string& localDir)
+      : case_(benchmarkCase), localDir_(localDir) {
+    auto listener = std::make_unique<TestAllocationListener>();
+    listener->updateLimit(FLAGS_memory_limit);
+    listener_ = listener.get();
+    memoryManager_ = MemoryManager::create(kVeloxBackendKind, std::move(listener));
+    threadManager_ = ThreadManager::create(kVeloxBackendKind, ThreadInitializer::noop());
+    runtime_ = dynamic_cast<VeloxRuntime*>(Runtime::create(kVeloxBackendKind, memoryManager_, threadManager_, {}));
+
+    // Input data is allocated from a pool that is not accounted to the task, so only shuffle memory counts towards
+    // --memory_limit.
+    dataPool_ = memory::memoryManager()->addLeafPool("ShuffleBenchmarkData");
+    ShuffleDataGenerator generator(dataPool_.get(), case_);
+    for (auto& rowVector : generator.generate(FLAGS_num_batches, FLAGS_batch_size)) {
+      numRows_ += rowVector->size();
+      batches_.push_back(std::make_shared<VeloxColumnarBatch>(std::move(rowVector)));
+    }
+  }
+
+  ~ShuffleBenchmarkContext() {
+    batches_.clear();
+    dataPool_.reset();
+    Runtime::release(runtime_);
+    ThreadManager::release(threadManager_);
+    MemoryManager::release(memoryManager_);
+  }
+
+  // Writes all input batches to a new shuffle data file and returns the writer for metrics.
+  std::shared_ptr<VeloxShuffleWriter> write(const std::string& dataFile) {
+    auto shuffleWriter = std::dynamic_pointer_cast<VeloxShuffleWriter>(
+        runtime_->createShuffleWriter(case_.numPartitions, createPartitionWriter(dataFile), createWriterOptions()));
+    listener_->setShuffleWriter(shuffleWriter.get());
+    for (const auto& cb : batches_) {
+      GLUTEN_THROW_NOT_OK(shuffleWriter->write(cb, ShuffleWriter::kMaxMemLimit - shuffleWriter->cachedPayloadSize()));
+    }
+    GLUTEN_THROW_NOT_OK(shuffleWriter->stop());
+    listener_->setShuffleWriter(nullptr);
+    return shuffleWriter;
+  }
+
+  // Reads all partitions from the shuffle data file. Returns the number of rows read.
+  int64_t read(const std::string& dataFile) {
+    auto readerOptions = std::make_shared<ShuffleReaderOptions>();
+    readerOptions->shuffleWriterType = case_.writerType;
+    readerOptions->compressionType = toCompressionType(case_.compression);
+    auto reader = runtime_->createShuffleReader(outputSchema(), readerOptions);
+
+    GLUTEN_ASSIGN_OR_THROW(auto in, arrow::io::ReadableFile::Open(dataFile));
+    auto iter = reader->read(std::make_shared<TestStreamReader>(std::move(in)), ShuffleReader::OutputType::kRowVector);
+    int64_t numRows = 0;
+    while (iter->hasNext()) {
+      numRows += iter->next()->numRows();
+    }
+    return numRows;
+  }
+
+  std::string createDataFile() const {
+    GLUTEN_ASSIGN_OR_THROW(auto dataFile, createTempShuffleFile(localDir_));
+    return dataFile;
+  }
+
+  int64_t numRows() const {
+    return numRows_;
+  }
+
+ private:
+  std::shared_ptr<PartitionWriter> createPartitionWriter(const std::string& dataFile) {
+    if (case_.writerType == ShuffleWriterType::kRssSortShuffle) {
+      auto options = std::make_shared<RssPartitionWriterOptions>();
+      return std::make_shared<RssPartitionWriter>(
+          case_.numPartitions,
+          createCodec(case_.compression),
+          memoryManager_,
+          options,
+          std::make_unique<LocalRssClient>(dataFile));
+    }
+    auto options = std::make_shared<LocalPartitionWriterOptions>();
+    options->enableDictionary = FLAGS_shuffle_dictionary;
+    return std::make_shared<LocalPartitionWriter>(
+        case_.numPartitions,
+        createCodec(case_.compression),
+        memoryManager_,
+        options,
+        dataFile,
+        std::vector<std::string>{localDir_});
+  }
+
+  std::shared_ptr<ShuffleWriterOptions> createWriterOptions() const {
+    std::shared_ptr<ShuffleWriterOptions> options;
+    switch (case_.writerType) {
+      case ShuffleWriterType::kHashShuffle:
+        options = std::make_shared<HashShuffleWriterOptions>();
+        break;
+      case ShuffleWriterType::kSortShuffle:
+        options = std::make_shared<SortShuffleWriterOptions>();
+        break;
+      case ShuffleWriterType::kRssSortShuffle:
+        options = std::make_shared<RssSortShuffleWriterOptions>();
+        break;
+    }
+    options->partitioning = case_.partitioning;
+    options->rowBasedChecksumEnabled = case_.rowBasedChecksum;
+    return options;
+  }
+
+  std::shared_ptr<arrow::Schema> outputSchema() const {
+    auto rowVector = std::dynamic_pointer_cast<VeloxColumnarBatch>(batches_.front())->getRowVector();
+    if (case_.partitioning == Partitioning::kHash) {
+      // Drop the partition id column.
+      auto children = rowVector->children();
+      children.erase(children.begin());
+      auto names = asRowType(rowVector->type())->names();
+      names.erase(names.begin());
+      auto types = asRowType(rowVector->type())->children();
+      types.erase(types.begin());
+      rowVector = std::make_shared<RowVector>(
+          dataPool_.get(), ROW(std::move(names), std::move(types)), nullptr, rowVector->size(), std::move(children));
+    }
+    auto cSchema = VeloxColumnarBatch(rowVector).exportArrowSchema();
+    return arrowGetOrThrow(arrow::ImportSchema(cSchema.get()));
+  }
+
+  const ShuffleBenchmarkCase case_;
+  const std::string localDir_;
+
+  TestAllocationListener* listener_;
+  MemoryManager* memoryManager_;
+  ThreadManager* threadManager_;
+  VeloxRuntime* runtime_;
+
+  std::shared_ptr<memory::MemoryPool> dataPool_;
+  std::vector<std::shared_ptr<ColumnarBatch>> batches_;
+  int64_t numRows_{0};
+};
+
+void removeDataFile(const std::string& dataFile) {
+  std::error_code ec;
+  std::filesystem::remove(dataFile, ec);
+}
+
+void BM_ShuffleWrite(benchmark::State& state, ShuffleBenchmarkCase benchmarkCase, std::string localDir) {
+  ShuffleBenchmarkContext context(benchmarkCase, localDir);
+
+  int64_t rawBytes = 0;
+  int64_t bytesWritten = 0;
+  int64_t bytesSpilled = 0;
+  int64_t peakBytes = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    const auto dataFile = context.createDataFile();
+    state.ResumeTiming();
+
+    auto shuffleWriter = context.write(dataFile);
+
+    state.PauseTiming();
+    const auto& rawLengths = shuffleWriter->rawPartitionLengths();
+    rawBytes += std::accumulate(rawLengths.begin(), rawLengths.end(), 0LL);
+    bytesWritten += shuffleWriter->bytesWritten();
+    bytesSpilled += shuffleWriter->totalBytesEvicted();
+    peakBytes = std::max(peakBytes, shuffleWriter->peakBytesAllocated());
+    shuffleWriter.reset();
+    removeDataFile(dataFile);
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(state.iterations() * context.numRows());
+  state.SetBytesProcessed(rawBytes);
+  state.counters["bytes_written"] = benchmark::Counter(bytesWritten, benchmark::Counter::kAvgIterations);
+  state.counters["spill_bytes"] = benchmark::Counter(bytesSpilled, benchmark::Counter::kAvgIterations);
+  state.counters["peak_memory"] = benchmark::Counter(peakBytes, benchmark::Counter::kDefaults);
+}
+
+void BM_ShuffleRead(benchmark::State& state, ShuffleBenchmarkCase benchmarkCase, std::string localDir) {
+  ShuffleBenchmarkContext context(benchmarkCase, localDir);
+  const auto dataFile = context.createDataFile();
+  context.write(dataFile);
+  const auto fileSize = std::filesystem::file_size(dataFile);
+
+  int64_t numRows = 0;
+  for (auto _ : state) {
+    numRows += context.read(dataFile);
+  }
+  removeDataFile(dataFile);
+
+  GLUTEN_CHECK(
+      numRows == state.iterations() * context.numRows(),
+      "Shuffle reader returned " + std::to_string(numRows) + " rows, expected " +
+          std::to_string(state.iterations() * context.numRows()));
+  state.SetItemsProcessed(numRows);
+  state.SetBytesProcessed(state.iterations() * fileSize);
+}
+
+std::string caseName(const ShuffleBenchmarkCase& benchmarkCase, const std::string& schema) {
+  std::ostringstream oss;
+  oss << ShuffleWriter::typeToString(benchmarkCase.writerType) << "/" << benchmarkCase.compression << "/"
+      << (benchmarkCase.partitioning == Partitioning::kHash             ? "hash"
+              : benchmarkCase.partitioning == Partitioning::kRoundRobin ? "rr"
+                                                                        : "single")
+      << "/" << schema << "/partitions:" << benchmarkCase.numPartitions;
+  if (benchmarkCase.partitioning == Partitioning::kHash) {
+    oss << "/skew:" << benchmarkCase.skew;
+  }
+  if (benchmarkCase.rowBasedChecksum) {
+    oss << "/checksum";
+  }
+  return oss.str();
+}
+
+void registerBenchmarks(const std::string& localDir) {
+  for (const auto& writer : splitList(FLAGS_shuffle_writers)) {
+    for (const auto& compression : splitList(FLAGS_compressions)) {
+      for (const auto& partitioningName : splitList(FLAGS_partitionings)) {
+        const auto partitioning = toPartitioning(partitioningName);
+        GLUTEN_CHECK(
+            partitioning == Partitioning::kHash || partitioning == Partitioning::kRoundRobin ||
+                partitioning == Partitioning::kSingle,
+            "Unsupported partitioning for shuffle benchmark: " + partitioningName);
+        for (const auto& schema : splitList(FLAGS_schemas)) {
+          for (const auto& numPartitions : splitList(FLAGS_partition_counts)) {
+            // Skew only makes sense when the partition ids are given by the input.
+            const auto skews =
+                partitioning == Partitioning::kHash ? splitList(FLAGS_skews) : std::vector<std::string>{"0"};
+            // Checksums only affect the write path.
+            const auto checksums = ShuffleWriter::stringToType(writer) == ShuffleWriterType::kHashShuffle
+                ? splitList(FLAGS_row_based_checksums)
+                : std::vector<std::string>{"false"};
+            for (const auto& skew : skews) {
+              for (const auto& checksum : checksums) {
+                ShuffleBenchmarkCase benchmarkCase{
+                    ShuffleWriter::stringToType(writer),
+                    compression,
+                    partitioning,
+                    toSchemaKind(schema),
+                    partitioning == Partitioning::kSingle ? 1 : std::stoi(numPartitions),
+                    std::stod(skew),
+                    checksum == "true"};
+                const auto name = caseName(benchmarkCase, schema);
+                ::benchmark::RegisterBenchmark(
+                    ("ShuffleWrite/" + name).c_str(), BM_ShuffleWrite, benchmarkCase, localDir)
+                    ->Unit(benchmark::kMillisecond)
+                    ->UseRealTime();
+                if (!benchmarkCase.rowBasedChecksum) {
+                  ::benchmark::RegisterBenchmark(
+                      ("ShuffleRead/" + name).c_str(), BM_ShuffleRead, benchmarkCase, localDir)
+                      ->Unit(benchmark::kMillisecond)
+                      ->UseRealTime();
+                }
+              }
+            }
+            if (partitioning == Partitioning::kSingle) {
+              break;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  ::benchmark::Initialize(&argc, argv);
+
+  initVeloxBackend();
+  memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+
+  const auto localDir = std::filesystem::temp_directory_path() / ("shuffle-benchmark-" + std::to_string(getpid()));
+  std::filesystem::create_directories(localDir);
+
+  registerBenchmarks(localDir);
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+
+  std::error_code ec;
+  std::filesystem::remove_all(localDir, ec);
+  return 0;
+}
@@ -563,6 +563,14 @@ std::shared_ptr<ShuffleWriter> VeloxRuntime::createShuffleWriter(
     int32_t numPartitions,
     const std::shared_ptr<PartitionWriter>& partitionWriter,
     const std::shared_ptr<ShuffleWriterOptions>& options) {
+  if (auto hashOptions = std::dynamic_pointer_cast<HashShuffleWriterOptions>(options)) {
+    hashOptions->partitionBufferRecyclerCapacity = veloxCfg_->get<int64_t>(
+        kShufflePartitionBufferRecyclerCapacity, kShufflePartitionBufferRecyclerCapacityDefault);
+    hashOptions->adaptivePartitionBufferSize =
+        veloxCfg_->get<bool>(kShuffleAdaptivePartitionBufferSize, kShuffleAdaptivePartitionBufferSizeDefault);
+    hashOptions->partitionRowRateEmaAlpha =
+        veloxCfg_->get<double>(kShufflePartitionRowRateEmaAlpha, kShufflePartitionRowRateEmaAlphaDefault);
+  }
   GLUTEN_ASSIGN_OR_THROW(
       std::shared_ptr<ShuffleWriter> shuffleWriter,
       VeloxShuffleWriter::create(options->shuffleWriterType, numPartitions, partitionWriter, options, memoryManager()));
@@ -169,6 +169,19 @@ const std::string kVeloxUdfLibraryPaths = "spark.gluten.sql.columnar.backend.vel
 // VeloxShuffleReader print flag.
 const std::string kVeloxShuffleReaderPrintFlag = "spark.gluten.velox.shuffleReaderPrintFlag";
 
+// Max bytes of freed hash shuffle partition buffers kept per executor for reuse by subsequent tasks. 0 disables it.
+const std::string kShufflePartitionBufferRecyclerCapacity =
+    "spark.gluten.sql.columnar.backend.velox.shufflePartitionBufferRecyclerCapacity";
+const int64_t kShufflePartitionBufferRecyclerCapacityDefault = 0;
+
+// Size hash shuffle partition buffers per partition from the moving average of rows per batch.
+const std::string kShuffleAdaptivePartitionBufferSize =
+    "spark.gluten.sql.columnar.backend.velox.shuffleAdaptivePartitionBufferSize";
+const bool kShuffleAdaptivePartitionBufferSizeDefault = false;
+const std::string kShufflePartitionRowRateEmaAlpha =
+    "spark.gluten.sql.columnar.backend.velox.shufflePartitionRowRateEmaAlpha";
+const double kShufflePartitionRowRateEmaAlphaDefault = 0.3;
+
 const std::string kVeloxFileHandleCacheEnabled = "spark.gluten.sql.columnar.backend.velox.fileHandleCacheEnabled";
 const bool kVeloxFileHandleCacheEnabledDefault = true;
 
@@ -29,6 +29,7 @@
 
 #include "config/VeloxConfig.h"
 #include "memory/ArrowMemoryPool.h"
+#include "shuffle/PartitionBufferRecycler.h"
 #include "utils/Exception.h"
 
 namespace gluten {
@@ -339,6 +340,25 @@ std::shared_ptr<arrow::MemoryPool> VeloxMemoryManager::getOrCreateArrowMemoryPoo
   return pool;
 }
 
+std::shared_ptr<arrow::MemoryPool> VeloxMemoryManager::createArrowMemoryPool(
+    const std::string& name,
+    std::shared_ptr<MemoryAllocator> allocator) {
+  std::lock_guard<std::mutex> l(mutex_);
+  // Each call creates a distinct pool, e.g. one per shuffle writer. Replacing a live pool of the same name would hide it
+  // from getOrCreateArrowMemoryPool and from the usage stats, so the new pool gets a unique name instead.
+  auto uniqueName = name;
+  for (int32_t i = 1;; ++i) {
+    const auto it = arrowPools_.find(uniqueName);
+    if (it == arrowPools_.end() || it->second.expired()) {
+      break;
+    }
+    uniqueName = name + "#" + std::to_string(i);
+  }
+  auto pool = std::make_shared<ArrowMemoryPool>(blockListener_.get(), std::move(allocator));
+  arrowPools_[uniqueName] = pool;
+  return pool;
+}
+
 const MemoryUsageStats VeloxMemoryManager::collectMemoryUsageStats() const {
   MemoryUsageStats stats;
   stats.set_current(listener_->currentBytes());
@@ -346,6 +366,14 @@ const MemoryUsageStats VeloxMemoryManager::collectMemoryUsageStats() const {
   stats.mutable_children()->emplace("gluten::MemoryAllocator", collectGlutenAllocatorMemoryUsageStats(arrowPools_));
   stats.mutable_children()->emplace(
       veloxAggregatePool_->name(), collectVeloxMemoryUsageStats(veloxAggregatePool_.get()));
+  // Idle recycled partition buffers belong to the executor rather than to this task, so they are listed without adding
+  // to the task's usage.
+  if (const auto idleBytes = PartitionBufferRecycler::instance()->cachedBytes(); idleBytes > 0) {
+    MemoryUsageStats recyclerStats;
+    recyclerStats.set_current(idleBytes);
+    recyclerStats.set_peak(idleBytes);
+    stats.mutable_children()->emplace("PartitionBufferRecycler(idle)", recyclerStats);
+  }
   return stats;
 }
 
@@ -85,6 +85,10 @@ class VeloxMemoryManager final : public MemoryManager {
 
   std::shared_ptr<arrow::MemoryPool> getOrCreateArrowMemoryPool(const std::string& name) override;
 
+  std::shared_ptr<arrow::MemoryPool> createArrowMemoryPool(
+      const std::string& name,
+      std::shared_ptr<MemoryAllocator> allocator) override;
+
   const MemoryUsageStats collectMemoryUsageStats() const override;
 
   const int64_t shrink(int64_t size) override;
@@ -100,6 +104,11 @@ class VeloxMemoryManager final : public MemoryManager {
     return listener_.get();
   }
 
+  // The listener the Arrow memory pools report to.
+  AllocationListener* getBlockListener() const {
+    return blockListener_.get();
+  }
+
  private:
   bool tryDestructSafe();
 
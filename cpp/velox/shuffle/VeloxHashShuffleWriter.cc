@@ -33,6 +33,8 @@
 #include "velox/vector/BaseVector.h"
 #include "velox/vector/ComplexVector.h"
 
+#include <cmath>
+
 #if defined(__x86_64__)
 #include <immintrin.h>
 #include <x86intrin.h>
@@ -184,6 +186,18 @@ arrow::Status VeloxHashShuffleWriter::init() {
 
   partitionBufferBase_.resize(numPartitions_);
 
+  if (adaptivePartitionBufferSize_ && partitioning_ != Partitioning::kSingle) {
+    VELOX_CHECK(
+        partitionRowRateEmaAlpha_ > 0 && partitionRowRateEmaAlpha_ <= 1,
+        "Invalid partition row rate smoothing factor: {}",
+        partitionRowRateEmaAlpha_);
+    partitionRowRates_.resize(numPartitions_, 0);
+    adaptivePartitionBufferSizes_.resize(numPartitions_, 0);
+  }
+
+  metrics_.partitionBufferResizes.resize(numPartitions_, 0);
+  metrics_.partitionBufferEvictedBytes.resize(numPartitions_, 0);
+
   if (rowBasedChecksumEnabled_) {
     checksumXor_.resize(numPartitions_, 0);
     checksumSum_.resize(numPartitions_, 0);
@@ -278,9 +292,12 @@ arrow::Status VeloxHashShuffleWriter::write(std::shared_ptr<ColumnarBatch> cb, i
     auto veloxColumnBatch = VeloxColumnarBatch::from(veloxPool_.get(), cb);
     VELOX_CHECK_NOT_NULL(veloxColumnBatch);
     const int32_t numColumns = veloxColumnBatch->numColumns();
-    VELOX_CHECK(numColumns >= 2);
-    auto pidBatch = veloxColumnBatch->select(veloxPool_.get(), {0});
-    auto pidArr = getFirstColumn(*(pidBatch->getRowVector()));
+    const int32_t numKeyColumns = numRangePartitionKeyColumns();
+    VELOX_CHECK(numColumns > numKeyColumns);
+    std::vector<int32_t> keyColumns(numKeyColumns);
+    std::iota(keyColumns.begin(), keyColumns.end(), 0);
+    auto pidBatch = veloxColumnBatch->select(veloxPool_.get(), keyColumns);
+    auto pidArr = rangePartitionIds(*(pidBatch->getRowVector()));
     {
       SCOPED_TIMER(cpuWallTimingList_[CpuWallTimingCompute]);
       std::fill(std::begin(partition2RowCount_), std::end(partition2RowCount_), 0);
@@ -291,7 +308,7 @@ arrow::Status VeloxHashShuffleWriter::write(std::shared_ptr<ColumnarBatch> cb, i
     }
     std::vector<int32_t> range;
     range.reserve(numColumns);
-    for (int32_t i = 1; i < numColumns; i++) {
+    for (int32_t i = numKeyColumns; i < numColumns; i++) {
       range.push_back(i);
     }
     auto rvBatch = veloxColumnBatch->select(veloxPool_.get(), range);
@@ -367,6 +384,12 @@ arrow::Status VeloxHashShuffleWriter::stop() {
     partitionBuffers_.clear();
   }
 
+  if (partitionBufferAllocator_) {
+    metrics_.partitionBufferReuseHits = partitionBufferAllocator_->reuseHits();
+    metrics_.partitionBufferReuseMisses = partitionBufferAllocator_->reuseMisses();
+    metrics_.partitionBufferRecyclerIdleBytes = partitionBufferAllocator_->recycler()->cachedBytes();
+  }
+
   stat();
 
   // Populate row-based checksums into metrics.
@@ -449,6 +472,10 @@ arrow::Status VeloxHashShuffleWriter::doSplit(const facebook::velox::RowVector&
     setSplitState(SplitState::kPreAlloc);
     // Calculate buffer size based on available offheap memory, history average bytes per row and options_.bufferSize.
     auto preAllocBufferSize = calculatePartitionBufferSize(rv, memLimit);
+    if (adaptivePartitionBufferSize_) {
+      updatePartitionRowRates();
+      calculateAdaptivePartitionBufferSizes(preAllocBufferSize);
+    }
     RETURN_NOT_OK(preAllocPartitionBuffers(preAllocBufferSize));
   }
 
@@ -1041,6 +1068,7 @@ arrow::Status VeloxHashShuffleWriter::evictBuffers(
     auto* types = partitionWriter_->enableTypeAwareCompress() ? &tacBufferTypes_ : nullptr;
     auto payload = std::make_unique<InMemoryPayload>(
         numRows, &isValidityBuffer_, schema_, std::move(buffers), hasComplexType_, types);
+    metrics_.partitionBufferEvictedBytes[partitionId] += payload->rawSize();
     RETURN_NOT_OK(
         partitionWriter_->hashEvict(partitionId, std::move(payload), Evict::kCache, reuseBuffers, writtenBytes_));
   }
@@ -1213,6 +1241,11 @@ arrow::Status VeloxHashShuffleWriter::reclaimFixedSize(int64_t size, int64_t* ac
     ARROW_ASSIGN_OR_RAISE(auto evicted, evictPartitionBuffersMinSize(size - reclaimed));
     reclaimed += evicted;
   }
+  if (reclaimed < size && partitionBufferAllocator_) {
+    // Idle blocks in the recycler are not accounted to this task, so dropping them doesn't count as reclaimed. But the
+    // memory is likely needed by whoever is under pressure.
+    partitionBufferAllocator_->recycler()->trim(size - reclaimed);
+  }
   *actual = reclaimed;
   return arrow::Status::OK();
 }
@@ -1464,6 +1497,21 @@ void VeloxHashShuffleWriter::stat() const {
     oss << " SkippedNonVeloxBatches=" << inputEncodingSkippedBatches_;
     LOG(INFO) << oss.str();
   }
+  if (partitionBufferAllocator_) {
+    const auto hits = partitionBufferAllocator_->reuseHits();
+    const auto total = hits + partitionBufferAllocator_->reuseMisses();
+    LOG(INFO) << "Velox shuffle writer stat:PartitionBufferReuse hits=" << hits << " total=" << total
+              << " cachedBytes=" << partitionBufferAllocator_->recycler()->cachedBytes();
+  }
+  {
+    std::ostringstream oss;
+    oss << "Velox shuffle writer stat:PartitionBuffer adaptive=" << adaptivePartitionBufferSize_;
+    for (auto pid = 0; pid < numPartitions_; ++pid) {
+      oss << " " << pid << "=" << metrics_.partitionBufferResizes[pid] << "/"
+          << metrics_.partitionBufferEvictedBytes[pid];
+    }
+    LOG(INFO) << oss.str();
+  }
 #endif
 }
 
@@ -1555,6 +1603,7 @@ arrow::Result<int64_t> VeloxHashShuffleWriter::evictPartitionBuffersMinSize(int6
     auto payload = std::make_unique<InMemoryPayload>(
         numRows, &isValidityBuffer_, schema_, std::move(buffers), hasComplexType_, types);
     metrics_.totalBytesToEvict += payload->rawSize();
+    metrics_.partitionBufferEvictedBytes[pid] += payload->rawSize();
     RETURN_NOT_OK(partitionWriter_->hashEvict(pid, std::move(payload), Evict::kSpill, false, writtenBytes_));
   }
   return beforeEvict - partitionBufferPool_->bytes_allocated();
@@ -1587,9 +1636,49 @@ arrow::Result<uint32_t> VeloxHashShuffleWriter::partitionBufferSizeAfterShrink(u
   return arrow::Status::Invalid("Cannot shrink partition buffers in SplitState: " + std::to_string(splitState_));
 }
 
+void VeloxHashShuffleWriter::updatePartitionRowRates() {
+  for (auto pid = 0; pid < numPartitions_; ++pid) {
+    auto& rate = partitionRowRates_[pid];
+    rate += partitionRowRateEmaAlpha_ * (partition2RowCount_[pid] - rate);
+  }
+}
+
+void VeloxHashShuffleWriter::calculateAdaptivePartitionBufferSizes(uint32_t preAllocBufferSize) {
+  calculateAdaptivePartitionBufferSizes(
+      partitionRowRates_, splitBufferSize_, preAllocBufferSize, adaptivePartitionBufferSizes_);
+}
+
+void VeloxHashShuffleWriter::calculateAdaptivePartitionBufferSizes(
+    const std::vector<double>& partitionRowRates,
+    uint32_t splitBufferSize,
+    uint32_t preAllocBufferSize,
+    std::vector<uint32_t>& sizes) {
+  // A partition buffer is sized to hold the rows of the next few batches at the partition's row rate. Hot partitions
+  // get up to splitBufferSize rows, so they fill up and evict less often, and cold ones stop holding mostly empty
+  // buffers. The sum of all buffer sizes never exceeds what the uniform policy would allocate for all partitions.
+  const auto maxSize = static_cast<double>(splitBufferSize);
+  const auto minSize = std::min(static_cast<double>(kMinAdaptivePartitionBufferSize), maxSize);
+  sizes.resize(partitionRowRates.size());
+  double totalSize = 0;
+  for (size_t pid = 0; pid < partitionRowRates.size(); ++pid) {
+    auto size = std::clamp(std::ceil(partitionRowRates[pid] * kAdaptivePartitionBufferBatches), minSize, maxSize);
+    sizes[pid] = static_cast<uint32_t>(size);
+    totalSize += size;
+  }
+
+  const auto budget = static_cast<double>(preAllocBufferSize) * partitionRowRates.size();
+  if (totalSize > budget) {
+    const auto scale = budget / totalSize;
+    for (auto& size : sizes) {
+      size = static_cast<uint32_t>(size * scale);
+    }
+  }
+}
+
 arrow::Status VeloxHashShuffleWriter::preAllocPartitionBuffers(uint32_t preAllocBufferSize) {
   for (auto& pid : partitionUsed_) {
-    auto newSize = std::max(preAllocBufferSize, partition2RowCount_[pid]);
+    auto targetSize = adaptivePartitionBufferSize_ ? adaptivePartitionBufferSizes_[pid] : preAllocBufferSize;
+    auto newSize = std::max(targetSize, partition2RowCount_[pid]);
     DLOG_IF(INFO, partitionBufferSize_[pid] != newSize)
         << "Actual partition buffer size - current: " << partitionBufferSize_[pid] << ", newSize: " << newSize
         << std::endl;
@@ -1598,6 +1687,7 @@ arrow::Status VeloxHashShuffleWriter::preAllocPartitionBuffers(uint32_t preAlloc
       // Allocate buffer if it's not yet allocated.
       RETURN_NOT_OK(allocatePartitionBuffer(pid, newSize));
     } else if (beyondThreshold(pid, newSize)) {
+      ++metrics_.partitionBufferResizes[pid];
       if (newSize <= partitionBufferBase_[pid]) {
         // If the newSize is smaller, cache the buffered data and reuse and shrink the buffer.
         RETURN_NOT_OK(evictPartitionBuffers(pid, true));
@@ -1628,6 +1718,7 @@ arrow::Status VeloxHashShuffleWriter::preAllocPartitionBuffers(uint32_t preAlloc
       // buffer.
       if (newSize > partitionBufferSize_[pid]) {
         // If the partition size after split is already larger than allocated buffer size, need reallocate.
+        ++metrics_.partitionBufferResizes[pid];
         RETURN_NOT_OK(evictPartitionBuffers(pid, false));
         RETURN_NOT_OK(allocatePartitionBuffer(pid, newSize));
       } else {
@@ -1652,25 +1743,24 @@ void VeloxHashShuffleWriter::computeRowBasedChecksums(const facebook::velox::Row
 
   auto numRows = rv.size();
   VELOX_DCHECK(rv.nulls() == nullptr, "RowVector with top-level nulls not supported for checksum");
-  // Get the RowVector to serialize (strip pid column if present).
-  facebook::velox::RowVectorPtr dataVector;
-  if (partitioner_->hasPid()) {
-    // Strip the first column (partition id).
-    auto rowType = std::dynamic_pointer_cast<const facebook::velox::RowType>(rv.type());
-    std::vector<std::string> names(rowType->names().begin() + 1, rowType->names().end());
-    std::vector<facebook::velox::TypePtr> types(rowType->children().begin() + 1, rowType->children().end());
-    std::vector<facebook::velox::VectorPtr> children(rv.children().begin() + 1, rv.children().end());
-    auto dataType = facebook::velox::ROW(std::move(names), std::move(types));
-    dataVector =
-        std::make_shared<facebook::velox::RowVector>(rv.pool(), dataType, nullptr, numRows, std::move(children));
-  } else {
-    auto rowType = std::dynamic_pointer_cast<const facebook::velox::RowType>(rv.type());
-    dataVector = std::make_shared<facebook::velox::RowVector>(rv.pool(), rowType, nullptr, numRows, rv.children());
+  // The partition id column is already stripped from `rv`.
+  auto rowType = std::dynamic_pointer_cast<const facebook::velox::RowType>(rv.type());
+  if (VeloxRowBasedChecksum::isSupported(*rowType)) {
+    rowChecksum_.computeRowHashes(rv);
+    const auto& rowHashes = rowChecksum_.rowHashes();
+    for (uint32_t row = 0; row < numRows; ++row) {
+      auto pid = row2Partition_[row];
+      auto hash = static_cast<int64_t>(rowHashes[row]);
+      checksumXor_[pid] ^= hash;
+      checksumSum_[pid] += hash;
+    }
+    return;
   }
 
+  // Complex types: hash the UnsafeRow serialization of each row.
+  auto dataVector = std::make_shared<facebook::velox::RowVector>(rv.pool(), rowType, nullptr, numRows, rv.children());
   facebook::velox::row::UnsafeRowFast fast(dataVector);
-  auto dataType = std::dynamic_pointer_cast<const facebook::velox::RowType>(dataVector->type());
-  auto fixedSize = facebook::velox::row::UnsafeRowFast::fixedRowSize(dataType);
+  auto fixedSize = facebook::velox::row::UnsafeRowFast::fixedRowSize(rowType);
   int32_t bufSize = fixedSize.value_or(1024);
   if (checksumBuffer_.size() < static_cast<size_t>(bufSize)) {
     checksumBuffer_.resize(bufSize);
@@ -42,6 +42,7 @@
 #include "shuffle/PartitionWriter.h"
 #include "shuffle/Partitioner.h"
 #include "shuffle/Utils.h"
+#include "shuffle/VeloxRowBasedChecksum.h"
 
 #include "utils/Print.h"
 
@@ -109,6 +110,18 @@ class VeloxHashShuffleWriter : public VeloxShuffleWriter {
   };
 
  public:
+  // Adaptive partition buffers hold the rows of this many batches at the partition's average row rate.
+  static constexpr uint32_t kAdaptivePartitionBufferBatches = 4;
+  // Lower bound of an adaptive partition buffer size, in rows.
+  static constexpr uint32_t kMinAdaptivePartitionBufferSize = 64;
+
+  // Splits the budget of `preAllocBufferSize` rows per partition according to the partition row rates.
+  static void calculateAdaptivePartitionBufferSizes(
+      const std::vector<double>& partitionRowRates,
+      uint32_t splitBufferSize,
+      uint32_t preAllocBufferSize,
+      std::vector<uint32_t>& sizes);
+
   struct BinaryBuf {
     BinaryBuf(uint8_t* value, uint8_t* length, uint64_t valueCapacityIn, uint64_t valueOffsetIn)
         : valuePtr(value), lengthPtr(length), valueCapacity(valueCapacityIn), valueOffset(valueOffsetIn) {}
@@ -280,6 +293,8 @@ class VeloxHashShuffleWriter : public VeloxShuffleWriter {
         splitBufferSize_(options->splitBufferSize),
         splitBufferReallocThreshold_(options->splitBufferReallocThreshold),
         partitionBufferEvictThreshold_(options->partitionBufferEvictThreshold),
+        adaptivePartitionBufferSize_(options->adaptivePartitionBufferSize),
+        partitionRowRateEmaAlpha_(options->partitionRowRateEmaAlpha),
         rowBasedChecksumEnabled_(options->rowBasedChecksumEnabled) {
     arenas_.resize(numPartitions);
   }
@@ -307,6 +322,12 @@ class VeloxHashShuffleWriter : public VeloxShuffleWriter {
 
   uint32_t calculatePartitionBufferSize(const facebook::velox::RowVector& rv, int64_t memLimit);
 
+  // Updates the moving average of rows per batch of each partition from partition2RowCount_.
+  void updatePartitionRowRates();
+
+  // Splits the budget of `preAllocBufferSize` rows per partition according to the partition row rates.
+  void calculateAdaptivePartitionBufferSizes(uint32_t preAllocBufferSize);
+
   arrow::Status preAllocPartitionBuffers(uint32_t preAllocBufferSize);
 
   arrow::Status updateValidityBuffers(uint32_t partitionId, uint32_t newSize);
@@ -402,6 +423,12 @@ class VeloxHashShuffleWriter : public VeloxShuffleWriter {
   double splitBufferReallocThreshold_;
   int32_t partitionBufferEvictThreshold_;
 
+  // Skew-aware partition buffer sizing.
+  bool adaptivePartitionBufferSize_;
+  double partitionRowRateEmaAlpha_;
+  std::vector<double> partitionRowRates_;
+  std::vector<uint32_t> adaptivePartitionBufferSizes_;
+
   std::shared_ptr<arrow::Schema> schema_;
 
   // Column index, partition id, buffers.
@@ -522,6 +549,9 @@ class VeloxHashShuffleWriter : public VeloxShuffleWriter {
   bool rowBasedChecksumEnabled_{false};
   std::vector<int64_t> checksumXor_;
   std::vector<int64_t> checksumSum_;
+  // Computes the row hashes column by column when all columns have supported types.
+  VeloxRowBasedChecksum rowChecksum_;
+  // Used to serialize rows with complex types to UnsafeRow for hashing.
   std::vector<char> checksumBuffer_;
 
   void computeRowBasedChecksums(const facebook::velox::RowVector& rv);
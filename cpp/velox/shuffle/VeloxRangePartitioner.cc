@@ -0,0 +1,201 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shuffle/VeloxRangePartitioner.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "velox/type/Timestamp.h"
+
+using namespace facebook::velox;
+
+namespace gluten {
+
+namespace {
+
+constexpr uint64_t kSignBit32 = 1UL << 31;
+constexpr uint64_t kSignBit64 = 1UL << 63;
+
+// Key types of at most 32 bits share one word with their null flag. Wider types take a null flag word and a value word.
+bool isNarrow(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::REAL:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Maps a value to an unsigned integer with the same order. Floating point follows Spark: -0.0 equals 0.0 and NaN is
+// larger than any other value.
+template <typename T>
+uint64_t toUnsigned(T value) {
+  if constexpr (std::is_same_v<T, bool>) {
+    return value;
+  } else if constexpr (std::is_same_v<T, float>) {
+    if (std::isnan(value)) {
+      value = std::numeric_limits<float>::quiet_NaN();
+    } else if (value == 0) {
+      value = 0;
+    }
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & kSignBit32) ? static_cast<uint32_t>(~bits) : bits | kSignBit32;
+  } else if constexpr (std::is_same_v<T, double>) {
+    if (std::isnan(value)) {
+      value = std::numeric_limits<double>::quiet_NaN();
+    } else if (value == 0) {
+      value = 0;
+    }
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & kSignBit64) ? ~bits : bits | kSignBit64;
+  } else if constexpr (std::is_same_v<T, Timestamp>) {
+    return static_cast<uint64_t>(value.toMicros()) ^ kSignBit64;
+  } else if constexpr (sizeof(T) <= sizeof(int32_t)) {
+    return static_cast<uint32_t>(static_cast<int32_t>(value)) ^ kSignBit32;
+  } else {
+    return static_cast<uint64_t>(value) ^ kSignBit64;
+  }
+}
+
+} // namespace
+
+bool VeloxRangePartitioner::isSupported(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+VeloxRangePartitioner::VeloxRangePartitioner(
+    const RowVectorPtr& bounds,
+    std::vector<bool> ascending,
+    std::vector<bool> nullsFirst)
+    : keyTypes_(asRowType(bounds->type())->children()),
+      ascending_(std::move(ascending)),
+      nullsFirst_(std::move(nullsFirst)) {
+  VELOX_CHECK_GT(keyTypes_.size(), 0, "Range partitioning requires at least one sort key");
+  VELOX_CHECK_EQ(ascending_.size(), keyTypes_.size());
+  VELOX_CHECK_EQ(nullsFirst_.size(), keyTypes_.size());
+  for (const auto& type : keyTypes_) {
+    VELOX_CHECK(isSupported(type), "Unsupported range partitioning key type: {}", type->toString());
+    keyOffsets_.push_back(keyWords_);
+    keyWords_ += isNarrow(type->kind()) ? 1 : 2;
+  }
+
+  std::vector<uint64_t> normalizedBounds;
+  normalize(*bounds, normalizedBounds);
+  index_ = std::make_unique<RangeBoundIndex>(normalizedBounds, keyWords_);
+}
+
+template <typename T>
+void VeloxRangePartitioner::normalizeColumn(int32_t column, int32_t numRows, uint64_t* out) {
+  const auto offset = keyOffsets_[column];
+  // Flag of non-null values. Nulls get the other flag and a zero value.
+  const uint64_t nonNull = nullsFirst_[column] ? 1 : 0;
+  const bool narrow = isNarrow(keyTypes_[column]->kind());
+  const uint64_t descendingMask = ascending_[column] ? 0 : (narrow ? 0xFFFFFFFFUL : ~0UL);
+
+  for (auto row = 0; row < numRows; ++row) {
+    auto* key = out + row * keyWords_ + offset;
+    if (decoded_.isNullAt(row)) {
+      if (narrow) {
+        key[0] = (nonNull ^ 1) << 32;
+      } else {
+        key[0] = nonNull ^ 1;
+        key[1] = 0;
+      }
+      continue;
+    }
+    const auto value = toUnsigned<T>(decoded_.valueAt<T>(row)) ^ descendingMask;
+    if (narrow) {
+      key[0] = (nonNull << 32) | value;
+    } else {
+      key[0] = nonNull;
+      key[1] = value;
+    }
+  }
+}
+
+void VeloxRangePartitioner::normalize(const RowVector& input, std::vector<uint64_t>& out) {
+  VELOX_CHECK_GE(input.childrenSize(), keyTypes_.size());
+  const auto numRows = input.size();
+  out.resize(static_cast<size_t>(numRows) * keyWords_);
+  for (auto column = 0; column < keyTypes_.size(); ++column) {
+    const auto& child = input.childAt(column);
+    VELOX_CHECK(
+        child->type()->equivalent(*keyTypes_[column]),
+        "Range partitioning key {} has type {}, but the bounds have type {}",
+        column,
+        child->type()->toString(),
+        keyTypes_[column]->toString());
+    decoded_.decode(*child);
+    switch (keyTypes_[column]->kind()) {
+      case TypeKind::BOOLEAN:
+        normalizeColumn<bool>(column, numRows, out.data());
+        break;
+      case TypeKind::TINYINT:
+        normalizeColumn<int8_t>(column, numRows, out.data());
+        break;
+      case TypeKind::SMALLINT:
+        normalizeColumn<int16_t>(column, numRows, out.data());
+        break;
+      case TypeKind::INTEGER:
+        normalizeColumn<int32_t>(column, numRows, out.data());
+        break;
+      case TypeKind::BIGINT:
+        normalizeColumn<int64_t>(column, numRows, out.data());
+        break;
+      case TypeKind::REAL:
+        normalizeColumn<float>(column, numRows, out.data());
+        break;
+      case TypeKind::DOUBLE:
+        normalizeColumn<double>(column, numRows, out.data());
+        break;
+      case TypeKind::TIMESTAMP:
+        normalizeColumn<Timestamp>(column, numRows, out.data());
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+}
+
+const std::vector<int32_t>& VeloxRangePartitioner::compute(const RowVector& keys) {
+  normalize(keys, normalizedKeys_);
+  partitionIds_.resize(keys.size());
+  index_->partitionIds(normalizedKeys_.data(), keys.size(), partitionIds_.data());
+  return partitionIds_;
+}
+
+} // namespace gluten
@@ -0,0 +1,76 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "shuffle/RangeBoundIndex.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace gluten {
+
+/// Computes range partition ids from the sort key columns, instead of reading ids precomputed by a projection.
+///
+/// Keys are normalized column by column into uint64 words that compare in the sort order, honoring the direction and
+/// null ordering of each key, and searched in a RangeBoundIndex built once from the bounds. Supports boolean,
+/// integral, floating point, date, timestamp and short decimal keys.
+class VeloxRangePartitioner {
+ public:
+  static bool isSupported(const facebook::velox::TypePtr& type);
+
+  // `bounds` holds the sorted range bounds, one row per bound and one column per sort key.
+  VeloxRangePartitioner(
+      const facebook::velox::RowVectorPtr& bounds,
+      std::vector<bool> ascending,
+      std::vector<bool> nullsFirst);
+
+  int32_t numKeys() const {
+    return keyTypes_.size();
+  }
+
+  int32_t numPartitions() const {
+    return index_->numBounds() + 1;
+  }
+
+  // Computes the partition id of each row from the first numKeys() columns of `keys`. The returned buffer is valid
+  // until the next call.
+  const std::vector<int32_t>& compute(const facebook::velox::RowVector& keys);
+
+ private:
+  // Writes the normalized keys of the first numKeys() columns of `input` into `out`.
+  void normalize(const facebook::velox::RowVector& input, std::vector<uint64_t>& out);
+
+  template <typename T>
+  void normalizeColumn(int32_t column, int32_t numRows, uint64_t* out);
+
+  std::vector<facebook::velox::TypePtr> keyTypes_;
+  const std::vector<bool> ascending_;
+  const std::vector<bool> nullsFirst_;
+  // Word offset of each key column in a normalized key.
+  std::vector<int32_t> keyOffsets_;
+  int32_t keyWords_{0};
+  std::unique_ptr<RangeBoundIndex> index_;
+
+  facebook::velox::DecodedVector decoded_;
+  std::vector<uint64_t> normalizedKeys_;
+  std::vector<int32_t> partitionIds_;
+};
+
+} // namespace gluten
@@ -0,0 +1,248 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shuffle/VeloxRowBasedChecksum.h"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__SSE4_2__)
+#include <nmmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+using namespace facebook::velox;
+
+namespace gluten {
+
+namespace {
+
+// Non-zero seeds, so that rows of zeros still contribute to the checksum.
+constexpr uint32_t kSeedA = 0xFFFFFFFF;
+constexpr uint32_t kSeedB = 0x9E3779B9;
+
+#if !(defined(__x86_64__) && defined(__SSE4_2__)) && !(defined(__aarch64__) && defined(__ARM_FEATURE_CRC32))
+constexpr std::array<uint32_t, 256> makeCrc32cTable() {
+  std::array<uint32_t, 256> table{};
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t crc = i;
+    for (auto bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ ((crc & 1) ? 0x82F63B78 : 0);
+    }
+    table[i] = crc;
+  }
+  return table;
+}
+
+constexpr auto kCrc32cTable = makeCrc32cTable();
+#endif
+
+inline uint32_t crc32cU8(uint32_t crc, uint8_t value) {
+#if defined(__x86_64__) && defined(__SSE4_2__)
+  return _mm_crc32_u8(crc, value);
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+  return __crc32cb(crc, value);
+#else
+  return (crc >> 8) ^ kCrc32cTable[(crc ^ value) & 0xFF];
+#endif
+}
+
+inline uint32_t crc32cU64(uint32_t crc, uint64_t value) {
+#if defined(__x86_64__) && defined(__SSE4_2__)
+  return static_cast<uint32_t>(_mm_crc32_u64(crc, value));
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+  return __crc32cd(crc, value);
+#else
+  for (auto i = 0; i < 8; ++i) {
+    crc = crc32cU8(crc, value & 0xFF);
+    value >>= 8;
+  }
+  return crc;
+#endif
+}
+
+inline void mixWord(uint32_t& a, uint32_t& b, uint64_t word) {
+  a = crc32cU64(a, word);
+  b = crc32cU64(b, __builtin_bswap64(word));
+}
+
+// A null is a single byte, which never yields the same lane update as a word except by a CRC collision.
+inline void mixNull(uint32_t& a, uint32_t& b) {
+  a = crc32cU8(a, 1);
+  b = crc32cU8(b, 1);
+}
+
+inline void mixBytes(uint32_t& a, uint32_t& b, const char* data, size_t size) {
+  size_t offset = 0;
+  for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, data + offset, sizeof(word));
+    mixWord(a, b, word);
+  }
+  if (offset < size) {
+    uint64_t word = 0;
+    std::memcpy(&word, data + offset, size - offset);
+    mixWord(a, b, word);
+  }
+  // The length tells apart values that only differ by trailing zero bytes.
+  mixWord(a, b, size);
+}
+
+template <typename T>
+inline void mixValue(uint32_t& a, uint32_t& b, const T& value) {
+  if constexpr (std::is_same_v<T, StringView>) {
+    mixBytes(a, b, value.data(), value.size());
+  } else if constexpr (std::is_same_v<T, Timestamp>) {
+    mixWord(a, b, value.getSeconds());
+    mixWord(a, b, value.getNanos());
+  } else if constexpr (std::is_same_v<T, int128_t>) {
+    mixWord(a, b, static_cast<uint64_t>(value));
+    mixWord(a, b, static_cast<uint64_t>(value >> 64));
+  } else {
+    static_assert(sizeof(T) <= sizeof(uint64_t));
+    uint64_t word = 0;
+    std::memcpy(&word, &value, sizeof(T));
+    mixWord(a, b, word);
+  }
+}
+
+// Murmur3 64-bit finalizer. Breaks the linearity of CRC, which would otherwise let the XOR of the row hashes cancel
+// out in structured ways.
+inline uint64_t finalize(uint32_t a, uint32_t b) {
+  uint64_t h = (static_cast<uint64_t>(a) << 32) | b;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+} // namespace
+
+bool VeloxRowBasedChecksum::isSupported(const RowType& type, column_index_t firstColumn) {
+  for (auto column = firstColumn; column < type.size(); ++column) {
+    switch (type.childAt(column)->kind()) {
+      case TypeKind::BOOLEAN:
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::HUGEINT:
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+      case TypeKind::TIMESTAMP:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+uint32_t VeloxRowBasedChecksum::crc32c(uint32_t crc, const void* data, size_t size) {
+  const auto* bytes = static_cast<const char*>(data);
+  size_t offset = 0;
+  for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, bytes + offset, sizeof(word));
+    crc = crc32cU64(crc, word);
+  }
+  for (; offset < size; ++offset) {
+    crc = crc32cU8(crc, bytes[offset]);
+  }
+  return crc;
+}
+
+template <typename T>
+void VeloxRowBasedChecksum::hashColumn(vector_size_t numRows) {
+  auto* a = laneA_.data();
+  auto* b = laneB_.data();
+  // Booleans are bit-packed and always go through valueAt.
+  if constexpr (!std::is_same_v<T, bool>) {
+    if (decoded_.isIdentityMapping() && !decoded_.mayHaveNulls()) {
+      const auto* values = decoded_.data<T>();
+      for (vector_size_t row = 0; row < numRows; ++row) {
+        mixValue(a[row], b[row], values[row]);
+      }
+      return;
+    }
+  }
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    if (decoded_.isNullAt(row)) {
+      mixNull(a[row], b[row]);
+    } else {
+      mixValue(a[row], b[row], decoded_.valueAt<T>(row));
+    }
+  }
+}
+
+void VeloxRowBasedChecksum::computeRowHashes(const RowVector& rv, column_index_t firstColumn) {
+  const auto numRows = rv.size();
+  laneA_.assign(numRows, kSeedA);
+  laneB_.assign(numRows, kSeedB);
+
+  for (auto column = firstColumn; column < rv.childrenSize(); ++column) {
+    const auto& child = rv.childAt(column);
+    decoded_.decode(*child);
+    switch (child->typeKind()) {
+      case TypeKind::BOOLEAN:
+        hashColumn<bool>(numRows);
+        break;
+      case TypeKind::TINYINT:
+        hashColumn<int8_t>(numRows);
+        break;
+      case TypeKind::SMALLINT:
+        hashColumn<int16_t>(numRows);
+        break;
+      case TypeKind::INTEGER:
+        hashColumn<int32_t>(numRows);
+        break;
+      case TypeKind::BIGINT:
+        hashColumn<int64_t>(numRows);
+        break;
+      case TypeKind::HUGEINT:
+        hashColumn<int128_t>(numRows);
+        break;
+      case TypeKind::REAL:
+        hashColumn<float>(numRows);
+        break;
+      case TypeKind::DOUBLE:
+        hashColumn<double>(numRows);
+        break;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        hashColumn<StringView>(numRows);
+        break;
+      case TypeKind::TIMESTAMP:
+        hashColumn<Timestamp>(numRows);
+        break;
+      default:
+        VELOX_UNSUPPORTED("Unsupported type for row-based checksum: {}", child->type()->toString());
+    }
+  }
+
+  rowHashes_.resize(numRows);
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    rowHashes_[row] = finalize(laneA_[row], laneB_[row]);
+  }
+}
+
+} // namespace gluten
@@ -0,0 +1,60 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace gluten {
+
+/// Computes the per-row hashes that make up the row-based shuffle checksum, column by column.
+///
+/// Each row keeps two CRC32C lanes that every column value of the row is folded into. The second lane consumes the
+/// byte-swapped words so the two lanes are independent, and a final mix turns them into a 64-bit hash. CRC32C uses the
+/// hardware instruction on x86 (SSE4.2) and ARM (CRC extension) and falls back to a table, all producing the same
+/// values. The hashes depend only on the row values, not on the vector encodings or batch boundaries.
+class VeloxRowBasedChecksum {
+ public:
+  /// Whether all columns from `firstColumn` on have types that can be hashed column by column. Complex types are not
+  /// supported.
+  static bool isSupported(const facebook::velox::RowType& type, facebook::velox::column_index_t firstColumn = 0);
+
+  /// Updates a CRC32C value with `size` bytes. No pre or post inversion is applied.
+  static uint32_t crc32c(uint32_t crc, const void* data, size_t size);
+
+  /// Computes the hash of each row of `rv` over the columns from `firstColumn` on.
+  void computeRowHashes(const facebook::velox::RowVector& rv, facebook::velox::column_index_t firstColumn = 0);
+
+  const std::vector<uint64_t>& rowHashes() const {
+    return rowHashes_;
+  }
+
+ private:
+  template <typename T>
+  void hashColumn(facebook::velox::vector_size_t numRows);
+
+  facebook::velox::DecodedVector decoded_;
+  std::vector<uint32_t> laneA_;
+  std::vector<uint32_t> laneB_;
+  std::vector<uint64_t> rowHashes_;
+};
+
+} // namespace gluten
@@ -75,9 +75,12 @@ arrow::Status VeloxRssSortShuffleWriter::write(std::shared_ptr<ColumnarBatch> cb
     auto veloxColumnBatch = VeloxColumnarBatch::from(veloxPool_.get(), cb);
     VELOX_CHECK_NOT_NULL(veloxColumnBatch);
     const int32_t numColumns = veloxColumnBatch->numColumns();
-    VELOX_CHECK(numColumns >= 2);
-    auto pidBatch = veloxColumnBatch->select(veloxPool_.get(), {0});
-    auto pidArr = getFirstColumn(*(pidBatch->getRowVector()));
+    const int32_t numKeyColumns = numRangePartitionKeyColumns();
+    VELOX_CHECK(numColumns > numKeyColumns);
+    std::vector<int32_t> keyColumns(numKeyColumns);
+    std::iota(keyColumns.begin(), keyColumns.end(), 0);
+    auto pidBatch = veloxColumnBatch->select(veloxPool_.get(), keyColumns);
+    auto pidArr = rangePartitionIds(*(pidBatch->getRowVector()));
     {
       SCOPED_TIMER(cpuWallTimingList_[CpuWallTimingCompute]);
       setSortState(RssSortState::kSort);
@@ -85,7 +88,7 @@ arrow::Status VeloxRssSortShuffleWriter::write(std::shared_ptr<ColumnarBatch> cb
     }
     std::vector<int32_t> range;
     range.reserve(numColumns);
-    for (int32_t i = 1; i < numColumns; i++) {
+    for (int32_t i = numKeyColumns; i < numColumns; i++) {
       range.push_back(i);
     }
     auto rvBatch = veloxColumnBatch->select(veloxPool_.get(), range);
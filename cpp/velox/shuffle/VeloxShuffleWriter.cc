@@ -16,6 +16,7 @@
  */
 
 #include "shuffle/VeloxShuffleWriter.h"
+#include "memory/VeloxColumnarBatch.h"
 #include "shuffle/VeloxHashShuffleWriter.h"
 #include "shuffle/VeloxRssSortShuffleWriter.h"
 #include "shuffle/VeloxSortShuffleWriter.h"
@@ -41,4 +42,20 @@ arrow::Result<std::shared_ptr<VeloxShuffleWriter>> VeloxShuffleWriter::create(
   }
 }
 
+std::unique_ptr<VeloxRangePartitioner> VeloxShuffleWriter::makeRangePartitioner(const ShuffleWriterOptions& options) {
+  if (options.partitioning != Partitioning::kRange || options.rangeBounds == nullptr) {
+    return nullptr;
+  }
+  auto bounds = VeloxColumnarBatch::from(veloxPool_.get(), options.rangeBounds)->getFlattenedRowVector();
+  auto rangePartitioner =
+      std::make_unique<VeloxRangePartitioner>(bounds, options.rangeAscending, options.rangeNullsFirst);
+  VELOX_CHECK_LE(
+      rangePartitioner->numPartitions(),
+      numPartitions_,
+      "Range bounds define more partitions than the shuffle has: {} vs {}",
+      rangePartitioner->numPartitions(),
+      numPartitions_);
+  return rangePartitioner;
+}
+
 } // namespace gluten
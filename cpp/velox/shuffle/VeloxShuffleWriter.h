@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -36,10 +37,12 @@
 
 #include "memory/VeloxMemoryManager.h"
 #include "shuffle/Options.h"
+#include "shuffle/PartitionBufferRecycler.h"
 #include "shuffle/PartitionWriter.h"
 #include "shuffle/Partitioner.h"
 #include "shuffle/ShuffleWriter.h"
 #include "shuffle/Utils.h"
+#include "shuffle/VeloxRangePartitioner.h"
 
 #include "utils/Print.h"
 
@@ -72,6 +75,20 @@ class VeloxShuffleWriter : public ShuffleWriter {
         rv.pool(), newRowType, facebook::velox::BufferPtr(nullptr), length, std::move(children));
   }
 
+  // Number of leading columns of a range partitioning input batch that are not shuffled: the partition id column, or
+  // the sort key columns if the range bounds are given.
+  int32_t numRangePartitionKeyColumns() const {
+    return rangePartitioner_ ? rangePartitioner_->numKeys() : 1;
+  }
+
+  // Returns the partition ids of a range partitioning input batch from its leading key columns.
+  const int32_t* rangePartitionIds(const facebook::velox::RowVector& keys) {
+    if (rangePartitioner_) {
+      return rangePartitioner_->compute(keys).data();
+    }
+    return getFirstColumn(keys);
+  }
+
   const int32_t* getFirstColumn(const facebook::velox::RowVector& rv) {
     VELOX_CHECK(rv.childrenSize() > 0, "RowVector missing partition id column.");
 
@@ -120,15 +137,39 @@ class VeloxShuffleWriter : public ShuffleWriter {
       const std::shared_ptr<ShuffleWriterOptions>& options,
       MemoryManager* memoryManager)
       : ShuffleWriter(numPartitions, options->partitioning),
-        partitionBufferPool_(memoryManager->getOrCreateArrowMemoryPool("VeloxShuffleWriter.partitionBufferPool")),
+        partitionBufferAllocator_(makePartitionBufferAllocator(*options, memoryManager)),
+        partitionBufferPool_(
+            partitionBufferAllocator_ ? memoryManager->createArrowMemoryPool(
+                                            "VeloxShuffleWriter.partitionBufferPool", partitionBufferAllocator_)
+                                      : memoryManager->getOrCreateArrowMemoryPool("VeloxShuffleWriter.partitionBufferPool")),
         veloxPool_(dynamic_cast<VeloxMemoryManager*>(memoryManager)->getLeafMemoryPool()),
         partitionWriter_(partitionWriter) {
     partitioner_ = Partitioner::make(options->partitioning, numPartitions_, options->startPartitionId);
+    rangePartitioner_ = makeRangePartitioner(*options);
     serdeOptions_.useLosslessTimestamp = true;
   }
 
   virtual ~VeloxShuffleWriter() = default;
 
+  std::unique_ptr<VeloxRangePartitioner> makeRangePartitioner(const ShuffleWriterOptions& options);
+
+  static std::shared_ptr<RecyclingMemoryAllocator> makePartitionBufferAllocator(
+      const ShuffleWriterOptions& options,
+      MemoryManager* memoryManager) {
+    const auto* hashOptions = dynamic_cast<const HashShuffleWriterOptions*>(&options);
+    if (hashOptions == nullptr || hashOptions->partitionBufferRecyclerCapacity <= 0) {
+      return nullptr;
+    }
+    auto recycler = PartitionBufferRecycler::instance();
+    recycler->setCapacity(hashOptions->partitionBufferRecyclerCapacity);
+    // The rounding overhead goes to the same listener as the requested sizes, so the task pays for whole blocks.
+    return std::make_shared<RecyclingMemoryAllocator>(
+        std::move(recycler), dynamic_cast<VeloxMemoryManager*>(memoryManager)->getBlockListener());
+  }
+
+  // Allocator backing partitionBufferPool_ when partition buffer recycling is enabled. Otherwise nullptr.
+  std::shared_ptr<RecyclingMemoryAllocator> partitionBufferAllocator_;
+
   // Memory Pool used to track memory usage of partition buffers.
   // The actual allocation is delegated to options_.memoryPool.
   std::shared_ptr<arrow::MemoryPool> partitionBufferPool_;
@@ -141,6 +182,9 @@ class VeloxShuffleWriter : public ShuffleWriter {
 
   std::shared_ptr<Partitioner> partitioner_;
 
+  // Computes range partition ids from the sort keys when the range bounds are given. Otherwise nullptr.
+  std::unique_ptr<VeloxRangePartitioner> rangePartitioner_;
+
   facebook::velox::serializer::presto::PrestoVectorSerde::PrestoOptions serdeOptions_;
 
   int32_t maxBatchSize_{0};
@@ -134,14 +134,17 @@ arrow::Result<facebook::velox::RowVectorPtr> VeloxSortShuffleWriter::getPeeledRo
     auto veloxColumnBatch = VeloxColumnarBatch::from(veloxPool_.get(), cb);
     VELOX_CHECK_NOT_NULL(veloxColumnBatch);
     const int32_t numColumns = veloxColumnBatch->numColumns();
-    VELOX_CHECK(numColumns >= 2);
-    auto pidBatch = veloxColumnBatch->select(veloxPool_.get(), {0});
-    auto pidArr = getFirstColumn(*(pidBatch->getRowVector()));
+    const int32_t numKeyColumns = numRangePartitionKeyColumns();
+    VELOX_CHECK(numColumns > numKeyColumns);
+    std::vector<int32_t> keyColumns(numKeyColumns);
+    std::iota(keyColumns.begin(), keyColumns.end(), 0);
+    auto pidBatch = veloxColumnBatch->select(veloxPool_.get(), keyColumns);
+    auto pidArr = rangePartitionIds(*(pidBatch->getRowVector()));
     RETURN_NOT_OK(partitioner_->compute(pidArr, pidBatch->numRows(), row2Partition_));
 
     std::vector<int32_t> range;
     range.reserve(numColumns);
-    for (int32_t i = 1; i < numColumns; i++) {
+    for (int32_t i = numKeyColumns; i < numColumns; i++) {
       range.push_back(i);
     }
     auto rvBatch = veloxColumnBatch->select(veloxPool_.get(), range);
@@ -132,6 +132,21 @@ TEST_F(MemoryManagerTest, memoryAllocatorWithBlockReservation) {
   ASSERT_EQ(allocator_->getBytes(), 0);
 }
 
+TEST_F(MemoryManagerTest, createArrowMemoryPoolWithDuplicateName) {
+  auto first = vmm_->createArrowMemoryPool("pool", stdAllocator_);
+  auto second = vmm_->createArrowMemoryPool("pool", stdAllocator_);
+  ASSERT_NE(first, second);
+  // The first pool stays registered under the name.
+  ASSERT_EQ(vmm_->getOrCreateArrowMemoryPool("pool"), first);
+
+  uint8_t* buffer;
+  ASSERT_TRUE(second->Allocate(1024, &buffer).ok());
+  const auto stats = vmm_->collectMemoryUsageStats().children().at("gluten::MemoryAllocator");
+  ASSERT_EQ(stats.children().count("pool"), 1);
+  ASSERT_EQ(stats.children().at("pool#1").current(), 1024);
+  second->Free(buffer, 1024);
+}
+
 namespace {
 class AllocationListenerWrapper : public AllocationListener {
  public:
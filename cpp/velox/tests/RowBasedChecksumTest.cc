@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
+#include "shuffle/VeloxRowBasedChecksum.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/external/xxhash/xxhash.h"
 #include "velox/row/UnsafeRowFast.h"
@@ -58,6 +61,27 @@ class RowBasedChecksumTest : public test::VectorTestBase, public testing::Test {
     int64_t rotated = (static_cast<uint64_t>(checksumSum) << 27) | (static_cast<uint64_t>(checksumSum) >> 37);
     return {checksumXor ^ rotated, checksumSum};
   }
+
+  // Same as computeChecksums, with the row hashes computed column by column.
+  int64_t computeColumnarChecksum(const RowVectorPtr& rv, const std::vector<uint32_t>& rowOrder) {
+    gluten::VeloxRowBasedChecksum checksum;
+    checksum.computeRowHashes(*rv);
+    int64_t checksumXor = 0;
+    int64_t checksumSum = 0;
+    for (auto row : rowOrder) {
+      auto hash = static_cast<int64_t>(checksum.rowHashes()[row]);
+      checksumXor ^= hash;
+      checksumSum += hash;
+    }
+    int64_t rotated = (static_cast<uint64_t>(checksumSum) << 27) | (static_cast<uint64_t>(checksumSum) >> 37);
+    return checksumXor ^ rotated;
+  }
+
+  std::vector<uint64_t> rowHashes(const RowVectorPtr& rv) {
+    gluten::VeloxRowBasedChecksum checksum;
+    checksum.computeRowHashes(*rv);
+    return checksum.rowHashes();
+  }
 };
 
 TEST_F(RowBasedChecksumTest, orderIndependence) {
@@ -119,3 +143,65 @@ TEST_F(RowBasedChecksumTest, deterministic) {
   // Same input, same order -> same result (deterministic)
   EXPECT_EQ(checksum1, checksum2);
 }
+
+TEST_F(RowBasedChecksumTest, crc32c) {
+  // Standard CRC32C check value, with the pre and post inversion applied by the caller.
+  const std::string data = "123456789";
+  EXPECT_EQ(~gluten::VeloxRowBasedChecksum::crc32c(~0U, data.data(), data.size()), 0xE3069283);
+  EXPECT_EQ(~gluten::VeloxRowBasedChecksum::crc32c(~0U, nullptr, 0), 0);
+}
+
+TEST_F(RowBasedChecksumTest, columnarOrderIndependence) {
+  auto rv = makeRowVector(
+      {"a", "b", "c"},
+      {makeFlatVector<int32_t>({10, 20, 30, 40, 50}),
+       makeFlatVector<StringView>({"hello", "world", "a longer string value", "bar", ""}),
+       makeNullableFlatVector<double>({1.5, std::nullopt, 0.0, -2.25, 1e300})});
+  ASSERT_TRUE(gluten::VeloxRowBasedChecksum::isSupported(*asRowType(rv->type())));
+
+  auto checksum1 = computeColumnarChecksum(rv, {0, 1, 2, 3, 4});
+  EXPECT_EQ(checksum1, computeColumnarChecksum(rv, {4, 3, 2, 1, 0}));
+  EXPECT_EQ(checksum1, computeColumnarChecksum(rv, {2, 4, 0, 3, 1}));
+  EXPECT_NE(checksum1, 0);
+  // Dropping a row changes the checksum.
+  EXPECT_NE(checksum1, computeColumnarChecksum(rv, {0, 1, 2, 3}));
+}
+
+TEST_F(RowBasedChecksumTest, columnarEncodingIndependence) {
+  auto flat = makeRowVector(
+      {makeNullableFlatVector<int64_t>({7, std::nullopt, 7, 9}), makeFlatVector<StringView>({"x", "y", "x", "z"})});
+  auto indices = makeIndices({0, 1, 0, 2});
+  auto dictionary = makeRowVector(
+      {wrapInDictionary(indices, makeNullableFlatVector<int64_t>({7, std::nullopt, 9})),
+       wrapInDictionary(indices, makeFlatVector<StringView>({"x", "y", "z"}))});
+  auto constant = makeRowVector({makeConstant<int64_t>(7, 4), makeConstant<StringView>(StringView("x"), 4)});
+
+  auto flatHashes = rowHashes(flat);
+  EXPECT_EQ(flatHashes, rowHashes(dictionary));
+  auto constantHashes = rowHashes(constant);
+  EXPECT_EQ(constantHashes[0], flatHashes[0]);
+  EXPECT_EQ(constantHashes[3], flatHashes[0]);
+  // Identical rows hash the same, different rows differently.
+  EXPECT_EQ(flatHashes[0], flatHashes[2]);
+  EXPECT_NE(flatHashes[0], flatHashes[3]);
+}
+
+TEST_F(RowBasedChecksumTest, columnarDistinguishesValues) {
+  auto rv = makeRowVector(
+      {makeNullableFlatVector<int32_t>({0, std::nullopt, 0, 0, 0}),
+       makeFlatVector<StringView>({"ab", "ab", StringView("ab\0", 3), "ba", "ab"}),
+       makeFlatVector<Timestamp>(
+           {Timestamp(1, 0), Timestamp(1, 0), Timestamp(1, 0), Timestamp(1, 0), Timestamp(1, 1)})});
+  auto hashes = rowHashes(rv);
+  std::sort(hashes.begin(), hashes.end());
+  EXPECT_EQ(std::unique(hashes.begin(), hashes.end()), hashes.end());
+  EXPECT_FALSE(std::count(hashes.begin(), hashes.end(), 0));
+}
+
+TEST_F(RowBasedChecksumTest, columnarUnsupportedTypes) {
+  auto rv = makeRowVector({makeFlatVector<int32_t>({1}), makeArrayVector<int32_t>({{1, 2}})});
+  EXPECT_FALSE(gluten::VeloxRowBasedChecksum::isSupported(*asRowType(rv->type())));
+  // Columns before `firstColumn` are not checked.
+  auto reordered = makeRowVector({rv->childAt(1), rv->childAt(0)});
+  EXPECT_TRUE(gluten::VeloxRowBasedChecksum::isSupported(*asRowType(reordered->type()), 1));
+}
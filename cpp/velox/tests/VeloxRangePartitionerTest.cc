@@ -0,0 +1,93 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "shuffle/VeloxRangePartitioner.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+
+namespace gluten {
+
+class VeloxRangePartitionerTest : public test::VectorTestBase, public testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  std::vector<int32_t> compute(
+      const RowVectorPtr& bounds,
+      const RowVectorPtr& keys,
+      std::vector<bool> ascending,
+      std::vector<bool> nullsFirst) {
+    VeloxRangePartitioner partitioner(bounds, std::move(ascending), std::move(nullsFirst));
+    return partitioner.compute(*keys);
+  }
+};
+
+TEST_F(VeloxRangePartitionerTest, ascendingNullsFirst) {
+  auto bounds = makeRowVector({makeNullableFlatVector<int32_t>({std::nullopt, -5, 10})});
+  auto keys = makeRowVector({makeNullableFlatVector<int32_t>({std::nullopt, -100, -5, 0, 10, 11})});
+  ASSERT_EQ(compute(bounds, keys, {true}, {true}), (std::vector<int32_t>{0, 1, 1, 2, 2, 3}));
+}
+
+TEST_F(VeloxRangePartitionerTest, descendingNullsLast) {
+  auto bounds = makeRowVector({makeNullableFlatVector<int64_t>({100, 0, std::nullopt})});
+  auto keys = makeRowVector({makeNullableFlatVector<int64_t>({200, 100, 50, 0, -1, std::nullopt})});
+  ASSERT_EQ(compute(bounds, keys, {false}, {false}), (std::vector<int32_t>{0, 0, 1, 1, 2, 2}));
+}
+
+TEST_F(VeloxRangePartitionerTest, floatingPoint) {
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+  const auto inf = std::numeric_limits<double>::infinity();
+  auto bounds = makeRowVector({makeFlatVector<double>({-1.5, 0.0, inf})});
+  auto keys = makeRowVector({makeFlatVector<double>({-inf, -1.5, -0.0, 0.0, 2.0, inf, nan})});
+  // -0.0 equals 0.0 and NaN is larger than infinity.
+  ASSERT_EQ(compute(bounds, keys, {true}, {true}), (std::vector<int32_t>{0, 0, 1, 1, 2, 2, 3}));
+}
+
+TEST_F(VeloxRangePartitionerTest, multipleKeys) {
+  auto bounds = makeRowVector(
+      {makeFlatVector<int16_t>({1, 1, 2}),
+       makeFlatVector<Timestamp>({Timestamp(10, 0), Timestamp(20, 0), Timestamp(0, 0)})});
+  auto keys = makeRowVector(
+      {makeFlatVector<int16_t>({0, 1, 1, 1, 2, 2, 3}),
+       makeFlatVector<Timestamp>(
+           {Timestamp(99, 0),
+            Timestamp(10, 0),
+            Timestamp(10, 1000),
+            Timestamp(30, 0),
+            Timestamp(-1, 0),
+            Timestamp(0, 0),
+            Timestamp(0, 0)})});
+  ASSERT_EQ(compute(bounds, keys, {true, true}, {true, true}), (std::vector<int32_t>{0, 0, 1, 2, 2, 2, 3}));
+}
+
+TEST_F(VeloxRangePartitionerTest, dictionaryEncodedKeys) {
+  auto bounds = makeRowVector({makeFlatVector<int32_t>({10, 20})});
+  auto base = makeFlatVector<int32_t>({5, 15, 25});
+  auto keys = makeRowVector({wrapInDictionary(makeIndices({2, 0, 1, 1}), base)});
+  ASSERT_EQ(compute(bounds, keys, {true}, {true}), (std::vector<int32_t>{2, 0, 1, 1}));
+}
+
+TEST_F(VeloxRangePartitionerTest, unsupportedKeyType) {
+  auto bounds = makeRowVector({makeFlatVector<std::string>({"a"})});
+  ASSERT_ANY_THROW(VeloxRangePartitioner(bounds, {true}, {true}));
+}
+
+} // namespace gluten
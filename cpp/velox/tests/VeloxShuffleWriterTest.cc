@@ -863,6 +863,38 @@ TEST_P(HashPartitioningShuffleWriterTest, hashPart3Vectors) {
       *shuffleWriter, {hashInputVector1_, hashInputVector2_, hashInputVector1_}, 2, {blockPid2, blockPid1});
 }
 
+TEST_P(HashPartitioningShuffleWriterTest, rowBasedChecksum) {
+  if (GetParam().shuffleWriterType != ShuffleWriterType::kHashShuffle) {
+    GTEST_SKIP() << "Row-based checksums are computed by the hash shuffle writer only.";
+  }
+
+  auto writeChecksums = [&](const std::vector<RowVectorPtr>& batches) {
+    auto options = defaultShuffleWriterOptions();
+    options->rowBasedChecksumEnabled = true;
+    auto shuffleWriter = createShuffleWriter(2, options);
+    for (const auto& batch : batches) {
+      GLUTEN_THROW_NOT_OK(splitRowVector(*shuffleWriter, batch));
+    }
+    GLUTEN_THROW_NOT_OK(shuffleWriter->stop());
+    return shuffleWriter->rowBasedChecksums();
+  };
+  auto slice = [](const RowVectorPtr& vector, vector_size_t offset, vector_size_t length) {
+    return std::dynamic_pointer_cast<RowVector>(vector->slice(offset, length));
+  };
+
+  // The same rows, split into different batches and written in a different order.
+  const auto expected = writeChecksums({hashInputVector1_, hashInputVector2_});
+  const auto actual =
+      writeChecksums({hashInputVector2_, slice(hashInputVector1_, 5, 5), slice(hashInputVector1_, 0, 5)});
+
+  ASSERT_EQ(expected.size(), 2);
+  ASSERT_EQ(actual.size(), 2);
+  for (auto pid = 0; pid < 2; ++pid) {
+    EXPECT_NE(expected[pid], 0);
+    EXPECT_EQ(actual[pid], expected[pid]);
+  }
+}
+
 TEST_P(HashPartitioningShuffleWriterTest, hashLargeVectors) {
   const int32_t expectedMaxBatchSize = 8;
   auto shuffleWriter = createShuffleWriter(2);
@@ -880,6 +912,49 @@ TEST_P(HashPartitioningShuffleWriterTest, hashLargeVectors) {
   testShuffleRoundTrip(*shuffleWriter, {hashInputVector2_, hashInputVector1_}, 2, {blockPid2, blockPid1});
 }
 
+TEST_P(HashPartitioningShuffleWriterTest, adaptivePartitionBufferSize) {
+  if (GetParam().shuffleWriterType != ShuffleWriterType::kHashShuffle) {
+    return;
+  }
+  auto options = createShuffleWriterOptions(Partitioning::kHash, 4096);
+  auto hashOptions = std::dynamic_pointer_cast<HashShuffleWriterOptions>(options);
+  hashOptions->adaptivePartitionBufferSize = true;
+  hashOptions->partitionRowRateEmaAlpha = 0.5;
+  auto shuffleWriter = createShuffleWriter(2, options);
+
+  // Skewed input: all rows of hashInputVector2_ go to the same partition.
+  auto blockPid2 = takeRows(
+      {inputVector2_, inputVector2_, inputVector2_, inputVector1_}, {{0, 1}, {0, 1}, {0, 1}, {1, 2, 3, 4, 8}});
+  auto blockPid1 = takeRows({inputVector1_}, {{0, 5, 6, 7, 9}});
+  testShuffleRoundTrip(
+      *shuffleWriter,
+      {hashInputVector2_, hashInputVector2_, hashInputVector2_, hashInputVector1_},
+      2,
+      {blockPid2, blockPid1});
+
+  const auto& evictedBytes = shuffleWriter->partitionBufferEvictedBytes();
+  ASSERT_EQ(evictedBytes.size(), 2);
+  ASSERT_EQ(shuffleWriter->partitionBufferResizes().size(), 2);
+  ASSERT_GT(evictedBytes[1], 0);
+  // The hot partition received 11 of the 16 rows.
+  ASSERT_GT(evictedBytes[0], evictedBytes[1]);
+}
+
+TEST(VeloxHashShuffleWriterAdaptiveBufferTest, partitionBufferSizes) {
+  std::vector<uint32_t> sizes;
+  // Hot partitions get the rows of a few batches, capped at the split buffer size. Cold ones get the minimum.
+  VeloxHashShuffleWriter::calculateAdaptivePartitionBufferSizes({1000, 10, 0, 5000}, 4096, 4096, sizes);
+  ASSERT_EQ(sizes, (std::vector<uint32_t>{4000, 64, 64, 4096}));
+
+  // Scaled down to the budget of the uniform policy, 1024 rows per partition.
+  VeloxHashShuffleWriter::calculateAdaptivePartitionBufferSizes({1000, 10, 0}, 4096, 1024, sizes);
+  ASSERT_EQ(sizes, (std::vector<uint32_t>{2976, 47, 47}));
+
+  // A split buffer size below the minimum wins.
+  VeloxHashShuffleWriter::calculateAdaptivePartitionBufferSizes({1000, 0}, 32, 32, sizes);
+  ASSERT_EQ(sizes, (std::vector<uint32_t>{32, 32}));
+}
+
 TEST_P(RangePartitioningShuffleWriterTest, range) {
   auto shuffleWriter = createShuffleWriter(2);
 
@@ -890,6 +965,31 @@ TEST_P(RangePartitioningShuffleWriterTest, range) {
       *shuffleWriter, {compositeBatch1_, compositeBatch2_, compositeBatch1_}, 2, {blockPid1, blockPid2});
 }
 
+TEST_P(RangePartitioningShuffleWriterTest, rangeBounds) {
+  auto options = createShuffleWriterOptions(Partitioning::kRange, 4);
+  options->rangeBounds = std::make_shared<VeloxColumnarBatch>(makeRowVector({makeFlatVector<int32_t>({10})}));
+  options->rangeAscending = {true};
+  options->rangeNullsFirst = {true};
+  auto shuffleWriter = createShuffleWriter(2, options);
+
+  // The leading column is the sort key. Keys up to the bound go to the first partition.
+  auto key1 = makeRowVector({makeFlatVector<int32_t>({5, 15, 3, 20, 10, 30, 1, 12, -8, 25})});
+  auto batch1 = VeloxColumnarBatch::compose(
+      pool(),
+      {std::make_shared<VeloxColumnarBatch>(key1),
+       std::make_shared<VeloxColumnarBatch>(makeRowVector(inputVector1_->children()))});
+  auto key2 = makeRowVector({makeFlatVector<int32_t>({0, 11})});
+  auto batch2 = VeloxColumnarBatch::compose(
+      pool(),
+      {std::make_shared<VeloxColumnarBatch>(key2),
+       std::make_shared<VeloxColumnarBatch>(makeRowVector(inputVector2_->children()))});
+
+  auto blockPid1 = takeRows({inputVector1_, inputVector2_, inputVector1_}, {{0, 2, 4, 6, 8}, {0}, {0, 2, 4, 6, 8}});
+  auto blockPid2 = takeRows({inputVector1_, inputVector2_, inputVector1_}, {{1, 3, 5, 7, 9}, {1}, {1, 3, 5, 7, 9}});
+
+  testShuffleRoundTrip(*shuffleWriter, {batch1, batch2, batch1}, 2, {blockPid1, blockPid2});
+}
+
 TEST_P(RoundRobinPartitioningShuffleWriterTest, roundRobin) {
   auto shuffleWriter = createShuffleWriter(2);
 
@@ -974,6 +1074,33 @@ TEST_P(RoundRobinPartitioningShuffleWriterTest, preAllocForceReuse) {
   ASSERT_NOT_OK(shuffleWriter->stop());
 }
 
+TEST_P(RoundRobinPartitioningShuffleWriterTest, recyclePartitionBuffers) {
+  if (GetParam().shuffleWriterType != ShuffleWriterType::kHashShuffle) {
+    return;
+  }
+  auto shuffleWriterOptions = std::make_shared<HashShuffleWriterOptions>();
+  shuffleWriterOptions->splitBufferSize = 4096;
+  shuffleWriterOptions->partitionBufferRecyclerCapacity = 64 << 20;
+
+  {
+    auto shuffleWriter = createShuffleWriter(2, shuffleWriterOptions);
+    ASSERT_NOT_OK(splitRowVector(*shuffleWriter, inputVector1_));
+    ASSERT_NOT_OK(shuffleWriter->stop());
+    ASSERT_GT(shuffleWriter->partitionBufferReuseMisses(), 0);
+  }
+  ASSERT_GT(PartitionBufferRecycler::instance()->cachedBytes(), 0);
+
+  // The next writer picks up the buffers released by the previous one.
+  auto shuffleWriter = createShuffleWriter(2, shuffleWriterOptions);
+  auto blockPid1 = takeRows({inputVector1_}, {{0, 2, 4, 6, 8}});
+  auto blockPid2 = takeRows({inputVector1_}, {{1, 3, 5, 7, 9}});
+  testShuffleRoundTrip(*shuffleWriter, {inputVector1_}, 2, {blockPid1, blockPid2});
+  ASSERT_GT(shuffleWriter->partitionBufferReuseHits(), 0);
+
+  PartitionBufferRecycler::instance()->setCapacity(0);
+  ASSERT_EQ(PartitionBufferRecycler::instance()->cachedBytes(), 0);
+}
+
 TEST_P(RoundRobinPartitioningShuffleWriterTest, spillVerifyResult) {
   if (GetParam().shuffleWriterType != ShuffleWriterType::kHashShuffle) {
     return;
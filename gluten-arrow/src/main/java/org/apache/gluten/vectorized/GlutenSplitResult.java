@@ -32,6 +32,9 @@ public class GlutenSplitResult {
   private final long c2rTime;
   private final double avgDictionaryFields;
   private final long dictionarySize;
+  private final long partitionBufferReuseHits;
+  private final long partitionBufferReuseMisses;
+  private final long partitionBufferRecyclerIdleBytes;
 
   public GlutenSplitResult(
       long totalComputePidTime,
@@ -48,7 +51,10 @@ public class GlutenSplitResult {
       long dictionarySize,
       long[] partitionLengths,
       long[] rawPartitionLengths,
-      long[] rowBasedChecksums) {
+      long[] rowBasedChecksums,
+      long partitionBufferReuseHits,
+      long partitionBufferReuseMisses,
+      long partitionBufferRecyclerIdleBytes) {
     this.totalComputePidTime = totalComputePidTime;
     this.totalWriteTime = totalWriteTime;
     this.totalEvictTime = totalEvictTime;
@@ -64,6 +70,9 @@ public class GlutenSplitResult {
     this.c2rTime = totalC2RTime;
     this.avgDictionaryFields = avgDictionaryFields;
     this.dictionarySize = dictionarySize;
+    this.partitionBufferReuseHits = partitionBufferReuseHits;
+    this.partitionBufferReuseMisses = partitionBufferReuseMisses;
+    this.partitionBufferRecyclerIdleBytes = partitionBufferRecyclerIdleBytes;
   }
 
   public long getTotalComputePidTime() {
@@ -129,4 +138,17 @@ public class GlutenSplitResult {
   public long getDictionarySize() {
     return dictionarySize;
   }
+
+  public long getPartitionBufferReuseHits() {
+    return partitionBufferReuseHits;
+  }
+
+  public long getPartitionBufferReuseMisses() {
+    return partitionBufferReuseMisses;
+  }
+
+  /** Idle bytes held by the executor-wide partition buffer recycler when the writer stopped. */
+  public long getPartitionBufferRecyclerIdleBytes() {
+    return partitionBufferRecyclerIdleBytes;
+  }
 }
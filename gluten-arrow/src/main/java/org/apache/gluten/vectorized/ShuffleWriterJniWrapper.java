@@ -45,7 +45,10 @@ public class ShuffleWriterJniWrapper implements RuntimeAware {
       double splitBufferReallocThreshold,
       int partitionBufferEvictThreshold,
       long partitionWriterHandle,
-      boolean rowBasedChecksumEnabled);
+      boolean rowBasedChecksumEnabled,
+      long rangeBoundsHandle,
+      boolean[] rangeAscending,
+      boolean[] rangeNullsFirst);
 
   public native long createSortShuffleWriter(
       int numPartitions,
@@ -54,7 +57,10 @@ public class ShuffleWriterJniWrapper implements RuntimeAware {
       int diskWriteBufferSize,
       int initialSortBufferSize,
       boolean useRadixSort,
-      long partitionWriterHandle);
+      long partitionWriterHandle,
+      long rangeBoundsHandle,
+      boolean[] rangeAscending,
+      boolean[] rangeNullsFirst);
 
   public native long createRssSortShuffleWriter(
       int numPartitions,
@@ -63,7 +69,10 @@ public class ShuffleWriterJniWrapper implements RuntimeAware {
       int splitBufferSize,
       long sortBufferMaxSize,
       String codec,
-      long partitionWriterHandle);
+      long partitionWriterHandle,
+      long rangeBoundsHandle,
+      boolean[] rangeAscending,
+      boolean[] rangeNullsFirst);
 
   /**
    * Reclaim memory from the shuffle writer instance. It will first try to shrink allocated memory,
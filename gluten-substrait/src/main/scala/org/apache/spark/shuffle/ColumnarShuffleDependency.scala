@@ -22,7 +22,9 @@ import org.apache.gluten.vectorized.NativePartitioning
 import org.apache.spark.{Aggregator, Partitioner, ShuffleDependency, SparkEnv}
 import org.apache.spark.rdd.RDD
 import org.apache.spark.serializer.Serializer
+import org.apache.spark.sql.catalyst.InternalRow
 import org.apache.spark.sql.execution.metric.SQLMetric
+import org.apache.spark.sql.types.StructType
 
 import scala.reflect.ClassTag
 
@@ -49,6 +51,9 @@ import scala.reflect.ClassTag
  *   hold partitioning parameters needed by native shuffle writer
  * @param metrics
  *   the metrics for the columnar shuffle
+ * @param rangeBounds
+ *   sampled bounds of a range partitioning, set when the native shuffle writer computes the
+ *   partition ids from the leading sort key columns
  */
 class ColumnarShuffleDependency[K: ClassTag, V: ClassTag, C: ClassTag](
     @transient private val _rdd: RDD[_ <: Product2[K, V]],
@@ -60,7 +65,8 @@ class ColumnarShuffleDependency[K: ClassTag, V: ClassTag, C: ClassTag](
     override val shuffleWriterProcessor: ShuffleWriteProcessor = new ShuffleWriteProcessor,
     val nativePartitioning: NativePartitioning,
     val metrics: Map[String, SQLMetric],
-    val shuffleWriterType: ShuffleWriterType = HashShuffleWriterType)
+    val shuffleWriterType: ShuffleWriterType = HashShuffleWriterType,
+    val rangeBounds: Option[RangePartitionBounds] = None)
   extends ShuffleDependency[K, V, C](
     _rdd,
     partitioner,
@@ -69,3 +75,21 @@ class ColumnarShuffleDependency[K: ClassTag, V: ClassTag, C: ClassTag](
     aggregator,
     mapSideCombine,
     shuffleWriterProcessor) {}
+
+/**
+ * Sorted bounds of a range partitioning, one row per bound and one column per sort key.
+ *
+ * @param keySchema
+ *   schema of the sort keys
+ * @param bounds
+ *   the bounds as rows of `keySchema`
+ * @param ascending
+ *   sort direction of each key
+ * @param nullsFirst
+ *   null ordering of each key
+ */
+case class RangePartitionBounds(
+    keySchema: StructType,
+    bounds: Array[InternalRow],
+    ascending: Array[Boolean],
+    nullsFirst: Array[Boolean])